@@ -344,6 +344,15 @@ public:
     @param schemeName The scheme to validate.
     */
     bool validateScheme(const String& schemeName);
+
+    /**
+    Validate a given scheme generating the shader programs on the WorkQueue threads.
+    The render states are linked, the source code is written and the GPU programs are created on
+    the calling thread, while the program synthesis of all passes runs in parallel. Meant to warm up the shader cache at startup.
+    @param schemeName The scheme to validate.
+    @see validateScheme
+    */
+    bool validateSchemeParallel(const String& schemeName);
     
     /** 
     Invalidate specific material scheme. This action will lead to shader regeneration of the technique belongs to the
@@ -496,8 +505,13 @@ private:
 		SGPass(SGTechnique* parent, Pass* srcPass, Pass* dstPass, IlluminationStage stage);
         ~SGPass();
     
-        /** Build the render state and acquire the CPU/GPU programs */
-        void buildTargetRenderState();
+        /** Build the render state and acquire the CPU/GPU programs
+        @param acquirePrograms false to only link the render state, leaving program acquisition to the caller
+        */
+        void buildTargetRenderState(bool acquirePrograms = true);
+
+        /** Get the render state built for this pass or NULL. */
+        TargetRenderState* getTargetRenderState();
 
         /** Get source pass. */
         Pass* getSrcPass() { return mSrcPass; }
@@ -552,8 +566,10 @@ private:
         /** Get the destination technique scheme name. */
         const String& getDestinationTechniqueSchemeName() const { return mDstTechniqueSchemeName; }
         
-        /** Build the render state. */
-        void buildTargetRenderState();
+        /** Build the render state.
+        @param acquirePrograms false to only link the render states of the passes
+        */
+        void buildTargetRenderState(bool acquirePrograms = true);
 
 		/** Build the render state for illumination passes. */
 		void buildIlluminationTargetRenderState();
@@ -667,9 +683,10 @@ private:
         void invalidate();
 
         /** Validate the whole scheme.
+        @param parallel generate the programs on the WorkQueue
         @see ShaderGenerator::validateScheme.
         */
-        void validate();
+        void validate(bool parallel = false);
 
         /** Invalidate specific material.
         @see ShaderGenerator::invalidateMaterial.
@@ -715,6 +732,9 @@ private:
         /** Synchronize the fog settings of this scheme with the current settings of the scene. */
         void synchronizeWithFogSettings();
 
+        /** Generate the programs of the linked passes of the given techniques on the WorkQueue
+        and acquire them afterwards. */
+        void acquireProgramsParallel(const std::vector<SGTechnique*>& techniques);
 
     protected:
         // Scheme name.
@@ -124,11 +124,44 @@ private:
     */
     void destroyCpuProgram(Program* shaderProgram);
 
+    /** Match the program interfaces and run the pre creation step of the program processor.
+    Only touches the program set, so it may run on a WorkQueue thread.
+    @param programSet The program set container.
+    */
+    void prepareGpuPrograms(ProgramSet* programSet);
+
     /** Create GPU programs for the given program set based on the CPU programs it contains.
+    Writes the source code, so it must run on a single thread.
     @param programSet The program set container.
     */
     void createGpuPrograms(ProgramSet* programSet);
-        
+
+    /** Tells whether the programs can be shared between passes.
+    This is the case if all used uniforms are either auto constants or samplers, so no sub render
+    state needs to update them.
+    */
+    static bool isShareable(const ProgramSet* programSet);
+
+    /** Get the program set of the render states with the given signature.
+    @return NULL if no render state with this signature has shareable programs.
+    */
+    std::shared_ptr<ProgramSet> getSharedProgramSet(const String& signature);
+
+    /** Share the given program set between all render states with the given signature.
+    Also stores it in the shader cache if a cache path is set.
+    */
+    void addSharedProgramSet(const String& signature, const std::shared_ptr<ProgramSet>& programSet);
+
+    /** Create the GPU programs of the given program set from the shader cache manifest.
+    @param programSet The program set container. Only the GPU programs are set.
+    @param signature The render state signature the manifest was stored under.
+    @return false if the cache does not contain the programs of this signature.
+    */
+    bool loadCachedGpuPrograms(ProgramSet* programSet, const String& signature);
+
+    /** Write the shader cache manifest of the given shareable program set. */
+    void saveCachedGpuPrograms(ProgramSet* programSet, const String& signature);
+
     /** 
     Generates a unique hash from a string
     @param programString source code to generate a hash value for
@@ -139,17 +172,22 @@ private:
 
     /** Create GPU program based on the give CPU program.
     @param shaderProgram The CPU program instance.
+    @param source The source code generated for the CPU program.
     @param programWriter The program writer instance.
     @param language The target shader language.
     @param profiles The profiles string for program compilation.
-    @param profilesList The profiles string for program compilation as string list.
     @param cachePath The output path to write the program into.
     */
-    GpuProgramPtr createGpuProgram(Program* shaderProgram, 
+    GpuProgramPtr createGpuProgram(Program* shaderProgram,
+        String source,
         ProgramWriter* programWriter,
         const String& language,
         const String& profiles,
         const String& cachePath);
+
+    /** Set the source and the compile parameters of a newly created GPU program and load it. */
+    void setupGpuProgram(const GpuProgramPtr& gpuProgram, const String& source, const String& defines,
+                         const String& language, const String& profiles, bool columnMajorMatrices);
     
     /** Return the number of created shaders. */
     size_t getShaderCount(GpuProgramType type) const;
@@ -163,6 +201,8 @@ private:
     std::vector<GpuProgramPtr> mShaderList;
     // The default program processors.
     ProgramProcessorList mDefaultProgramProcessors;
+    // The program sets shared between render states by signature.
+    std::map<String, std::weak_ptr<ProgramSet>> mSharedProgramSets;
 
     friend class ProgramSet;
     friend class TargetRenderState;
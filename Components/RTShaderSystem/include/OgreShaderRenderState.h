@@ -163,6 +163,34 @@ public:
     */
     void addSubRenderStateInstance(SubRenderState* subRenderState);
 
+    /** Compute the signature of the programs generated by this render state.
+    Passes with the same signature get the same programs, so the signature identifies them in the shader cache.
+    Texture names and other values that end up in uniforms are not part of it.
+    Call after the render state was linked.
+    @param srcPass The source pass that this render state is constructed from.
+    @param dstPass The destination pass that constructed from this render state.
+    */
+    void computeSignature(Pass* srcPass, Pass* dstPass);
+
+    /** Return the signature computed by computeSignature or an empty string. */
+    const String& getSignature() const { return mSignature; }
+
+    /** Return the program set of this render state.
+    Render states with the same signature share it if the programs only use auto constants.
+    */
+    ProgramSet* getProgramSet() { return mProgramSet.get(); }
+
+    /** Reuse the programs of a render state with the same signature or restore them from the shader cache.
+    Requires a signature.
+    @return true if the programs were found and program generation can be skipped.
+    */
+    bool loadCachedPrograms();
+
+    /** Generate the CPU programs and prepare them for writing.
+    Neither writes the source code nor creates any GPU resources, so it may run on a WorkQueue thread.
+    */
+    void generatePrograms();
+
     /** Acquire CPU/GPU programs set associated with the given render state and bind them to the pass.
     @param pass The pass to bind the programs to.
     */
@@ -189,16 +217,14 @@ private:
     /** Create the program set of this render state.
     */
     ProgramSet* createProgramSet();
-
-    /** Return the program set of this render state.
-    */
-    ProgramSet* getProgramSet() { return mProgramSet.get(); }
     
     // Tells if the list of the sub render states is sorted.
     bool mSubRenderStateSortValid;
     // The program set of this RenderState.
-    std::unique_ptr<ProgramSet> mProgramSet;
+    std::shared_ptr<ProgramSet> mProgramSet;
     Pass* mParent;
+    // The signature of the generated programs.
+    String mSignature;
 
 private:
     friend class ProgramManager;
@@ -25,6 +25,7 @@ THE SOFTWARE.
 -----------------------------------------------------------------------------
 */
 #include "OgreShaderPrecompiledHeaders.h"
+#include "OgreWorkQueue.h"
 
 namespace Ogre {
 
@@ -1055,6 +1056,22 @@ bool ShaderGenerator::validateScheme(const String& schemeName)
     return true;
 }
 
+//-----------------------------------------------------------------------------
+bool ShaderGenerator::validateSchemeParallel(const String& schemeName)
+{
+    OGRE_LOCK_AUTO_MUTEX;
+
+    SGSchemeIterator itScheme = mSchemeEntriesMap.find(schemeName);
+
+    // No such scheme exists.
+    if (itScheme == mSchemeEntriesMap.end())
+        return false;
+
+    itScheme->second->validate(true);
+
+    return true;
+}
+
 //-----------------------------------------------------------------------------
 void ShaderGenerator::invalidateMaterial(const String& schemeName, const String& materialName, const String& groupName)
 {
@@ -1337,7 +1354,7 @@ ShaderGenerator::SGPass::~SGPass()
 }
 
 //-----------------------------------------------------------------------------
-void ShaderGenerator::SGPass::buildTargetRenderState()
+void ShaderGenerator::SGPass::buildTargetRenderState(bool acquirePrograms)
 {
     if(mSrcPass->isProgrammable() && !mParent->overProgrammablePass() && !isIlluminationPass()) return;
     const String& schemeName = mParent->getDestinationTechniqueSchemeName();
@@ -1379,10 +1396,20 @@ void ShaderGenerator::SGPass::buildTargetRenderState()
         targetRenderState->link(*mCustomRenderState, mSrcPass, mDstPass);
     }
 
-    targetRenderState->acquirePrograms(mDstPass);
+    targetRenderState->computeSignature(mSrcPass, mDstPass);
+
+    if (acquirePrograms)
+        targetRenderState->acquirePrograms(mDstPass);
     mDstPass->getUserObjectBindings().setUserAny(TargetRenderState::UserKey, targetRenderState);
 }
 
+//-----------------------------------------------------------------------------
+TargetRenderState* ShaderGenerator::SGPass::getTargetRenderState()
+{
+    const Any& passUserData = mDstPass->getUserObjectBindings().getUserAny(TargetRenderState::UserKey);
+    return passUserData.has_value() ? any_cast<TargetRenderStatePtr>(passUserData).get() : NULL;
+}
+
 //-----------------------------------------------------------------------------
 ShaderGenerator::SGTechnique::SGTechnique(SGMaterial* parent, const Technique* srcTechnique,
                                           const String& dstTechniqueSchemeName,
@@ -1517,7 +1544,7 @@ void ShaderGenerator::SGTechnique::destroySGPasses()
 }
 
 //-----------------------------------------------------------------------------
-void ShaderGenerator::SGTechnique::buildTargetRenderState()
+void ShaderGenerator::SGTechnique::buildTargetRenderState(bool acquirePrograms)
 {
     // Remove existing destination technique and passes
     // in order to build it again from scratch.
@@ -1547,7 +1574,7 @@ void ShaderGenerator::SGTechnique::buildTargetRenderState()
     for (auto *p : mPassEntries)
     {
 	assert(!p->isIlluminationPass()); // this is not so important, but intended to be so here.
-        p->buildTargetRenderState();
+        p->buildTargetRenderState(acquirePrograms);
     }
 
     // Turn off the build destination technique flag.
@@ -1688,7 +1715,7 @@ void ShaderGenerator::SGScheme::removeTechniqueEntry(SGTechnique* techEntry)
 }
 
 //-----------------------------------------------------------------------------
-void ShaderGenerator::SGScheme::validate()
+void ShaderGenerator::SGScheme::validate(bool parallel)
 {
     // Synchronize with light settings.
     synchronizeWithLightSettings();
@@ -1700,17 +1727,61 @@ void ShaderGenerator::SGScheme::validate()
     if (mOutOfDate == false)
         return;
 
+    std::vector<SGTechnique*> builtTechniques;
+
     // Build render state for each technique and acquire GPU programs.
     for (SGTechnique* curTechEntry : mTechniqueEntries)
     {
         if (curTechEntry->getBuildDestinationTechnique())
-            curTechEntry->buildTargetRenderState();
+        {
+            curTechEntry->buildTargetRenderState(!parallel);
+            builtTechniques.push_back(curTechEntry);
+        }
     }
 
+    if (parallel)
+        acquireProgramsParallel(builtTechniques);
+
     // Mark this scheme as up to date.
     mOutOfDate = false;
 }
 
+//-----------------------------------------------------------------------------
+void ShaderGenerator::SGScheme::acquireProgramsParallel(const std::vector<SGTechnique*>& techniques)
+{
+    std::vector<SGPass*> passes;
+    std::vector<SGPass*> generated;
+    std::set<String> generatedSignatures;
+
+    for (SGTechnique* tech : techniques)
+    {
+        for (SGPass* pass : tech->getPassList())
+        {
+            TargetRenderState* renderState = pass->getTargetRenderState();
+            if (!renderState)
+                continue;
+
+            passes.push_back(pass);
+
+            // creating GPU programs is main thread only, so check the cache here
+            if (renderState->loadCachedPrograms())
+                continue;
+
+            // passes with the same signature pick up the shared programs when they are acquired
+            const String& signature = renderState->getSignature();
+            if (signature.empty() || generatedSignatures.insert(signature).second)
+                generated.push_back(pass);
+        }
+    }
+
+    // creating the CPU programs only touches the render state, so do it on the WorkQueue
+    Root::getSingleton().getWorkQueue()->parallelFor(
+        generated.size(), [&generated](size_t i) { generated[i]->getTargetRenderState()->generatePrograms(); });
+
+    for (SGPass* pass : passes)
+        pass->getTargetRenderState()->acquirePrograms(pass->getDstPass());
+}
+
 //-----------------------------------------------------------------------------
 void ShaderGenerator::SGScheme::synchronizeWithLightSettings()
 {
@@ -91,6 +91,8 @@ size_t ProgramManager::getShaderCount(GpuProgramType type) const
 //-----------------------------------------------------------------------------
 void ProgramManager::flushGpuProgramsCache()
 {
+    mSharedProgramSets.clear();
+
     for(auto& s : mShaderList)
     {
         GpuProgramManager::getSingleton().remove(s);
@@ -114,13 +116,23 @@ void ProgramManager::destroyDefaultProgramProcessors()
 }
 
 //-----------------------------------------------------------------------------
-void ProgramManager::createGpuPrograms(ProgramSet* programSet)
+void ProgramManager::prepareGpuPrograms(ProgramSet* programSet)
 {
     // Before we start we need to make sure that the pixel shader input
     //  parameters are the same as the vertex output, this required by 
     //  shader models 4 and 5.
     matchVStoPSInterface(programSet);
 
+    ProgramProcessor* programProcessor = mDefaultProgramProcessors.front();
+
+    // Call the pre creation of GPU programs method.
+    if (!programProcessor->preCreateGpuPrograms(programSet))
+        OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "preCreateGpuPrograms failed");
+}
+
+//-----------------------------------------------------------------------------
+void ProgramManager::createGpuPrograms(ProgramSet* programSet)
+{
     // Grab the matching writer.
     const String& language = ShaderGenerator::getSingleton().getTargetLanguage();
 
@@ -128,14 +140,15 @@ void ProgramManager::createGpuPrograms(ProgramSet* programSet)
 
     ProgramProcessor* programProcessor = mDefaultProgramProcessors.front();
     
-    // Call the pre creation of GPU programs method.
-    if (!programProcessor->preCreateGpuPrograms(programSet))
-        OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "preCreateGpuPrograms failed");
-    
     // Create the shader programs
     for(auto type : {GPT_VERTEX_PROGRAM, GPT_FRAGMENT_PROGRAM})
     {
-        auto gpuProgram = createGpuProgram(programSet->getCpuProgram(type), programWriter, language,
+        // the writers keep state while writing, so this stays on the calling thread
+        std::stringstream sourceCodeStringStream;
+        programWriter->writeSourceCode(sourceCodeStringStream, programSet->getCpuProgram(type));
+
+        auto gpuProgram = createGpuProgram(programSet->getCpuProgram(type), sourceCodeStringStream.str(),
+                                           programWriter, language,
                                            ShaderGenerator::getSingleton().getShaderProfiles(type),
                                            ShaderGenerator::getSingleton().getShaderCachePath());
         programSet->setGpuProgram(gpuProgram);
@@ -154,17 +167,12 @@ void ProgramManager::createGpuPrograms(ProgramSet* programSet)
 
 //-----------------------------------------------------------------------------
 GpuProgramPtr ProgramManager::createGpuProgram(Program* shaderProgram, 
+                                               String source,
                                                ProgramWriter* programWriter,
                                                const String& language,
                                                const String& profiles,
                                                const String& cachePath)
 {
-    std::stringstream sourceCodeStringStream;
-
-    // Generate source code.
-    programWriter->writeSourceCode(sourceCodeStringStream, shaderProgram);
-    String source = sourceCodeStringStream.str();
-
     // Generate program name.
     String programName = generateHash(source, shaderProgram->getPreprocessorDefines());
 
@@ -219,15 +227,25 @@ GpuProgramPtr ProgramManager::createGpuProgram(Program* shaderProgram,
         }
     }
 
+    setupGpuProgram(pGpuProgram, source, shaderProgram->getPreprocessorDefines(), language, profiles,
+                    shaderProgram->getUseColumnMajorMatrices());
+
+    return pGpuProgram;
+}
+
+//-----------------------------------------------------------------------------
+void ProgramManager::setupGpuProgram(const GpuProgramPtr& pGpuProgram, const String& source, const String& defines,
+                                     const String& language, const String& profiles, bool columnMajorMatrices)
+{
     pGpuProgram->setSource(source);
-    pGpuProgram->setParameter("preprocessor_defines", shaderProgram->getPreprocessorDefines());
+    pGpuProgram->setParameter("preprocessor_defines", defines);
     pGpuProgram->setParameter("entry_point", "main");
 
     if (language == "hlsl")
     {
         pGpuProgram->setParameter("target", profiles);
         pGpuProgram->setParameter("enable_backwards_compatibility", "true");
-        pGpuProgram->setParameter("column_major_matrices", StringConverter::toString(shaderProgram->getUseColumnMajorMatrices()));
+        pGpuProgram->setParameter("column_major_matrices", StringConverter::toString(columnMajorMatrices));
     }
     else if (language == "glsl")
     {
@@ -240,10 +258,198 @@ GpuProgramPtr ProgramManager::createGpuProgram(Program* shaderProgram,
 
     // Add the created GPU program to local index
     mShaderList.push_back(pGpuProgram);
-    
-    return pGpuProgram;
 }
 
+//-----------------------------------------------------------------------------
+static String getManifestFileName(const String& signature)
+{
+    return ShaderGenerator::getSingleton().getShaderCachePath() + signature + ".rtss";
+}
+
+//-----------------------------------------------------------------------------
+bool ProgramManager::isShareable(const ProgramSet* programSet)
+{
+    for(auto type : {GPT_VERTEX_PROGRAM, GPT_FRAGMENT_PROGRAM})
+    {
+        for (const auto& p : programSet->getCpuProgram(type)->getParameters())
+        {
+            // the value is provided by a sub render state of the pass, which needs its own CPU programs
+            if (p->isUsed() && !p->isAutoConstantParameter() && !p->isSampler())
+                return false;
+        }
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+std::shared_ptr<ProgramSet> ProgramManager::getSharedProgramSet(const String& signature)
+{
+    auto it = mSharedProgramSets.find(signature);
+    if (it == mSharedProgramSets.end())
+        return nullptr;
+
+    auto programSet = it->second.lock();
+    if (!programSet)
+        mSharedProgramSets.erase(it);
+
+    return programSet;
+}
+
+//-----------------------------------------------------------------------------
+void ProgramManager::addSharedProgramSet(const String& signature, const std::shared_ptr<ProgramSet>& programSet)
+{
+    mSharedProgramSets[signature] = programSet;
+
+    // restored sets have no CPU programs and are in the cache already
+    if (programSet->getCpuProgram(GPT_VERTEX_PROGRAM) && !ShaderGenerator::getSingleton().getShaderCachePath().empty())
+        saveCachedGpuPrograms(programSet.get(), signature);
+}
+
+//-----------------------------------------------------------------------------
+void ProgramManager::saveCachedGpuPrograms(ProgramSet* programSet, const String& signature)
+{
+    StringStream manifest;
+
+    for(auto type : {GPT_VERTEX_PROGRAM, GPT_FRAGMENT_PROGRAM})
+    {
+        const auto& gpuProgram = programSet->getGpuProgram(type);
+        Program* cpuProgram = programSet->getCpuProgram(type);
+
+        manifest << "program " << gpuProgram->getName() << " " << cpuProgram->getSkeletalAnimationIncluded() << " "
+                 << cpuProgram->getInstancingIncluded() << " " << cpuProgram->getUseColumnMajorMatrices() << "\n";
+        manifest << "defines " << cpuProgram->getPreprocessorDefines() << "\n";
+
+        for (const auto& p : cpuProgram->getParameters())
+        {
+            if (p->isAutoConstantRealParameter())
+            {
+                manifest << "auto_real " << p->getName() << " " << p->getAutoConstantType() << " "
+                         << StringConverter::toString(p->getAutoConstantRealData(), 9) << "\n";
+            }
+            else if (p->isAutoConstantIntParameter())
+            {
+                manifest << "auto_int " << p->getName() << " " << p->getAutoConstantType() << " "
+                         << p->getAutoConstantIntData() << "\n";
+            }
+            else if (p->isSampler() && p->isUsed())
+            {
+                manifest << "sampler " << p->getName() << " " << p->getIndex() << "\n";
+            }
+        }
+    }
+
+    std::ofstream outFile(getManifestFileName(signature).c_str());
+    outFile << manifest.str();
+}
+
+//-----------------------------------------------------------------------------
+bool ProgramManager::loadCachedGpuPrograms(ProgramSet* programSet, const String& signature)
+{
+    std::ifstream inFile(getManifestFileName(signature).c_str());
+    if (!inFile)
+        return false;
+
+    const String& language = ShaderGenerator::getSingleton().getTargetLanguage();
+    const String& cachePath = ShaderGenerator::getSingleton().getShaderCachePath();
+    auto programWriter = ProgramWriterManager::getSingleton().getProgramWriter(language);
+    bool bindSamplers = language.find("glsl") != String::npos;
+
+    GpuProgramPtr programs[2];
+    GpuProgramParametersSharedPtr params;
+    int count = 0;
+
+    String line;
+    while (std::getline(inFile, line))
+    {
+        std::istringstream fields(line);
+        String key, name;
+        fields >> key >> name;
+
+        if (key == "program")
+        {
+            if (count == 2)
+                return false;
+
+            bool skeletal = false, instancing = false, columnMajor = false;
+            fields >> skeletal >> instancing >> columnMajor;
+
+            String defines;
+            if (!std::getline(inFile, line) || !StringUtil::startsWith(line, "defines ", false))
+                return false;
+            defines = line.substr(8);
+
+            GpuProgramType type = count == 0 ? GPT_VERTEX_PROGRAM : GPT_FRAGMENT_PROGRAM;
+            auto gpuProgram = GpuProgramManager::getSingleton().getByName(name, RGN_INTERNAL);
+
+            if (!gpuProgram)
+            {
+                std::ifstream programFile((cachePath + name + "." + programWriter->getTargetLanguage()).c_str());
+                if (!programFile)
+                    return false;
+
+                StringStream buffer;
+                programFile >> buffer.rdbuf();
+
+                gpuProgram = GpuProgramManager::getSingleton().createProgram(name, RGN_INTERNAL, language, type);
+                setupGpuProgram(gpuProgram, buffer.str(), defines, language,
+                                ShaderGenerator::getSingleton().getShaderProfiles(type), columnMajor);
+            }
+
+            if (type == GPT_VERTEX_PROGRAM)
+            {
+                gpuProgram->setSkeletalAnimationIncluded(skeletal);
+                gpuProgram->setInstancingIncluded(instancing);
+            }
+
+            programs[count++] = gpuProgram;
+            params = gpuProgram->getDefaultParameters();
+            continue;
+        }
+
+        if (!params)
+            return false;
+
+        // only bind what the compiled program actually uses, like ProgramProcessor does
+        if (key == "auto_real" || key == "auto_int")
+        {
+            int acType;
+            fields >> acType;
+            if (!params->_findNamedConstantDefinition(name))
+                continue;
+
+            if (key == "auto_real")
+            {
+                float data;
+                fields >> data;
+                params->setNamedAutoConstantReal(name, GpuProgramParameters::AutoConstantType(acType), data);
+            }
+            else
+            {
+                size_t data;
+                fields >> data;
+                params->setNamedAutoConstant(name, GpuProgramParameters::AutoConstantType(acType), data);
+            }
+        }
+        else if (key == "sampler" && bindSamplers)
+        {
+            int index;
+            fields >> index;
+            if (StringConverter::parseBool(programs[count - 1]->getParameter("has_sampler_binding")))
+                continue;
+
+            params->setIgnoreMissingParams(true);
+            params->setNamedConstant(name, index);
+        }
+    }
+
+    if (count != 2)
+        return false;
+
+    programSet->setGpuProgram(programs[0]);
+    programSet->setGpuProgram(programs[1]);
+    return true;
+}
 
 //-----------------------------------------------------------------------------
 String ProgramManager::generateHash(const String& programString, const String& defines)
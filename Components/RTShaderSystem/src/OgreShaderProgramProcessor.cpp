@@ -36,6 +36,8 @@ ProgramProcessor::ProgramProcessor()
     mMaxTexCoordSlots = 16;
     mMaxTexCoordFloats = mMaxTexCoordSlots * 4;
 
+    // built upfront, as programs may be processed on multiple threads
+    buildMergeCombinations();
 }
 
 //-----------------------------------------------------------------------------
@@ -318,12 +320,6 @@ void ProgramProcessor::mergeParametersByPredefinedCombinations(ShaderParameterLi
                                                                MergeParameterList& mergedParams)
 {
 
-    // Make sure the merge combinations are ready.
-    if (mParamMergeCombinations.empty())
-    {
-        buildMergeCombinations();
-    }
-
     // Create the full used merged params - means FLOAT4 params that all of their components are used.
     for (auto & curCombination : mParamMergeCombinations)
     {
@@ -157,10 +157,139 @@ void TargetRenderState::bindUniformParameters(Program* pCpuProgram, const GpuPro
     }
 }
 
-void TargetRenderState::acquirePrograms(Pass* pass)
+static void writeBlendMode(StringStream& desc, const LayerBlendModeEx& mode)
+{
+    desc << mode.blendType << " " << mode.operation << " " << mode.source1 << " " << mode.source2;
+
+    // manual values are baked into the shader source
+    if (mode.source1 == LBS_MANUAL || mode.source2 == LBS_MANUAL)
+        desc << " " << mode.colourArg1 << " " << mode.colourArg2 << " " << mode.alphaArg1 << " " << mode.alphaArg2;
+    if (mode.operation == LBX_BLEND_MANUAL)
+        desc << " " << mode.factor;
+}
+
+//-----------------------------------------------------------------------
+void TargetRenderState::computeSignature(Pass* srcPass, Pass* dstPass)
+{
+    ShaderGenerator& shaderGenerator = ShaderGenerator::getSingleton();
+    StringStream desc;
+
+    desc << OGRE_VERSION << " " << shaderGenerator.getTargetLanguage() << " "
+         << shaderGenerator.getShaderProfiles(GPT_VERTEX_PROGRAM) << " "
+         << shaderGenerator.getShaderProfiles(GPT_FRAGMENT_PROGRAM) << " "
+         << shaderGenerator.getVertexShaderOutputsCompactPolicy() << "\n";
+
+    // The pass properties the sub render states derive their code from.
+    desc << mLightCount << " " << mHaveAreaLights << " " << srcPass->getLightingEnabled() << " "
+         << srcPass->getVertexColourTracking() << " "
+         << (srcPass->getShininess() > 0 && srcPass->getSpecular() != ColourValue::Black) << " "
+         << srcPass->getIteratePerLight() << " " << srcPass->getLightCountPerIteration() << " "
+         << srcPass->getMaxSimultaneousLights() << " " << srcPass->getAlphaRejectFunction() << " "
+         << srcPass->getPointSpritesEnabled() << " " << srcPass->isPointAttenuationEnabled() << " ";
+
+    SceneManager* sceneMgr = shaderGenerator.getActiveSceneManager();
+    if (srcPass->getFogOverride())
+        desc << "fog " << srcPass->getFogMode() << "\n";
+    else
+        desc << "scene_fog " << (sceneMgr ? sceneMgr->getFogMode() : FOG_NONE) << "\n";
+
+    std::set<uint16> nonFFP_TUS;
+    auto nonFFPany = srcPass->getUserObjectBindings().getUserAny("_RTSS_nonFFP_TUS");
+    if (nonFFPany.has_value())
+        nonFFP_TUS = any_cast<std::set<uint16>>(nonFFPany);
+
+    for (unsigned short i = 0; i < dstPass->getNumTextureUnitStates(); ++i)
+    {
+        const TextureUnitState* tus = dstPass->getTextureUnitState(i);
+        const auto& effects = tus->getEffects();
+
+        desc << "tus " << (nonFFP_TUS.find(i) != nonFFP_TUS.end()) << " " << tus->getContentType() << " "
+             << tus->getTextureType() << " " << tus->getTextureCoordSet() << " "
+             << (tus->getTextureTransform() != Matrix4::IDENTITY) << " ";
+        writeBlendMode(desc, tus->getColourBlendMode());
+        desc << " ";
+        writeBlendMode(desc, tus->getAlphaBlendMode());
+
+        for (const auto& e : effects)
+            desc << " " << e.first << ":" << e.second.subtype;
+        desc << "\n";
+    }
+
+    // The configuration of the sub render states, as it would be written to a material script.
+    sortSubRenderStates();
+
+    MaterialSerializer ser;
+    for (auto srs : mSubRenderStateList)
+    {
+        desc << "srs " << srs->getType() << "\n";
+
+        SubRenderStateFactory* factory = shaderGenerator.getSubRenderStateFactory(srs->getType());
+        if (!factory)
+            continue;
+
+        factory->writeInstance(&ser, srs, srcPass, dstPass);
+        for (unsigned short i = 0; i < srcPass->getNumTextureUnitStates(); ++i)
+        {
+            const TextureUnitState* srcTus = srcPass->getTextureUnitState(i);
+            const TextureUnitState* dstTus =
+                i < dstPass->getNumTextureUnitStates() ? dstPass->getTextureUnitState(i) : srcTus;
+            factory->writeInstance(&ser, srs, srcTus, dstTus);
+        }
+    }
+    desc << ser.getQueuedAsString();
+
+    mSignature = ProgramManager::generateHash(desc.str(), BLANKSTRING);
+}
+
+//-----------------------------------------------------------------------
+bool TargetRenderState::loadCachedPrograms()
+{
+    if (mSignature.empty())
+        return false;
+
+    ProgramManager& programManager = ProgramManager::getSingleton();
+
+    // structurally identical passes share their programs
+    mProgramSet = programManager.getSharedProgramSet(mSignature);
+    if (mProgramSet)
+        return true;
+
+    if (ShaderGenerator::getSingleton().getShaderCachePath().empty())
+        return false;
+
+    auto programSet = std::make_shared<ProgramSet>();
+    if (!programManager.loadCachedGpuPrograms(programSet.get(), mSignature))
+        return false;
+
+    programManager.addSharedProgramSet(mSignature, programSet);
+    mProgramSet = programSet;
+    return true;
+}
+
+//-----------------------------------------------------------------------
+void TargetRenderState::generatePrograms()
 {
     createCpuPrograms();
-    ProgramManager::getSingleton().createGpuPrograms(mProgramSet.get());
+    ProgramManager::getSingleton().prepareGpuPrograms(mProgramSet.get());
+}
+
+//-----------------------------------------------------------------------
+void TargetRenderState::acquirePrograms(Pass* pass)
+{
+    // the programs might have been shared, restored or generated upfront
+    if (!mProgramSet && !loadCachedPrograms())
+        generatePrograms();
+
+    // only bind the uniforms of the programs generated for this pass
+    bool generated = !mProgramSet->getGpuProgram(GPT_VERTEX_PROGRAM);
+    if (generated)
+    {
+        ProgramManager& programManager = ProgramManager::getSingleton();
+        programManager.createGpuPrograms(mProgramSet.get());
+
+        if (!mSignature.empty() && ProgramManager::isShareable(mProgramSet.get()))
+            programManager.addSharedProgramSet(mSignature, mProgramSet);
+    }
 
     bool hasError = false;
     bool logProgramNames = !ShaderGenerator::getSingleton().getShaderCachePath().empty();
@@ -178,8 +307,9 @@ void TargetRenderState::acquirePrograms(Pass* pass)
 
         // Bind the created GPU programs to the target pass.
         pass->setGpuProgram(type, prog);
-        // Bind uniform parameters to pass parameters.
-        bindUniformParameters(mProgramSet->getCpuProgram(type), pass->getGpuProgramParameters(type));
+        // Bind uniform parameters to pass parameters. Shared programs only use auto constants.
+        if (generated)
+            bindUniformParameters(mProgramSet->getCpuProgram(type), pass->getGpuProgramParameters(type));
     }
 
     if (hasError)
@@ -29,6 +29,7 @@ THE SOFTWARE.
 #define __Ogre_Volume_CacheSource_H__
 
 #include "OgreVector.h"
+#include "Threading/OgreThreadHeaders.h"
 
 #include "OgreVolumeSource.h"
 #include "OgreVolumePrerequisites.h"
@@ -52,47 +53,75 @@ namespace Volume {
     bool _OgreVolumeExport operator<(const Vector3& a, const Vector3& b);
 
     /** A caching Source.
+
+    Values are memoised in fixed-size dense bricks of BRICK_SIZE^3 lattice cells, keyed by
+    the integer lattice coordinates of the brick. Only positions lying on the lattice defined
+    by the cell size are cached, all others are passed through to the wrapped source. The
+    amount of bricks is bounded, the least recently used one is recycled when the limit is hit.
+    The cache may be shared by chunks loading concurrently on the WorkQueue.
     */
     class _OgreVolumeExport CacheSource : public Source
     {
+    public:
+        /// The edge length of a brick in lattice cells.
+        static const int BRICK_SIZE = 8;
+
     protected:
-        
-        /// Map for the cache
-        typedef std::map<Vector3, Vector4> UMapPositionValue;
-        mutable UMapPositionValue mCache;
+
+        /// The amount of lattice cells in a brick.
+        static const int BRICK_CELLS = BRICK_SIZE * BRICK_SIZE * BRICK_SIZE;
+
+        /// A dense block of cached values.
+        struct Brick
+        {
+            /// The key of the brick.
+            uint64 key;
+            /// Bitmask of the cells holding a valid value.
+            uint64 valid[BRICK_CELLS / 64];
+            /// The density values (w-component) and the gradients (x, y and z component).
+            Vector4 values[BRICK_CELLS];
+        };
+
+        /// The bricks, the most recently used one first.
+        typedef std::list<Brick> BrickList;
+        mutable BrickList mBricks;
+
+        /// Map from the brick key to the brick.
+        typedef std::unordered_map<uint64, BrickList::iterator> BrickMap;
+        mutable BrickMap mBrickMap;
+
+        /// Protects the bricks.
+        OGRE_WQ_MUTEX(mMutex);
 
         /// The source to cache.
         const Source *mSrc;
-        
+
+        /// The inverse of the lattice cell size.
+        Real mInvCellSize;
+
+        /// The maximum amount of bricks.
+        size_t mMaxBricks;
+
         /** Gets a density value and gradient from the cache.
         @param position
             The position of the density value and gradient.
         @return
             The density value (w-component) and the gradient (x, y and z component).
         */
-        inline Vector4 getFromCache(const Vector3 &position) const
-        {
-            Vector4 result;
-            std::map<Vector3, Vector4>::iterator it = mCache.find(position);
-            if (it == mCache.end())
-            {
-                result = mSrc->getValueAndGradient(position);
-                mCache[position] = result;
-            }
-            else
-            {
-                result = it->second;
-            }
-            return result;
-        }
+        Vector4 getFromCache(const Vector3 &position) const;
 
     public:
         
         /** Constructor.
         @param src
             The source to cache.
+        @param cellSize
+            The distance of the lattice points which are cached. Choose the size of the
+            smallest dual cell (or a power of two fraction of it) so all sampled positions hit the lattice.
+        @param maxBricks
+            The maximum amount of bricks held at once.
         */
-        CacheSource(const Source *src);
+        CacheSource(const Source *src, Real cellSize = (Real)1.0, size_t maxBricks = 1024);
         
         /** Overridden from Source.
         */
@@ -102,6 +131,16 @@ namespace Volume {
         */
         Real getValue(const Vector3 &position) const override;
 
+        /** Drops all cached values, for example after the cached source changed.
+        */
+        void clear(void);
+
+        /** Gets the amount of bricks currently in use.
+        @return
+            The amount of bricks.
+        */
+        size_t getBrickCount(void) const;
+
     };
     /** @} */
     /** @} */
@@ -125,9 +125,25 @@ namespace Volume {
         /// The parameters with which the chunktree got loaded.
         ChunkParameters *parameters;
 
+        /// The scene node the tree got loaded into.
+        SceneNode *parent;
+
+        /// The back lower left corner of the whole tree.
+        Vector3 totalFrom;
+
+        /// The front upper right corner of the whole tree.
+        Vector3 totalTo;
+
+        /// The amount of LOD levels of the tree.
+        size_t maxLevels;
+
+        /// MeshBuilders of finished chunks to be reused by the next ones, only accessed from the main thread.
+        std::vector<MeshBuilder*> meshBuilderPool;
+
         /** Constructor.
         */
-        ChunkTreeSharedData(const ChunkParameters *params) : octreeVisible(false), dualGridVisible(false), volumeVisible(true), chunksBeingProcessed(0)
+        ChunkTreeSharedData(const ChunkParameters *params) : octreeVisible(false), dualGridVisible(false), volumeVisible(true), chunksBeingProcessed(0),
+            parent(0), totalFrom(Vector3::ZERO), totalTo(Vector3::ZERO), maxLevels(0)
         {
             this->parameters = new ChunkParameters(*params);
         }
@@ -173,6 +189,9 @@ namespace Volume {
 
         /// Whether this is an update of an existing tree
         bool isUpdate;
+
+        /// The id of the request, to detect results superseded by a later update.
+        size_t id;
     };
 
     protected:
@@ -200,6 +219,9 @@ namespace Volume {
         /// Holds some shared data among all chunks of the tree.
         ChunkTreeSharedData *mShared;
 
+        /// The id of the latest geometry request of this chunk.
+        size_t mRequestId;
+
         /** Loads a single chunk of the tree.
         @param parent
             The parent scene node for the volume
@@ -295,6 +317,14 @@ namespace Volume {
         */
         virtual void loadGeometry(MeshBuilder *meshBuilder, DualGridGenerator *dualGridGenerator, OctreeNode *root, size_t level, bool isUpdate);
 
+        /** Frees the geometry and the debug visualizations of this chunk.
+        */
+        void destroyGeometry(void);
+
+        /** Waits until all chunk requests of the tree are loaded, processing the main thread tasks.
+        */
+        void waitForLoads(void);
+
         /** Sets the visibility of this chunk.
         @param visible
             Whether this chunk is visible or not.
@@ -391,6 +421,17 @@ namespace Volume {
             The resource group where to search for the configuration file.
         */
         virtual void load(SceneNode *parent, SceneManager *sceneManager, const String& filename, bool validSourceResult = false, MeshBuilderCallback *lodCallback = 0, const String& resourceGroup = ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME);
+
+        /** Remeshes the chunks of all LOD levels intersecting an area after the source changed there,
+        for example via GridSource::combineWithSource. Only to be called on the root chunk. The chunks
+        are rebuilt on the WorkQueue, their old geometry stays visible until the new one is swapped in
+        on the main thread. Like load, this waits for the new geometry unless ChunkParameters::async is set.
+        @param from
+            The back lower left corner of the changed area.
+        @param to
+            The front upper right corner of the changed area.
+        */
+        virtual void update(const Vector3 &from, const Vector3 &to);
         
         /** Shows the debug visualization entity of the dualgrid.
         @param visible
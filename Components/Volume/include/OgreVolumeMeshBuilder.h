@@ -138,9 +138,14 @@ namespace Volume {
         /// The buffer binding.
         static const unsigned short MAIN_BINDING;
 
-        /// Map to get a vertex index.
-        typedef std::map<Vertex, uint32> UMapVertexIndex;
-        UMapVertexIndex mIndexMap;
+        /// The initial amount of slots of the vertex hash table.
+        static const size_t INITIAL_SLOT_COUNT;
+
+        /// Open addressing hash table with linear probing to get a vertex index. Holds the index + 1, 0 marks a free slot.
+        VecIndices mSlots;
+
+        /// The amount of slots - 1, the amount is always a power of two.
+        size_t mSlotMask;
 
          /// Holds the vertices of the mesh.
         VecVertex mVertices;
@@ -153,6 +158,31 @@ namespace Volume {
 
         /// Holds whether the initial bounding box has been set
         bool mBoxInit;
+
+        /** Hashes the bit pattern of a vertex.
+        @param v
+            The vertex.
+        @return
+            The hash.
+        */
+        static inline uint32 hashVertex(const Vertex &v)
+        {
+            uint32 words[sizeof(Vertex) / sizeof(uint32)];
+            memcpy(words, &v, sizeof(Vertex));
+            uint32 h = 0x811C9DC5;
+            for (uint32 w : words)
+            {
+                h = (h ^ w) * 0x01000193;
+                h ^= h >> 15;
+            }
+            return h;
+        }
+
+        /** Resizes the vertex hash table and reinserts all known vertices.
+        @param slotCount
+            The new amount of slots, must be a power of two.
+        */
+        void rehash(size_t slotCount);
         
         /** Adds a vertex to the data structure, reusing the index if it is already known.
         @param v
@@ -160,21 +190,30 @@ namespace Volume {
         */
         inline void addVertex(const Vertex &v)
         {
-            uint32 i = 0;
-            if (mIndexMap.find(v) == mIndexMap.end())
+            // Keep the load factor at or below 0.5
+            if ((mVertices.size() + 1) * 2 > mSlots.size())
             {
-                i = mVertices.size();
-                mIndexMap[v] = i;
-                mVertices.push_back(v);
-
-                // Update bounding box
-                mBox.merge(Vector3(v.x, v.y, v.z));
+                rehash(std::max(mSlots.size() * 2, INITIAL_SLOT_COUNT));
             }
-            else
+
+            size_t slot = hashVertex(v) & mSlotMask;
+            while (uint32 stored = mSlots[slot])
             {
-                i = mIndexMap[v];
+                if (memcmp(&mVertices[stored - 1], &v, sizeof(Vertex)) == 0)
+                {
+                    mIndices.push_back(stored - 1);
+                    return;
+                }
+                slot = (slot + 1) & mSlotMask;
             }
+
+            uint32 i = (uint32)mVertices.size();
+            mSlots[slot] = i + 1;
+            mVertices.push_back(v);
             mIndices.push_back(i);
+
+            // Update bounding box
+            mBox.merge(Vector3(v.x, v.y, v.z));
         }
 
     public:
@@ -248,6 +287,17 @@ namespace Volume {
         /** Constructor.
         */
         MeshBuilder(void);
+
+        /** Removes all vertices and indices while keeping the allocated memory
+            so the builder can be reused for the next chunk.
+        */
+        void clear(void);
+
+        /** Gets the amount of unique vertices.
+        @return
+            The amount of vertices.
+        */
+        size_t getVertexCount(void) const { return mVertices.size(); }
         
         /** Adds a triangle to the mesh with reusing already existent vertices via their index.
         @param v0
@@ -38,12 +38,114 @@ namespace Volume {
 
     //-----------------------------------------------------------------------
 
-    CacheSource::CacheSource(const Source *src) : mSrc(src)
+    namespace
+    {
+        /// log2 of the brick edge length.
+        const int BRICK_SHIFT = 3;
+        /// The bits per axis in a brick key.
+        const int KEY_BITS = 21;
+        const uint64 KEY_MASK = (1ull << KEY_BITS) - 1;
+        /// The largest absolute lattice coordinate which can be encoded in a key.
+        const Real MAX_LATTICE_COORD = (Real)((1ll << (KEY_BITS - 1 + BRICK_SHIFT)) - 1);
+        /// How far off a lattice point a position may be and still be treated as lying on it, in cells.
+        const Real LATTICE_EPSILON = (Real)0.0001;
+
+        /** Snaps a coordinate in cell units to the lattice.
+        @param coord
+            The coordinate in cell units.
+        @param lattice
+            Receives the lattice coordinate.
+        @return
+            true if the coordinate lies on the lattice and can be encoded in a key.
+        */
+        inline bool toLattice(Real coord, int64 &lattice)
+        {
+            Real rounded = std::floor(coord + (Real)0.5);
+            if (Math::Abs(coord - rounded) > LATTICE_EPSILON || Math::Abs(rounded) > MAX_LATTICE_COORD)
+            {
+                return false;
+            }
+            lattice = (int64)rounded;
+            return true;
+        }
+    }
+
+    static_assert(CacheSource::BRICK_SIZE == 1 << BRICK_SHIFT, "BRICK_SHIFT does not match BRICK_SIZE");
+
+    //-----------------------------------------------------------------------
+
+    CacheSource::CacheSource(const Source *src, Real cellSize, size_t maxBricks) :
+        mSrc(src), mInvCellSize((Real)1.0 / cellSize), mMaxBricks(std::max<size_t>(maxBricks, 1))
     {
     }
     
     //-----------------------------------------------------------------------
 
+    Vector4 CacheSource::getFromCache(const Vector3 &position) const
+    {
+        int64 x, y, z;
+        if (!toLattice(position.x * mInvCellSize, x) ||
+            !toLattice(position.y * mInvCellSize, y) ||
+            !toLattice(position.z * mInvCellSize, z))
+        {
+            return mSrc->getValueAndGradient(position);
+        }
+
+        const uint64 key = ((uint64)(x >> BRICK_SHIFT) & KEY_MASK) |
+            (((uint64)(y >> BRICK_SHIFT) & KEY_MASK) << KEY_BITS) |
+            (((uint64)(z >> BRICK_SHIFT) & KEY_MASK) << (KEY_BITS * 2));
+        const int64 cellMask = BRICK_SIZE - 1;
+        const size_t cell = (size_t)((x & cellMask) | ((y & cellMask) << BRICK_SHIFT) | ((z & cellMask) << (BRICK_SHIFT * 2)));
+        const uint64 cellBit = 1ull << (cell & 63);
+
+        {
+            OGRE_WQ_LOCK_MUTEX(mMutex);
+            BrickMap::iterator it = mBrickMap.find(key);
+            if (it != mBrickMap.end())
+            {
+                mBricks.splice(mBricks.begin(), mBricks, it->second);
+                const Brick &brick = *it->second;
+                if (brick.valid[cell >> 6] & cellBit)
+                {
+                    return brick.values[cell];
+                }
+            }
+        }
+
+        // Evaluate without holding the lock so other threads can keep on using the cache.
+        Vector4 result = mSrc->getValueAndGradient(position);
+
+        OGRE_WQ_LOCK_MUTEX(mMutex);
+        BrickList::iterator brick;
+        BrickMap::iterator it = mBrickMap.find(key);
+        if (it != mBrickMap.end())
+        {
+            brick = it->second;
+        }
+        else
+        {
+            if (mBricks.size() >= mMaxBricks)
+            {
+                // Recycle the least recently used brick.
+                brick = std::prev(mBricks.end());
+                mBrickMap.erase(brick->key);
+                mBricks.splice(mBricks.begin(), mBricks, brick);
+            }
+            else
+            {
+                brick = mBricks.emplace(mBricks.begin());
+            }
+            brick->key = key;
+            memset(brick->valid, 0, sizeof(brick->valid));
+            mBrickMap.emplace(key, brick);
+        }
+        brick->values[cell] = result;
+        brick->valid[cell >> 6] |= cellBit;
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
     Vector4 CacheSource::getValueAndGradient(const Vector3 &position) const
     {
         return getFromCache(position);
@@ -56,5 +158,22 @@ namespace Volume {
         return getFromCache(position).w;
     }
 
+    //-----------------------------------------------------------------------
+
+    void CacheSource::clear(void)
+    {
+        OGRE_WQ_LOCK_MUTEX(mMutex);
+        mBrickMap.clear();
+        mBricks.clear();
+    }
+
+    //-----------------------------------------------------------------------
+
+    size_t CacheSource::getBrickCount(void) const
+    {
+        OGRE_WQ_LOCK_MUTEX(mMutex);
+        return mBricks.size();
+    }
+
 }
 }
\ No newline at end of file
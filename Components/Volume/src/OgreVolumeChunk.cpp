@@ -71,16 +71,35 @@ namespace Volume {
             req.maxLevels = maxLevels;
             req.isUpdate = mShared->parameters->updateFrom != Vector3::ZERO || mShared->parameters->updateTo != Vector3::ZERO;
 
+            req.id = ++mRequestId;
+
             req.root = OGRE_NEW OctreeNode(from, to);
-            req.meshBuilder = OGRE_NEW MeshBuilder();
+            if (mShared->meshBuilderPool.empty())
+            {
+                req.meshBuilder = OGRE_NEW MeshBuilder();
+            }
+            else
+            {
+                req.meshBuilder = mShared->meshBuilderPool.back();
+                mShared->meshBuilderPool.pop_back();
+            }
             req.dualGridGenerator = OGRE_NEW DualGridGenerator();
 
             Root::getSingleton().getWorkQueue()->addTask([this, req]() {
                 prepareGeometry(req.level, req.root, req.dualGridGenerator, req.meshBuilder, req.totalFrom, req.totalTo);
                 Root::getSingleton().getWorkQueue()->addMainThreadTask([this, req]() {
-                    loadGeometry(req.meshBuilder, req.dualGridGenerator, req.root, req.level, req.isUpdate);
+                    // Drop the result if a later update of this chunk is on its way.
+                    if (req.id == mRequestId)
+                    {
+                        loadGeometry(req.meshBuilder, req.dualGridGenerator, req.root, req.level, req.isUpdate);
+                    }
+                    else
+                    {
+                        mShared->chunksBeingProcessed--;
+                    }
                     delete req.root;
-                    delete req.meshBuilder;
+                    req.meshBuilder->clear();
+                    mShared->meshBuilderPool.push_back(req.meshBuilder);
                     delete req.dualGridGenerator;
                 });
             });
@@ -167,27 +186,29 @@ namespace Volume {
             {
                 return;
             }
-            // Free memory from old mesh version
-            if (mRenderOp.vertexData)
-            {
-                OGRE_DELETE mRenderOp.vertexData;
-                mRenderOp.vertexData = 0;
-            }
-            if (mRenderOp.indexData)
+
+            // The old mesh stays until the new one is ready, unless there won't be a new one.
+            if (!contributesToVolumeMesh(from, to))
             {
-                OGRE_DELETE mRenderOp.indexData;
-                mRenderOp.indexData = 0;
+                // Drop the result of a load which might still be pending.
+                ++mRequestId;
+                setChunkVisible(false, true);
+                destroyGeometry();
+                mInvisible = true;
+                return;
             }
         }
-
-        // Set to invisible for now.
-        mVisible = false;
-        mInvisible = true;
-        
-        // Don't generate this chunk if it doesn't contribute to the whole volume.
-        if (!contributesToVolumeMesh(from, to))
+        else
         {
-            return;
+            // Set to invisible for now.
+            mVisible = false;
+            mInvisible = true;
+
+            // Don't generate this chunk if it doesn't contribute to the whole volume.
+            if (!contributesToVolumeMesh(from, to))
+            {
+                return;
+            }
         }
     
         loadChunk(parent, from, to, totalFrom, totalTo, level, maxLevels);
@@ -214,6 +235,8 @@ namespace Volume {
 
     void Chunk::loadGeometry(MeshBuilder *meshBuilder, DualGridGenerator *dualGridGenerator, OctreeNode *root, size_t level, bool isUpdate)
     {
+        // Swap in the new geometry at once.
+        destroyGeometry();
         size_t chunkTriangles = meshBuilder->generateBuffers(mRenderOp);
         mInvisible = chunkTriangles == 0;
 
@@ -224,16 +247,16 @@ namespace Volume {
 
         mBox = meshBuilder->getBoundingBox();
 
-        if (!mInvisible)
+        if (!mInvisible && !isAttached())
         {
-            if (isUpdate)
-            {
-                mNode->detachObject(this);
-            }
             mNode->attachObject(this);
         }
 
-        mVisible = false;
+        // Keep the visibility of updated chunks to not let them flicker.
+        if (!isUpdate)
+        {
+            mVisible = false;
+        }
 
         if (mShared->parameters->createDualGridVisualization)
         {
@@ -241,7 +264,7 @@ namespace Volume {
             if (mDualGrid)
             {
                 mNode->attachObject(mDualGrid);
-                mDualGrid->setVisible(false);
+                mDualGrid->setVisible(mShared->dualGridVisible && mVisible);
             }
         }
 
@@ -249,15 +272,40 @@ namespace Volume {
         {
             mOctree = root->getOctreeGrid(mShared->parameters->sceneManager);
             mNode->attachObject(mOctree);
-            mOctree->setVisible(false);
+            mOctree->setVisible(mShared->octreeVisible && mVisible);
         }
         mShared->chunksBeingProcessed--;
     }
+
+    //-----------------------------------------------------------------------
+
+    void Chunk::destroyGeometry(void)
+    {
+        if (isAttached())
+        {
+            mNode->detachObject(this);
+        }
+        OGRE_DELETE mRenderOp.vertexData;
+        mRenderOp.vertexData = 0;
+        OGRE_DELETE mRenderOp.indexData;
+        mRenderOp.indexData = 0;
+
+        if (mDualGrid)
+        {
+            mShared->parameters->sceneManager->destroyEntity(mDualGrid);
+            mDualGrid = 0;
+        }
+        if (mOctree)
+        {
+            mShared->parameters->sceneManager->destroyEntity(mOctree);
+            mOctree = 0;
+        }
+    }
     
     //-----------------------------------------------------------------------
 
     Chunk::Chunk(void) : mNode(0), mError(false), mDualGrid(0), mOctree(0), mChildren(0),
-        mInvisible(false), isRoot(false), mShared(0)
+        mInvisible(false), isRoot(false), mShared(0), mRequestId(0)
     {
     }
     
@@ -291,6 +339,10 @@ namespace Volume {
         delete[] mChildren;
         if (isRoot)
         {
+            for (auto mb : mShared->meshBuilderPool)
+            {
+                OGRE_DELETE mb;
+            }
             delete mShared;
         }
     }
@@ -332,6 +384,10 @@ namespace Volume {
         if (parameters->updateFrom == Vector3::ZERO && parameters->updateTo == Vector3::ZERO)
         {
             mShared = new ChunkTreeSharedData(parameters);
+            mShared->parent = parent;
+            mShared->totalFrom = from;
+            mShared->totalTo = to;
+            mShared->maxLevels = level;
             parent->scale(Vector3(parameters->scale));
         }
 
@@ -342,11 +398,7 @@ namespace Volume {
         // Wait for the threads.
         if (!parameters->async)
         {
-            while(mShared->chunksBeingProcessed)
-            {
-                OGRE_THREAD_SLEEP(0);
-                Root::getSingleton().getWorkQueue()->processMainThreadTasks();
-            }
+            waitForLoads();
         }
         
     
@@ -419,6 +471,40 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void Chunk::update(const Vector3 &from, const Vector3 &to)
+    {
+        if (!isRoot)
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALID_CALL, "Only the root chunk can be updated!", "Chunk::update");
+        }
+
+        ChunkParameters *parameters = mShared->parameters;
+        parameters->updateFrom = from;
+        parameters->updateTo = to;
+        doLoad(mShared->parent, mShared->totalFrom, mShared->totalTo, mShared->totalFrom, mShared->totalTo, mShared->maxLevels, mShared->maxLevels);
+        parameters->updateFrom = Vector3::ZERO;
+        parameters->updateTo = Vector3::ZERO;
+
+        // Wait for the threads, like load does.
+        if (!parameters->async)
+        {
+            waitForLoads();
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void Chunk::waitForLoads(void)
+    {
+        while(mShared->chunksBeingProcessed)
+        {
+            OGRE_THREAD_SLEEP(0);
+            Root::getSingleton().getWorkQueue()->processMainThreadTasks();
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     void Chunk::setDualGridVisible(const bool visible)
     {
         mShared->dualGridVisible = visible;
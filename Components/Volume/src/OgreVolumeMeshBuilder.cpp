@@ -56,15 +56,44 @@ namespace Volume {
     //-----------------------------------------------------------------------
 
     const unsigned short MeshBuilder::MAIN_BINDING = 0;
+    const size_t MeshBuilder::INITIAL_SLOT_COUNT = 1024;
 
     //-----------------------------------------------------------------------
 
-    MeshBuilder::MeshBuilder(void) : mBoxInit(false)
+    MeshBuilder::MeshBuilder(void) : mSlotMask(0), mBoxInit(false)
     {
     }
 
     //-----------------------------------------------------------------------
 
+    void MeshBuilder::rehash(size_t slotCount)
+    {
+        mSlots.assign(slotCount, 0);
+        mSlotMask = slotCount - 1;
+        for (size_t i = 0; i < mVertices.size(); ++i)
+        {
+            size_t slot = hashVertex(mVertices[i]) & mSlotMask;
+            while (mSlots[slot])
+            {
+                slot = (slot + 1) & mSlotMask;
+            }
+            mSlots[slot] = (uint32)i + 1;
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void MeshBuilder::clear(void)
+    {
+        mVertices.clear();
+        mIndices.clear();
+        std::fill(mSlots.begin(), mSlots.end(), 0);
+        mBox.setNull();
+        mBoxInit = false;
+    }
+
+    //-----------------------------------------------------------------------
+
     size_t MeshBuilder::generateBuffers(RenderOperation &operation)
     {
         // Early out if nothing to do.
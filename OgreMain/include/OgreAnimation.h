@@ -502,6 +502,13 @@ namespace Ogre {
         
         /// Internal method to adjust keyframes relative to a base keyframe (see @ref setUseBaseKeyFrame)
         void _applyBaseKeyFrame();
+
+        /** Internal method to build all data that sampling creates on demand.
+
+            Applies the base keyframe and builds the global keyframe index and the node track
+            splines, after which several threads may sample the animation at once.
+        */
+        void _prepareForSampling();
         
         void _notifyContainer(AnimationContainer* c);
         /** Retrieve the container of this animation. */
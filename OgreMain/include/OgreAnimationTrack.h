@@ -233,6 +233,9 @@ namespace Ogre
         /** Internal method to re-base the keyframes relative to a given keyframe. */
         virtual void _applyBaseKeyFrame(const KeyFrame* base);
 
+        /// Times of the keys in ascending order, contiguous for searching
+        virtual const std::vector<Real>& _getKeyFrameTimes() const { return mKeyFrameTimes; }
+
         /** Set a listener for this track. */
         virtual void setListener(Listener* l) { mListener = l; }
 
@@ -242,6 +245,8 @@ namespace Ogre
         /// Map used to translate global keyframe time lower bound index to local lower bound index
         typedef std::vector<ushort> KeyFrameIndexMap;
         KeyFrameIndexMap mKeyFrameIndexMap;
+        /// Times of mKeyFrames
+        std::vector<Real> mKeyFrameTimes;
 
         /// Create a keyframe implementation - must be overridden
         virtual KeyFrame* createKeyFrameImpl(Real time) = 0;
@@ -254,6 +259,14 @@ namespace Ogre
 
         /// Internal method for clone implementation
         virtual void populateClone(AnimationTrack* clone) const;
+
+        /** Finds the index of the first key at or after the time, limited to the last key.
+
+            Uses the global keyframe index if available, otherwise searches _getKeyFrameTimes.
+        @param timeIndex The time index
+        @param timePos Receives the time position, wrapped to the animation length
+        */
+        size_t findKeyFrameAtTime(const TimeIndex& timeIndex, Real& timePos) const;
     };
 
     /** Specialised AnimationTrack for dealing with generic animable values.
@@ -309,6 +322,36 @@ namespace Ogre
 
     };
 
+    /** Quantised keyframe storage of a compressed NodeAnimationTrack.
+
+        Rotations are stored as 48 bit smallest-three quaternions: the index of the largest
+        component goes in the top bits of the first two words and the remaining three
+        components use 15 bits each. Translations and scales use 16 bits per component
+        within the range of the track.
+    */
+    struct _OgreExport CompressedTransformKeys
+    {
+        /// Key times, ascending
+        std::vector<Real> times;
+        /// 3 words per key
+        std::vector<uint16> rotations;
+        Vector3 translateMin;
+        Vector3 translateExtent;
+        /// 3 words per key
+        std::vector<uint16> translations;
+        Vector3 scaleMin;
+        Vector3 scaleExtent;
+        /// 3 words per key, empty if all keys have unit scale
+        std::vector<uint16> scales;
+
+        size_t getNumKeys() const { return times.size(); }
+        /// Decodes a single key
+        void getKey(size_t index, Vector3& translate, Quaternion& rotate, Vector3& scale) const;
+        /// Encodes and appends a key, the ranges above must be set beforehand
+        void addKey(Real time, const Vector3& translate, const Quaternion& rotate,
+                    const Vector3& scale);
+    };
+
     /** Specialised AnimationTrack for dealing with node transforms.
     */
     class _OgreExport NodeAnimationTrack : public AnimationTrack
@@ -333,6 +376,40 @@ namespace Ogre
         virtual void applyToNode(Node* node, const TimeIndex& timeIndex, Real weight = 1.0, 
             Real scale = 1.0f);
 
+        /** As applyToNode, but returns the weighted transform instead of applying it.
+
+            The result composes onto a local transform the same way applyToNode does:
+            position += translate, orientation = orientation * rotate, scale *= scale.
+        @return false if the track has no effect, i.e. it has no keyframes or weight is zero
+        */
+        bool _getWeightedTransform(const TimeIndex& timeIndex, Real weight, Real scale,
+            Vector3& outTranslate, Quaternion& outRotate, Vector3& outScale) const;
+
+        /** Replaces the keyframes by a compact, quantised representation.
+
+            Keys that linear interpolation of their neighbours reproduces within the given
+            tolerances are dropped, the remaining ones are stored as CompressedTransformKeys
+            and decoded on the fly when sampling. Compressed tracks have no KeyFrame objects,
+            call decompress before editing them.
+        @param translationTolerance maximum distance error of the dropped translation keys
+        @param rotationTolerance maximum angle error of the dropped rotation keys
+        @param scaleTolerance maximum error of the dropped scale keys
+        */
+        void compress(Real translationTolerance = 1e-3f, const Radian& rotationTolerance = Radian(1e-3f),
+                      Real scaleTolerance = 1e-3f);
+
+        /** Restores editable keyframes from the compressed representation. */
+        void decompress();
+
+        /** Whether this track stores its keys compressed. */
+        bool isCompressed() const { return mCompressed != 0; }
+
+        /// The compressed keys, or NULL if the track is not compressed
+        const CompressedTransformKeys* _getCompressedKeys() const { return mCompressed; }
+
+        /// Replaces all keyframes by the given compressed keys
+        void _setCompressedKeys(const CompressedTransformKeys& keys);
+
         /** Sets the method of rotation calculation */
         virtual void setUseShortestRotationPath(bool useShortestPath);
 
@@ -348,6 +425,14 @@ namespace Ogre
         /// @copydoc AnimationTrack::_keyFrameDataChanged
         void _keyFrameDataChanged(void) const override;
 
+        /// Builds the interpolation splines ahead of time, see Animation::_prepareForSampling
+        void _prepareForSampling(void) const;
+
+        const std::vector<Real>& _getKeyFrameTimes() const override
+        {
+            return mCompressed ? mCompressed->times : AnimationTrack::_getKeyFrameTimes();
+        }
+
         /** Returns the KeyFrame at the specified index. */
         virtual TransformKeyFrame* getNodeKeyFrame(unsigned short index) const;
 
@@ -371,6 +456,9 @@ namespace Ogre
         KeyFrame* createKeyFrameImpl(Real time) override;
         // Flag indicating we need to rebuild the splines next time
         virtual void buildInterpolationSplines(void) const;
+        /// Finds the compressed keys around the time, see AnimationTrack::getKeyFramesAtTime
+        Real getCompressedKeysAtTime(const TimeIndex& timeIndex, TransformKeyFrame* keyFrame1,
+                                     TransformKeyFrame* keyFrame2, unsigned short* firstKeyIndex) const;
 
         // Struct for store splines, allocate on demand for better memory footprint
         struct Splines
@@ -386,6 +474,8 @@ namespace Ogre
         Node* mTargetNode;
         // Prebuilt splines, must be mutable since lazy-update in const method
         mutable Splines* mSplines;
+        // Compressed keys, allocated on demand, replace mKeyFrames when set
+        CompressedTransformKeys* mCompressed;
     };
 
     /** Type of vertex animation.
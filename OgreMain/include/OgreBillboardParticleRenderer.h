@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "OgrePrerequisites.h"
 #include "OgreParticleSystemRenderer.h"
 #include "OgreBillboardSet.h"
+#include "OgreBillboard.h"
 #include "OgreHeaderPrefix.h"
 
 namespace Ogre {
@@ -54,6 +55,8 @@ namespace Ogre {
         /// The billboard set that's doing the rendering
         BillboardSet* mBillboardSet;
         Vector2 mStacksSlices;
+        /// Billboards of the current particles, injected into mBillboardSet in one batch
+        std::vector<Billboard> mBillboards;
     public:
         BillboardParticleRenderer();
         ~BillboardParticleRenderer();
@@ -148,6 +148,9 @@ namespace Ogre {
         /// Flag indicating whether the billboards has to be sorted
         bool mSortingEnabled;
 
+        /// Flag indicating whether sorting starts from the order of the last frame
+        bool mSortingCoherent;
+
         /// Use 'true' billboard to cam position facing, rather than camera direcion
         bool mAccurateFacing;
 
@@ -213,7 +216,10 @@ namespace Ogre {
         inline bool billboardVisible(Camera* cam, const Billboard& bill);
 
         /// Number of visible billboards (will be == getNumBillboards if mCullIndividual == false)
-        unsigned short mNumVisibleBillboards;
+        size_t mNumVisibleBillboards;
+
+        /// Sort keys of the last coherent sort
+        std::vector<float> mSortKeys;
 
         /// Internal method for increasing pool size
         void increasePool(size_t size);
@@ -229,7 +235,7 @@ namespace Ogre {
 
             Optional parameter pBill is only present for type BBT_ORIENTED_SELF and BBT_PERPENDICULAR_SELF
         */
-        void genBillboardAxes(Vector3* pX, Vector3 *pY, const Billboard* pBill = 0);
+        void genBillboardAxes(Vector3* pX, Vector3 *pY, const Billboard* pBill = 0) const;
 
         /** Internal method, generates parametric offsets based on origin.
         */
@@ -238,10 +244,24 @@ namespace Ogre {
         /** Internal method for generating vertex data. 
         @param offsets Array of 4 Vector3 offsets
         @param pBillboard Reference to billboard
+        @param pDest Vertex data to write, advanced past the written vertices
+        */
+        void genQuadVertices(const Vector3* const offsets, const Billboard& pBillboard, float*& pDest) const;
+
+        void genPointVertices(const Billboard& pBillboard, float*& pDest) const;
+
+        /** Internal method generating the vertices of a visible billboard.
+
+            Only reads the state set up by beginBillboards, so disjoint ranges of
+            billboards can be generated concurrently.
         */
-        void genQuadVertices(const Vector3* const offsets, const Billboard& pBillboard);
+        void genVertices(const Billboard& bb, float*& pDest) const;
 
-        void genPointVertices(const Billboard& pBillboard);
+        /// Implementation of injectBillboards, for billboards or pointers to them
+        template <typename T> void injectBillboardsImpl(const T* billboards, size_t count);
+
+        /// Sorts by the given functor, starting from the order of the last frame if coherent
+        template <typename F> void sortBillboards(const F& func);
 
         /** Internal method generates vertex offsets.
 
@@ -390,6 +410,20 @@ namespace Ogre {
         */
         bool getSortingEnabled(void) const { return mSortingEnabled; }
 
+        /** Makes sorting start from the order of the last frame. (default: off)
+
+            When the camera and the billboards only move a little between frames, the
+            previous order is nearly sorted and an insertion sort finishes in about linear time.
+            If the order changed too much, this falls back to the radix sort.
+        */
+        void setSortingCoherent(bool coherent) { mSortingCoherent = coherent; }
+
+        /** Returns true if sorting starts from the order of the last frame
+        @see
+            BillboardSet::setSortingCoherent
+        */
+        bool getSortingCoherent(void) const { return mSortingCoherent; }
+
         /** Adjusts the size of the pool of billboards available in this set.
 
             See the BillboardSet::setAutoextend method for full details of the billboard pool. This method adjusts
@@ -517,6 +551,12 @@ namespace Ogre {
         void beginBillboards(size_t numBillboards = 0);
         /** Define a billboard. */
         void injectBillboard(const Billboard& bb);
+        /** Define several billboards at once.
+
+            Large batches are generated in parallel on the WorkQueue, writing directly
+            into the locked vertex buffer, unless billboards are culled individually.
+        */
+        void injectBillboards(const Billboard* billboards, size_t count);
         /** Finish defining billboards. */
         void endBillboards(void);
         /** Set the bounds of the BillboardSet.
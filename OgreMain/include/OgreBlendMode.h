@@ -303,6 +303,15 @@ namespace Ogre {
             return !(sourceFactor == SBF_ONE && destFactor == SBF_ZERO &&
                      sourceFactorAlpha == SBF_ONE && destFactorAlpha == SBF_ZERO);
         }
+
+        bool operator==(const ColourBlendState& rhs) const
+        {
+            return writeR == rhs.writeR && writeG == rhs.writeG && writeB == rhs.writeB &&
+                   writeA == rhs.writeA && sourceFactor == rhs.sourceFactor && destFactor == rhs.destFactor &&
+                   sourceFactorAlpha == rhs.sourceFactorAlpha && destFactorAlpha == rhs.destFactorAlpha &&
+                   operation == rhs.operation && alphaOperation == rhs.alphaOperation;
+        }
+        bool operator!=(const ColourBlendState& rhs) const { return !(*this == rhs); }
     };
     /** @} */
     /** @} */
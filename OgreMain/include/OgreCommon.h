@@ -357,6 +357,11 @@ namespace Ogre {
         /** All techniques are forced to one weight per vertex. */
         IM_FORCEONEWEIGHT = 0x0020,
 
+        /** Sample all skeleton animations once into a vertex texture shared by every instance.
+        Per frame only the pose index and world transform of each instance are updated.
+        @see InstanceManager::setBakedAnimationRate */
+        IM_VTFBAKEDANIMATION = 0x0040,
+
         IM_USEALL       = IM_USE16BIT|IM_VTFBESTFIT|IM_USEONEWEIGHT
     };
     
@@ -137,6 +137,10 @@ namespace Ogre {
         SharedPtr< ControllerFunction<T> > mFunc;
         /// Controller is enabled or not
         bool mEnabled;
+        /// Controller must be updated on the main thread
+        bool mUpdateOnMainThread;
+        /// Controllers of the same group are not updated concurrently, NULL for the destination
+        const void* mUpdateGroup;
 
 
     public:
@@ -151,6 +155,8 @@ namespace Ogre {
             : mSource(src), mDest(dest), mFunc(func)
         {
             mEnabled = true;
+            mUpdateOnMainThread = false;
+            mUpdateGroup = NULL;
         }
 
         /** Default d-tor.
@@ -192,6 +198,39 @@ namespace Ogre {
             mEnabled = enabled;
         }
 
+        /** Sets whether this controller must be updated on the main thread.
+
+            With ControllerManager::setParallelUpdates enabled, controllers fed by the frame time
+            are updated concurrently. Set this if the destination value touches state shared
+            with other controllers or objects, that is not safe to modify from a worker thread.
+        */
+        void setUpdateOnMainThread(bool mainThread)
+        {
+            mUpdateOnMainThread = mainThread;
+        }
+        /// Returns true if this controller must be updated on the main thread
+        bool getUpdateOnMainThread(void) const
+        {
+            return mUpdateOnMainThread;
+        }
+
+        /** Sets the group of this controller for parallel updates.
+
+            Controllers of the same group are updated one after another on the same thread, in
+            the order they were created. By default the group is the destination value, so
+            controllers writing the same value never run concurrently. Set the object the
+            destination modifies, if several destination values share it.
+        */
+        void setUpdateGroup(const void* group)
+        {
+            mUpdateGroup = group;
+        }
+        /// Gets the group of this controller for parallel updates
+        const void* getUpdateGroup(void) const
+        {
+            return mUpdateGroup ? mUpdateGroup : mDest.get();
+        }
+
         /** Sets the function object to be used by this controller.
         */
         void setFunction(const SharedPtr< ControllerFunction<T> >& func)
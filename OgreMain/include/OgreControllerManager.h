@@ -68,6 +68,25 @@ namespace Ogre {
         /// Last frame number updated
         unsigned long mLastFrameNumber;
 
+        struct GroupedController
+        {
+            const void* group;
+            size_t order;
+            ControllerFloat* controller;
+            bool operator<(const GroupedController& rhs) const
+            {
+                return group != rhs.group ? std::less<const void*>()(group, rhs.group) : order < rhs.order;
+            }
+        };
+        /// Controllers updated this frame, kept around to avoid per frame allocations
+        ControllerList mSerialControllers;
+        std::vector<GroupedController> mParallelControllers;
+        /// First controller of each parallel batch, followed by the end
+        std::vector<size_t> mParallelBatches;
+        bool mParallelUpdates;
+
+        void updateParallel(void);
+
     public:
         ControllerManager();
         ~ControllerManager();
@@ -89,6 +108,22 @@ namespace Ogre {
         */
         void updateAllControllers(void);
 
+        /** Enables updating the controllers in parallel on the WorkQueue.
+
+            Controllers fed by the frame time source do not depend on each other, so they are
+            updated concurrently in batches. Controllers of the same Controller::setUpdateGroup
+            always end up in the same batch. The controllers created here are grouped by the
+            Pass, TextureUnitState or GpuProgramParameters they modify.
+            Controllers with other sources, and the ones flagged with
+            Controller::setUpdateOnMainThread, are updated afterwards on the calling thread.
+            Controllers sharing a function with state must be flagged or grouped as well.
+        */
+        void setParallelUpdates(bool enabled) { mParallelUpdates = enabled; }
+        /// Gets whether the controllers are updated in parallel
+        bool getParallelUpdates(void) const { return mParallelUpdates; }
+        /// Gets the number of controllers updated on the WorkQueue by the last update
+        size_t getNumParallelControllers(void) const { return mParallelControllers.size(); }
+
 
         /** Returns a ControllerValue which provides the time since the last frame as a control value source.
 
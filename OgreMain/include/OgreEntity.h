@@ -724,6 +724,21 @@ namespace Ogre {
         */
         void _updateAnimation(void);
 
+        /** Whether the skeleton pose of this entity is out of date and can be evaluated by
+            _updateSkeleton on a worker thread.
+
+            Prepares the animations involved for concurrent sampling. Entities with objects
+            attached to bones are not eligible, as their tag points notify the scene graph.
+            Entities sharing a skeleton instance evaluate it once, so call _updateSkeleton
+            for only one of them.
+        */
+        bool _prepareSkeletonUpdate(void);
+
+        /** Evaluates the skeleton pose for the current frame, leaving the rest of the
+            animation update to _updateAnimation.
+        */
+        void _updateSkeleton(void) { cacheBoneMatrices(); }
+
         /** Tests if any animation applied to this entity.
 
             An entity is animated if any animation state is enabled, or any manual bone
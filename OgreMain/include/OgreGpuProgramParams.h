@@ -421,6 +421,10 @@ namespace Ogre {
 
         bool mDirty;
 
+        /// Byte range of mConstants modified since the last _markClean
+        size_t mDirtyBegin;
+        size_t mDirtyEnd;
+
         template <typename T> void _setNamedConstant(const String& name, const T* val, uint32 count);
     public:
         GpuSharedParameters(const String& name);
@@ -530,8 +534,12 @@ namespace Ogre {
         void _setHardwareBuffer(const HardwareBufferPtr& data) { mHardwareBuffer = data; }
         /** Internal method that the RenderSystem might use to store optional data. */
         const HardwareBufferPtr& _getHardwareBuffer() const { return mHardwareBuffer; }
-        /// upload parameter data to GPU memory. Must have a HardwareBuffer
-        void _upload() const;
+        /** upload parameter data to GPU memory. Must have a HardwareBuffer
+
+            Only the bytes modified since the last _markClean are written, unless partialUpload is false.
+        @return the number of bytes written
+        */
+        size_t _upload(bool partialUpload = true) const;
         /// download data from GPU memory. Must have a writable HardwareBuffer
         void download();
     };
@@ -1220,6 +1228,9 @@ namespace Ogre {
 
         typedef std::vector<GpuSharedParametersUsage> GpuSharedParamUsageList;
     private:
+        // writes copied shared values directly and marks just their range dirty
+        friend class GpuSharedParametersUsage;
+
         static AutoConstantDefinition AutoConstantDictionary[];
 
         /// Packed list of constants (physical indexing)
@@ -1243,6 +1254,22 @@ namespace Ogre {
         AutoConstantList mAutoConstants;
         /// The combined variability masks of all parameters
         uint16 mCombinedVariability;
+        /// Byte range of mConstants written since the last _markClean
+        size_t mDirtyBegin;
+        size_t mDirtyEnd;
+        /** Indices into mAutoConstants sorted by variability, so that _updateAutoParams only
+            visits the entries matching the mask. Rebuilt on demand when the autos change. */
+        std::vector<uint32> mAutoConstantPlan;
+        /// Variability and end position in mAutoConstantPlan of each group
+        std::vector<std::pair<uint16, uint32> > mAutoConstantGroups;
+        bool mAutoConstantPlanDirty;
+        void buildAutoConstantPlan();
+        /// extend the dirty range to include the given bytes
+        void _markDirty(size_t physicalIndex, size_t bytes)
+        {
+            mDirtyBegin = std::min(mDirtyBegin, physicalIndex);
+            mDirtyEnd = std::max(mDirtyEnd, physicalIndex + bytes);
+        }
         /// Do we need to transpose matrices?
         bool mTransposeMatrices;
         /// flag to indicate if names not found will be ignored
@@ -1400,6 +1427,7 @@ namespace Ogre {
         {
             assert(physicalIndex + sizeof(T) * count <= mConstants.size());
             memcpy(&mConstants[physicalIndex], val, sizeof(T) * count);
+            _markDirty(physicalIndex, sizeof(T) * count);
         }
         /// @overload
         void _writeRawConstants(size_t physicalIndex, const double* val, size_t count);
@@ -1496,19 +1524,19 @@ namespace Ogre {
         /// Get a reference to the list of constants
         const ConstantList& getConstantList() const { return mConstants; }
         /// Get a pointer to the 'nth' item in the float buffer
-        float* getFloatPointer(size_t pos) { return (float*)&mConstants[pos]; }
+        float* getFloatPointer(size_t pos) { _markDirty(); return (float*)&mConstants[pos]; }
         /// Get a pointer to the 'nth' item in the float buffer
         const float* getFloatPointer(size_t pos) const { return (const float*)&mConstants[pos]; }
         /// Get a pointer to the 'nth' item in the double buffer
-        double* getDoublePointer(size_t pos) { return (double*)&mConstants[pos]; }
+        double* getDoublePointer(size_t pos) { _markDirty(); return (double*)&mConstants[pos]; }
         /// Get a pointer to the 'nth' item in the double buffer
         const double* getDoublePointer(size_t pos) const { return (const double*)&mConstants[pos]; }
         /// Get a pointer to the 'nth' item in the int buffer
-        int* getIntPointer(size_t pos) { return (int*)&mConstants[pos]; }
+        int* getIntPointer(size_t pos) { _markDirty(); return (int*)&mConstants[pos]; }
         /// Get a pointer to the 'nth' item in the int buffer
         const int* getIntPointer(size_t pos) const { return (const int*)&mConstants[pos]; }
         /// Get a pointer to the 'nth' item in the uint buffer
-        uint* getUnsignedIntPointer(size_t pos) { return (uint*)&mConstants[pos]; }
+        uint* getUnsignedIntPointer(size_t pos) { _markDirty(); return (uint*)&mConstants[pos]; }
         /// Get a pointer to the 'nth' item in the uint buffer
         const uint* getUnsignedIntPointer(size_t pos) const { return (const uint*)&mConstants[pos]; }
 
@@ -1825,8 +1853,32 @@ namespace Ogre {
         /** Update the HardwareBuffer based backing of referenced shared parameters
          *
          * falls back to _copySharedParams() if a shared parameter is not hardware backed
+         * @param partialUpload see GpuSharedParameters::_upload
+         * @return the number of bytes written to the shared parameter buffers
          */
-        void _updateSharedParams();
+        size_t _updateSharedParams(bool partialUpload = true);
+
+        /** Byte range [first, second) of the constant buffer written since the last _markClean
+
+            The range is empty (first >= second) if nothing changed. Render systems use this to
+            upload only the modified part of the constants.
+        */
+        std::pair<size_t, size_t> _getDirtyRange() const
+        {
+            return std::make_pair(mDirtyBegin, std::min(mDirtyEnd, mConstants.size()));
+        }
+        /// Mark the whole constant buffer as modified
+        void _markDirty()
+        {
+            mDirtyBegin = 0;
+            mDirtyEnd = std::numeric_limits<size_t>::max();
+        }
+        /// Reset the dirty range, after the render system uploaded the constants
+        void _markClean()
+        {
+            mDirtyBegin = std::numeric_limits<size_t>::max();
+            mDirtyEnd = 0;
+        }
         /// @}
 
         size_t calculateSize(void) const;
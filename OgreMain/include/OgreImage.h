@@ -426,7 +426,11 @@ namespace Ogre {
         {
             FILTER_NEAREST,
             FILTER_LINEAR,
-            FILTER_BILINEAR = FILTER_LINEAR
+            FILTER_BILINEAR = FILTER_LINEAR,
+            /// average of the covered source pixels. Only used by generateMipmaps, scale treats it as bilinear
+            FILTER_BOX,
+            /// Kaiser windowed sinc, sharper than box. Only used by generateMipmaps, scale treats it as bilinear
+            FILTER_KAISER
         };
         /** Scale a 1D, 2D or 3D image volume. 
             @param  src         PixelBox containing the source pointer, dimensions and format
@@ -439,6 +443,17 @@ namespace Ogre {
         
         /** Resize a 2D image, applying the appropriate filter. */
         void resize(ushort width, ushort height, Filter filter = FILTER_BILINEAR);
+
+        /** Fill the mipmaps of the image from its top level
+
+            Each level is filtered from the one above it, which is kept in floating point, so there is no
+            quantisation between levels. Faces and slices are processed in parallel on the WorkQueue if
+            there is a Root. If the image has no mipmaps yet, a full chain is allocated first.
+            @param gammaCorrected filter in linear space, for colour data stored as sRGB
+            @param filter #FILTER_BOX, #FILTER_KAISER or #FILTER_NEAREST
+            @note compressed formats are not supported
+        */
+        Image& generateMipmaps(bool gammaCorrected = false, Filter filter = FILTER_BOX);
         
         /// Static function to calculate size in bytes from the number of mipmaps, faces and the dimensions
         static size_t calculateSize(uint32 mipmaps, uint32 faces, uint32 width, uint32 height, uint32 depth, PixelFormat format);
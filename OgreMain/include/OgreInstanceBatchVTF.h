@@ -96,6 +96,33 @@ namespace Ogre
         bool mForceOneWeight;
         bool mUseOneWeight;
 
+        /// Location of one skeleton animation inside the baked animation texture
+        struct BakedClip
+        {
+            size_t firstPose;
+            size_t numPoses;
+        };
+        typedef std::map<String, BakedClip> BakedClipMap;
+
+        // The state of the usage of baked animation
+        bool mUseBakedAnimation;
+        Real mBakedAnimationRate;
+        BakedClipMap mBakedClips;
+        size_t mNumBakedPoses;
+
+        /** Lays out the skeleton animations in the baked animation texture.
+            Pose 0 is the binding pose, followed by every animation sampled at mBakedAnimationRate
+        */
+        void planBakedAnimation();
+
+        /** Samples all animations of the skeleton into the (already created) vertex texture */
+        void bakeAnimationTexture();
+
+        /** @return the pose in the baked animation texture that best matches the given animations
+            (nearest frame of the enabled state with the highest weight)
+        */
+        size_t getBakedPoseIndex( const AnimationStateSet *animationStates ) const;
+
         /** Clones the base material so it can have it's own vertex texture, and also
             clones it's shadow caster materials, if it has any
         */
@@ -172,6 +199,28 @@ namespace Ogre
         */
         bool useBoneMatrixLookup() const { return mUseBoneMatrixLookup; }
 
+        /** Sets the state of the usage of baked animation
+
+        When turned on every animation of the skeleton is sampled once, at the given rate, into a
+        vertex texture which is shared by all batches of the InstanceManager. Instanced entities
+        then only carry the position of their current pose in that texture plus their world
+        transform (same per instance layout as the bone matrix lookup), so no bone matrices are
+        evaluated nor uploaded per frame. The pose is taken from the enabled animation state with
+        the highest weight, snapped to the nearest sampled frame; blending, manually controlled
+        bones and animations of linked skeletons are not supported.
+
+        Note this feature only works in VTF_HW for now, with the same vertex program as the bone
+        matrix lookup.
+        This value needs to be set before adding any instanced entities
+        */
+        void setBakedAnimation(bool enable, Real samplesPerSecond) { assert(mInstancedEntities.empty());
+            mUseBakedAnimation = enable; mBakedAnimationRate = samplesPerSecond; }
+
+        /** Tells whether to use baked animation
+        @see setBakedAnimation()
+        */
+        bool useBakedAnimation() const { return mUseBakedAnimation; }
+
         void setBoneDualQuaternions(bool enable) { assert(mInstancedEntities.empty());
             mUseBoneDualQuaternions = enable; mRowLength = (mUseBoneDualQuaternions ? 2 : 3); }
 
@@ -188,7 +237,7 @@ namespace Ogre
         bool useOneWeight() const { return mUseOneWeight; }
 
         /** @see InstanceBatch::useBoneWorldMatrices()  */
-        bool useBoneWorldMatrices() const override { return !mUseBoneMatrixLookup; }
+        bool useBoneWorldMatrices() const override { return !mUseBoneMatrixLookup && !mUseBakedAnimation; }
 
         /** @return the maximum amount of shared transform entities when using lookup table*/
         virtual size_t getMaxLookupTableInstances() const { return mMaxLookupTableInstances; }
@@ -114,6 +114,7 @@ namespace Ogre
         SceneManager*           mSceneManager;
 
         size_t                  mMaxLookupTableInstances;
+        Real                    mBakedAnimationRate;
         unsigned char           mNumCustomParams;       //Number of custom params per instance.
 
         /** Finds a batch with at least one free instanced entity we can use.
@@ -176,6 +177,16 @@ namespace Ogre
         */
         void setMaxLookupTableInstances( size_t maxLookupTableInstances );
 
+        /** Sets the sampling rate of the animations when using IM_VTFBAKEDANIMATION.
+            Raises an exception if trying to change it after creating the first InstancedEntity.
+            Every animation takes length * samplesPerSecond + 1 poses in the baked texture, the
+            instances snap to the nearest one.
+        @param samplesPerSecond Number of poses sampled per second of animation. Default: 30
+        */
+        void setBakedAnimationRate( Real samplesPerSecond );
+
+        Real getBakedAnimationRate() const { return mBakedAnimationRate; }
+
         /** Sets the number of custom parameters per instance. Some techniques (i.e. HWInstancingBasic)
             support this, but not all of them. They also may have limitations to the max number. All
             instancing implementations assume each instance param is a Vector4 (4 floats).
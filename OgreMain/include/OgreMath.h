@@ -471,7 +471,7 @@ namespace Ogre
             @return
                 A random number in the range from [0,1].
         */
-        static float UnitRandom() { return mRandProvider ? mRandProvider->getRandomUnit() : rand() / float(RAND_MAX); }
+        static float UnitRandom();
 
         /** Generate a random number within the range provided.
             @param fLow
@@ -490,6 +490,13 @@ namespace Ogre
         static float SymmetricRandom() { return 2.0f * UnitRandom() - 1.0f; }
 
         static void SetRandomValueProvider(RandomValueProvider* provider);
+
+        /** Overrides the random value provider for the calling thread only.
+
+            This takes precedence over the provider set with SetRandomValueProvider and allows jobs running
+            on worker threads to draw from their own deterministic sequence. Pass NULL to remove the override.
+        */
+        static void _setThreadRandomValueProvider(RandomValueProvider* provider);
        
         /** Tangent function.
             @param fValue
@@ -110,6 +110,15 @@ namespace Ogre {
         */
         virtual void _affectParticles(ParticleSystem* pSystem, Real timeElapsed) = 0;
 
+        /** Method called on the main thread before the particle system is updated.
+
+            With ParticleSystemManager::setParallelUpdates enabled, _initParticle and _affectParticles may
+            run on a worker thread. Affectors that need to load resources should do so here.
+        @param
+            pSystem Pointer to the ParticleSystem about to be updated.
+        */
+        virtual void _prepare(ParticleSystem* pSystem) {}
+
         /** Returns the name of the type of affector. 
 
             This property is useful for determining the type of affector procedurally so another
@@ -266,6 +266,31 @@ namespace Ogre {
         */
         void _update(Real timeElapsed);
 
+        /** First stage of a split update, must be called on the main thread.
+
+            Handles the nonvisible timeout, configures the renderer and lets the affectors
+            prepare, so that _simulate only touches state owned by this system.
+        @return false if the system should not be updated this frame
+        */
+        bool _prepareUpdate(Real timeElapsed);
+
+        /** Second stage of a split update: expires, emits and affects particles and updates the bounds.
+
+            Independent systems may be simulated concurrently. Random values are drawn from the
+            sequence owned by this system (see setRandomSeed), so the result does not depend on
+            which thread runs it.
+        */
+        void _simulate(Real timeElapsed);
+
+        /** Last stage of a split update, must be called on the main thread. */
+        void _finishUpdate(void);
+
+        /** Seeds the random sequence used by _simulate.
+
+            Defaults to a hash of the system name, so systems with the same name and setup evolve identically.
+        */
+        void setRandomSeed(uint32 seed) { mRandomState = seed ? seed : 0x9E3779B9; }
+
         /** Returns all active particles in this system.
 
             This method is designed to be used by people providing new ParticleAffector subclasses,
@@ -623,6 +648,13 @@ namespace Ogre {
         */
         ParticlePool mParticlePool;
 
+        /** Storage of the particles in the pool.
+
+                Each pool increase allocates one contiguous block, so the affectors and the renderer walk
+                through adjacent memory instead of individually allocated particles.
+        */
+        std::vector<std::unique_ptr<Particle[]>> mParticleBlocks;
+
         typedef std::list<ParticleEmitter*> FreeEmittedEmitterList;
         typedef std::list<ParticleEmitter*> ActiveEmittedEmitterList;
         typedef std::vector<ParticleEmitter*> EmittedEmitterList;
@@ -675,6 +707,16 @@ namespace Ogre {
         /// The number of emitted emitters in the pool.
         size_t mEmittedEmitterPoolSize;
 
+        /// State of the random sequence used by _simulate
+        uint32 mRandomState;
+
+        /// Whether the last simulation changed the bounds, the parent node is notified in _finishUpdate
+        bool mBoundsChanged;
+
+        /// Scratch space for _triggerEmitters
+        std::vector<unsigned> mEmitRequested;
+        std::vector<unsigned> mEmittedEmitRequested;
+
         /// Optional origin of this particle system (eg script name)
         String mOrigin;
 
@@ -683,6 +725,14 @@ namespace Ogre {
         /// Default nonvisible update timeout
         static Real msDefaultNonvisibleTimeout;
 
+        /** Simulation shared by _update and _simulate. */
+        void simulate(Real timeElapsed);
+
+        /** Recalculates the bounds without notifying the parent node.
+        @return true if the bounds were recalculated
+        */
+        bool calculateBounds(void);
+
         /** Internal method used to expire dead particles. */
         void _expire(Real timeElapsed);
 
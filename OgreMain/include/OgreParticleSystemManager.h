@@ -96,6 +96,10 @@ namespace Ogre {
         // Factory instance
         ParticleSystemFactory* mFactory;
 
+        /// Systems waiting for _updateQueuedSystems and their elapsed time
+        std::vector<std::pair<ParticleSystem*, Real>> mQueuedUpdates;
+        bool mParallelUpdates;
+
         /// Internal implementation of createSystem
         ParticleSystem* createSystemImpl(const String& name, size_t quota, 
             const String& resourceGroup);
@@ -313,6 +317,25 @@ namespace Ogre {
                 mSystemTemplates.begin(), mSystemTemplates.end());
         } 
 
+        /** Enables updating the particle systems in parallel on the WorkQueue.
+
+            Instead of updating each system from its frame time controller, the systems are queued
+            and simulated concurrently by _updateQueuedSystems, while the setup and the render queue
+            fill stay on the main thread. Each system then draws from its own random sequence
+            (see ParticleSystem::setRandomSeed), so results do not depend on the scheduling.
+            All emitters and affectors in use must be safe to run concurrently on different systems.
+        */
+        void setParallelUpdates(bool enabled) { mParallelUpdates = enabled; }
+        /** Gets whether particle systems are updated in parallel. */
+        bool getParallelUpdates(void) const { return mParallelUpdates; }
+
+        /** Queues a system for _updateQueuedSystems (internal use). */
+        void _queueUpdate(ParticleSystem* system, Real timeElapsed);
+        /** Removes a system from the update queue (internal use). */
+        void _cancelUpdate(ParticleSystem* system);
+        /** Updates all queued systems, called by SceneManager after the controllers were updated. */
+        void _updateQueuedSystems(void);
+
         /** Get an instance of ParticleSystemFactory (internal use). */
         ParticleSystemFactory* _getFactory(void) { return mFactory; }
         
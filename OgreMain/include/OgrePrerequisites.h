@@ -102,6 +102,7 @@ namespace Ogre {
     class Camera;
     class Codec;
     class ColourValue;
+    struct CompressedTransformKeys;
     class ConfigDialog;
     template <typename T> class Controller;
     typedef Controller<float> ControllerFloat;
@@ -77,6 +77,17 @@ namespace Ogre {
         RENDER_QUEUE_COUNT
     };
 
+    /// Counters of a render queue group, see SceneManager::setRenderStatsEnabled
+    struct RenderQueueGroupStats
+    {
+        /// Movable objects in the scene that were queued / rejected by the visibility tests
+        uint32 objectsVisible;
+        uint32 objectsCulled;
+        /// Renderables added to the group / submitted to the RenderSystem
+        uint32 renderablesQueued;
+        uint32 renderablesRendered;
+    };
+
     /// @deprecated
     #define OGRE_RENDERABLE_DEFAULT_PRIORITY  Ogre::Renderable::DEFAULT_PRIORITY
 
@@ -140,8 +151,10 @@ namespace Ogre {
         bool mSplitPassesByLightingType;
         bool mSplitNoShadowPasses;
         bool mShadowCastersCannotBeReceivers;
+        bool mPersistent;
 
         RenderableListener* mRenderableListener;
+        RenderQueueGroupStats* mGroupStats;
     public:
         RenderQueue();
         virtual ~RenderQueue();
@@ -275,6 +288,23 @@ namespace Ogre {
         */
         bool getShadowCastersCannotBeReceivers(void) const;
 
+        /** Sets whether the queue keeps its contents across clear calls.
+
+            By default clear() empties the queue and every frame is grouped and sorted from
+            scratch. A persistent queue remembers which renderable was queued with which pass
+            and, when sorting, only drops the ones that were not queued again and merges in the
+            new ones, so the sorting cost follows the changes in the visible set rather than its
+            size. Mostly static scenes seen by one camera benefit most; rendering the same queue
+            from several cameras per frame, e.g. for texture shadows, rebuilds it each time.
+
+            Transparent renderables are still sorted by depth every frame, while the front to back
+            order inside pass groups is only computed when an entry is added. Changes to pass
+            hashes or destroyed passes reset the queue.
+        */
+        void setPersistent(bool persistent) { mPersistent = persistent; }
+        /// @copydoc setPersistent
+        bool getPersistent(void) const { return mPersistent; }
+
         /** Set a renderable listener on the queue.
 
             There can only be a single renderable listener on the queue, since
@@ -286,6 +316,11 @@ namespace Ogre {
         RenderableListener* getRenderableListener(void) const
         { return mRenderableListener; }
 
+        /** Internal method, sets the counters of the queued objects and renderables.
+        @param stats array of RENDER_QUEUE_COUNT entries indexed by queue group or NULL to disable
+        */
+        void _setGroupStats(RenderQueueGroupStats* stats) { mGroupStats = stats; }
+
         /** Merge render queue.
         */
         void merge( const RenderQueue* rhs );
@@ -54,8 +54,10 @@ namespace Ogre {
         Renderable* renderable;
         /// Pointer to the Pass
         Pass* pass;
+        /// Key the collection is ordered by, filled in by QueuedRenderableCollection::sort
+        uint64 sortKey;
 
-        RenderablePass(Renderable* rend, Pass* p) :renderable(rend), pass(p) {}
+        RenderablePass(Renderable* rend, Pass* p, uint64 key = 0) : renderable(rend), pass(p), sortKey(key) {}
     };
 
 
@@ -122,40 +124,78 @@ namespace Ogre {
         };
 
     private:
-        /// Comparator to order pass groups
-        struct PassGroupLess
-        {
-            bool operator()(const Pass* a, const Pass* b) const
-            {
-                // Sort by passHash, which is pass, then texture unit changes
-                uint32 hasha = a->getHash();
-                uint32 hashb = b->getHash();
-                if (hasha == hashb)
-                {
-                    // Must differentTransparentQueueItemLessiate by pointer in case 2 passes end up with the same hash
-                    return a < b;
-                }
-                else
-                {
-                    return hasha < hashb;
-                }
-            }
-        };
         /** Vector of RenderablePass objects, this is built on the assumption that
          vectors only ever increase in size, so even if we do clear() the memory stays
          allocated, ie fast */
         typedef std::vector<RenderablePass> RenderablePassList;
-        /** Map of pass to renderable lists, this is a grouping by pass. */
-        typedef std::map<Pass*, RenderableList, PassGroupLess> PassGroupRenderableMap;
+        /** Runs of renderables sharing a pass, this is a grouping by pass.
+         Like RenderablePassList, entries are reused across frames. */
+        typedef std::vector<std::pair<Pass*, RenderableList> > PassGroupList;
 
         /// Bitmask of the organisation modes requested
         uint8 mOrganisationMode;
 
-        /// Grouped 
-        PassGroupRenderableMap mGrouped;
+        /// Grouped, ordered by pass hash then front to back
+        RenderablePassList mGrouped;
+        /// Pass runs of mGrouped handed to the visitor
+        PassGroupList mPassGroups;
+        /// Number of valid entries in mPassGroups
+        size_t mNumPassGroups;
+        /// mPassGroups needs rebuilding
+        bool mPassGroupsDirty;
         /// Sorted descending (can iterate backwards to get ascending)
         RenderablePassList mSortedDescending;
 
+        struct RenderablePassHash
+        {
+            size_t operator()(const std::pair<Renderable*, Pass*>& k) const
+            {
+                return std::hash<void*>()(k.first) ^ (std::hash<void*>()(k.second) << 1);
+            }
+        };
+        /// Tracking data of a mGrouped entry while updating incrementally
+        struct GroupedSlot
+        {
+            Renderable* renderable;
+            Pass* pass;
+            /// update count the entry was last queued in
+            uint32 frame;
+        };
+        /// mGrouped is updated incrementally, see _beginIncrementalUpdate
+        bool mIncremental;
+        uint32 mFrame;
+        /// Slot of each mGrouped entry
+        std::vector<uint32> mGroupedSlot;
+        std::vector<GroupedSlot> mSlots;
+        std::vector<uint32> mFreeSlots;
+        /// Slot of each renderable / pass combination, queued duplicates are not indexed
+        std::unordered_map<std::pair<Renderable*, Pass*>, uint32, RenderablePassHash> mSlotIndex;
+        /// Slots in queuing order of this and the last update, usually the same sequence
+        std::vector<uint32> mQueuedSlots;
+        std::vector<uint32> mLastQueuedSlots;
+        /// Entries of mGrouped queued since _beginIncrementalUpdate, and how many of them are new
+        size_t mNumQueued;
+        size_t mNumAdded;
+        /// Index of each grouped pass among the passes with the same hash, splits their groups
+        std::unordered_map<const Pass*, uint32> mPassOrdinals;
+        /// Number of ordinals handed out per pass hash
+        std::unordered_map<uint32, uint32> mHashPassCounts;
+        /// Scratch space of updateGrouped
+        std::vector<std::pair<uint64, uint32> > mAddedOrder;
+        RenderablePassList mMergedGrouped;
+        std::vector<uint32> mMergedSlot;
+
+        /// compute the sort keys of mGrouped, order it and rebuild mPassGroups
+        void sortGrouped(const Camera* cam);
+        /// compute the sort keys of the mGrouped entries starting at first
+        void computeGroupedKeys(size_t first, const Camera* cam);
+        /// merge the entries added since _beginIncrementalUpdate into mGrouped and drop the stale ones
+        void updateGrouped(const Camera* cam);
+        /// find the slot of a renderable queued incrementally, returns whether it is new
+        bool queueIncremental(Pass* pass, Renderable* rend);
+        void releaseSlot(uint32 slot);
+        void buildPassGroups();
+
         /// Internal visitor implementation
         void acceptVisitorGrouped(QueuedRenderableVisitor* visitor) const;
         /// Internal visitor implementation
@@ -196,15 +236,33 @@ namespace Ogre {
             mOrganisationMode |= uint8(om);
         }
 
+        /** Start queuing the renderables of a new frame, keeping the previous contents.
+
+            Renderables queued again with the same pass keep their place in the grouped
+            organisation, ones not queued again are dropped by the next sort(), so it only
+            has to order the difference and does nothing if the set did not change. The
+            depth order inside a pass group is not refreshed for entries that stay.
+            The depth sorted organisation is always rebuilt.
+        */
+        void _beginIncrementalUpdate(void);
+
         /// Add a renderable to the collection using a given pass
         void addRenderable(Pass* pass, Renderable* rend);
         
         /** Perform any sorting that is required on this collection.
+
+            Every entry gets a 64 bit key, which is radix sorted once. Grouped entries are keyed
+            by pass hash (pass index, then GPU programs or textures, see Pass::HashFunc), the index of
+            the pass among the queued passes with the same hash and then quantised camera distance, so
+            each pass group is drawn front to back. Depth sorted entries are keyed by distance and then
+            pass hash.
         @param cam The camera
         */
         void sort(const Camera* cam);
 
         /** Accept a visitor over the collection contents.
+
+            The pass groups are built by sort(), so call it after adding renderables.
         @param visitor Visitor class which should be called back
         @param om The organisation mode which you want to iterate over.
             Note that this must have been included in an addOrganisationMode
@@ -258,8 +316,6 @@ namespace Ogre {
         /// Transparent list
         QueuedRenderableCollection mTransparents;
 
-        /// remove a pass entry from all collections
-        void removePassEntry(Pass* p);
         /// Internal method for adding a solid renderable
         void addSolidRenderableSplitByLightType(Technique* pTech, Renderable* rend);
 
@@ -332,6 +388,9 @@ namespace Ogre {
         */
         void clear(void);
 
+        /// @copydoc QueuedRenderableCollection::_beginIncrementalUpdate
+        void _beginIncrementalUpdate(void);
+
         /** Sets whether or not the queue will split passes by their lighting type,
         ie ambient, per-light and decal. 
         */
@@ -467,6 +526,13 @@ namespace Ogre {
 
         }
 
+        /// @copydoc QueuedRenderableCollection::_beginIncrementalUpdate
+        void _beginIncrementalUpdate(void)
+        {
+            for (auto& pg : mPriorityGroups)
+                pg.second->_beginIncrementalUpdate();
+        }
+
         /** Indicate whether a given queue group will be doing any
         shadow setup.
 
@@ -723,6 +723,9 @@ namespace Ogre
         unsigned int _getBatchCount(void) const { return static_cast<unsigned int>(mBatchCount); }
         /** Reports the number of vertices passed to the renderer since the last _beginGeometryCount call. */
         unsigned int _getVertexCount(void) const { return static_cast<unsigned int>(mVertexCount); }
+        /** Reports the number of bytes of shader constants written to GPU buffers since the last
+            _beginGeometryCount call. */
+        size_t _getConstantBytesUploaded(void) const { return mConstantBytesUploaded; }
 
         /// @deprecated use ColourValue::getAsBYTE()
         OGRE_DEPRECATED static void convertColourValue(const ColourValue& colour, uint32* pDest)
@@ -1127,6 +1130,7 @@ namespace Ogre
         size_t mBatchCount;
         size_t mFaceCount;
         size_t mVertexCount;
+        size_t mConstantBytesUploaded;
 
         bool mInvertVertexWinding;
         bool mIsReverseDepthBufferEnabled;
@@ -1203,7 +1207,14 @@ namespace Ogre
         bool flipFrontFace() const;
         static CompareFunction reverseCompareFunction(CompareFunction func);
 
-        const HardwareBufferPtr& updateDefaultUniformBuffer(GpuProgramType type, const ConstantList& params);
+        /** upload the constants of params to the default uniform buffer of the given stage
+
+            If the same params were uploaded last time, only their dirty range is written. With
+            partialUpload = false the buffer is still rewritten as a whole, but uploads are skipped if
+            nothing changed. This is for APIs where writing a sub range without discarding stalls.
+        */
+        const HardwareBufferPtr& updateDefaultUniformBuffer(GpuProgramType type, GpuProgramParameters& params,
+                                                            bool partialUpload = true);
     private:
         StencilState mStencilState;
 
@@ -1213,6 +1224,8 @@ namespace Ogre
         VertexDeclaration* mGlobalInstanceVertexDeclaration;
         /// buffers for default uniform blocks
         HardwareBufferPtr mUniformBuffer[GPT_COUNT];
+        /// the parameters last uploaded to mUniformBuffer
+        const GpuProgramParameters* mUniformBufferParams[GPT_COUNT];
         /// the number of global instances (this number will be multiply by the render op instance number)
         uint32 mGlobalNumberOfInstances;
     };
@@ -302,6 +302,40 @@ namespace Ogre {
             Real skyBoxDistance;
         };
 
+        /** Statistics of the rendering done by a SceneManager in one frame.
+
+            Collected over all the _renderScene calls of the frame, including the ones for shadow
+            textures and other render targets. See setRenderStatsEnabled.
+        */
+        struct _OgreExport RenderStats
+        {
+            /// Root frame number the statistics belong to
+            unsigned long frameNumber;
+            /// Passes set up by _setPass, changes of the bound GPU programs, textures, samplers and blend state
+            size_t passChanges;
+            size_t programChanges;
+            size_t textureChanges;
+            size_t samplerChanges;
+            size_t blendChanges;
+            /// Shader constant bytes uploaded, see RenderSystem::_getConstantBytesUploaded
+            size_t constantBytesUploaded;
+            /// As counted by RenderSystem::_render
+            size_t batches;
+            size_t faces;
+            size_t vertices;
+            /// Microseconds spent updating the scene graph, finding the visible objects and rendering them
+            uint64 sceneGraphTime;
+            uint64 cullingTime;
+            uint64 renderTime;
+            /// Indexed by the render queue group id, counted per camera
+            RenderQueueGroupStats queueGroups[RENDER_QUEUE_COUNT];
+
+            RenderStats() { reset(); }
+            void reset();
+            /// The statistics as a JSON object, listing only the queue groups that were used
+            String toJSON() const;
+        };
+
         /** Class that allows listening in on the various stages of SceneManager
             processing, so that custom behaviour can be implemented from outside.
         */
@@ -547,6 +581,16 @@ namespace Ogre {
         uint8 mWorldGeometryRenderQueue;
         
         unsigned long mLastFrameNumber;
+        bool mRenderStatsEnabled;
+        RenderStats mRenderStats;
+        /// State last set up by _setPass, to count the actual changes
+        const Pass* mStatsPass;
+        const GpuProgram* mStatsPrograms[GPT_COUNT];
+        std::vector<const Texture*> mStatsTextures;
+        std::vector<const Sampler*> mStatsSamplers;
+        ColourBlendState mStatsBlendState;
+        /// Queue group being rendered, RENDER_QUEUE_COUNT if none
+        uint16 mStatsQueueGroup;
         bool mResetIdentityView;
         bool mResetIdentityProj;
 
@@ -729,6 +773,25 @@ namespace Ogre {
         OGRE_MUTEX(mAnimationsListMutex);
         AnimationStateSet mAnimationStates;
 
+        bool mParallelAnimationUpdate;
+        /// A scene node track sampled on a worker thread, then applied to its node
+        struct NodeTrackSample
+        {
+            NodeAnimationTrack* track;
+            TimeIndex timeIndex;
+            Real weight;
+            bool valid;
+            Vector3 translate;
+            Quaternion rotate;
+            Vector3 scale;
+        };
+        std::vector<NodeTrackSample> mNodeTrackSamples;
+        /// Entities whose skeleton is evaluated in the animation phase
+        std::vector<Entity*> mSkeletalEntities;
+
+        /// Parallel part of _applySceneAnimations
+        void applySceneAnimationsParallel(void);
+
         typedef std::vector<RenderQueueListener*> RenderQueueListenerList;
         RenderQueueListenerList mRenderQueueListeners;
 
@@ -1005,6 +1068,11 @@ namespace Ogre {
         /// Gpu params that need rebinding (mask of GpuParamVariability)
         uint16 mGpuParamsDirty;
 
+        /// reset the state tracking of the render statistics
+        void resetStatsState(void);
+        /// count the objects in the scene the last _findVisibleObjects did not queue
+        void countCulledObjects(const uint32* visibleBefore);
+
         /** Render a group in the ordinary way */
         void renderBasicQueueGroupObjects(RenderQueueGroup* pGroup,
             QueuedRenderableCollection::OrganisationMode om);
@@ -2198,6 +2266,27 @@ namespace Ogre {
         */
         void _applySceneAnimations(void);
 
+        /** Internal method for evaluating the skeletons of animated entities ahead of rendering.
+
+            Called once per frame when the parallel animation update is enabled, see
+            setParallelAnimationUpdate.
+        */
+        void _updateSkeletalAnimations(void);
+
+        /** Sets whether animations are evaluated in parallel on the WorkQueue.
+
+            When enabled, an animation phase runs once per frame before the scene graph update.
+            The node tracks of the scene animations are sampled in parallel and then applied in
+            order, and the skeletons of all visible entities whose animation changed are
+            evaluated in parallel, once per skeleton instance. Otherwise each entity evaluates
+            its skeleton when it is queued for rendering, which skips the ones out of view.
+        @note Numeric and vertex tracks, vertex animation and software skinning, as well as
+            entities with objects attached to bones, are still updated on the calling thread.
+        */
+        void setParallelAnimationUpdate(bool enabled) { mParallelAnimationUpdate = enabled; }
+        /// Gets whether animations are evaluated in parallel on the WorkQueue
+        bool getParallelAnimationUpdate(void) const { return mParallelAnimationUpdate; }
+
         /** Creates an animation which can be used to animate scene nodes.
 
             An animation is a collection of 'tracks' which over time change the position / orientation
@@ -3237,6 +3326,24 @@ namespace Ogre {
         */
         bool getFindVisibleObjects(void) { return mFindVisibleObjects; }
 
+        /** Sets whether per frame render statistics are collected, see RenderStats.
+
+            State changes are counted where the SceneManager sets up a pass, so state the
+            RenderSystem changes internally or skips because it is cached is not included.
+            Culled objects are the movable objects in the scene the visibility tests did not
+            queue, per camera. Objects of SceneManagers that do not use
+            RenderQueue::processVisibleObject are not counted as visible.
+        */
+        void setRenderStatsEnabled(bool enabled);
+        /// @copydoc setRenderStatsEnabled
+        bool getRenderStatsEnabled(void) const { return mRenderStatsEnabled; }
+        /** Gets the statistics of the current frame.
+
+            They are complete once the frame is rendered, e.g. after Root::renderOneFrame, and
+            are reset when the next frame starts rendering.
+        */
+        const RenderStats& getRenderStats(void) const { return mRenderStats; }
+
         /** Set whether to automatically flip the culling mode on objects whenever they
             are negatively scaled.
 
@@ -274,6 +274,28 @@ namespace Ogre {
         */
         virtual void _getBoneMatrices(Affine3* pMatrices);
 
+        /** Evaluates the passed in animations and populates the bone matrices in one go.
+
+            With flat pose evaluation enabled, the tracks are sampled into contiguous
+            per-bone translation, rotation and scale arrays and the hierarchy is resolved
+            by a single parent-first sweep; the Bone nodes are left untouched.
+            Otherwise, or if the skeleton has manually controlled bones, this is
+            equivalent to setAnimationState followed by _getBoneMatrices.
+        @see setFlatPoseEvaluation
+        */
+        void _getBoneMatrices(const AnimationStateSet& animSet, Affine3* pMatrices);
+
+        /** Sets whether animation is evaluated without going through the Bone nodes.
+
+            This is considerably cheaper for large crowds, but Bone derived transforms
+            no longer follow the animation, so only enable it where nothing reads them
+            (attached objects, skeleton-based bounds, skeleton display).
+            Entity takes care of falling back to the node path in those cases.
+        */
+        void setFlatPoseEvaluation(bool enabled) { mFlatPoseEvaluation = enabled; }
+        /// @copydoc setFlatPoseEvaluation
+        bool getFlatPoseEvaluation() const { return mFlatPoseEvaluation; }
+
         unsigned short getNumAnimations(void) const override;
 
         /** Gets a single animation by index. 
@@ -299,6 +321,13 @@ namespace Ogre {
         */
         virtual void optimiseAllAnimations(bool preservingIdentityNodeTracks = false);
 
+        /** Compresses the node tracks of all of this skeleton's animations.
+        @see NodeAnimationTrack::compress
+        */
+        void compressAllAnimations(Real translationTolerance = 1e-3f,
+                                   const Radian& rotationTolerance = Radian(1e-3f),
+                                   Real scaleTolerance = 1e-3f);
+
         /** Allows you to use the animations from another Skeleton object to animate
             this skeleton.
 
@@ -440,6 +469,15 @@ namespace Ogre {
         /// Storage of bones, indexed by bone handle
         BoneList mBoneList;
 
+        struct FlatPose;
+        /// Parent-first copy of the hierarchy and bind pose, built lazily for flat evaluation
+        std::unique_ptr<FlatPose> mFlatPose;
+        bool mFlatPoseEvaluation;
+
+        /// Rebuilds mFlatPose if needed, returns false if the hierarchy cannot be evaluated flat
+        bool buildFlatPose();
+        Real getAnimationWeightFactor(const AnimationStateSet& animSet) const;
+
         /** Internal method which parses the bones to derive the root bone. 
 
             Must be const because called in getRootBone but mRootBone is mutable
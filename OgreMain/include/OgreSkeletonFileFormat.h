@@ -101,6 +101,21 @@ namespace Ogre {
                     // Quaternion rotate            : Rotation to apply at this keyframe
                     // Vector3 translate            : Translation to apply at this keyframe
                     // Vector3 scale                : Scale to apply at this keyframe
+
+                SKELETON_ANIMATION_TRACK_COMPRESSED = 0x4120,
+                // [Optional] quantised keys, replaces the keyframe chunks of the track
+                // see CompressedTransformKeys, since [Serializer_v14.40]
+
+                    // unsigned int numKeys
+                    // float times[numKeys]
+                    // unsigned short rotations[numKeys * 3]     : smallest-three quaternions
+                    // Vector3 translateMin
+                    // Vector3 translateExtent
+                    // unsigned short translations[numKeys * 3]
+                    // unsigned int numScaleKeys                 : 0 or numKeys
+                    // Vector3 scaleMin
+                    // Vector3 scaleExtent
+                    // unsigned short scales[numScaleKeys * 3]
         SKELETON_ANIMATION_LINK         = 0x5000
         // Link to another skeleton, to re-use its animations
 
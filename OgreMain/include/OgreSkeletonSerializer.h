@@ -43,6 +43,8 @@ namespace Ogre {
         SKELETON_VERSION_1_0,
         /// OGRE version v1.8+
         SKELETON_VERSION_1_8,
+        /// OGRE version v14.4+, compressed animation tracks. Only used if the skeleton has any.
+        SKELETON_VERSION_14_4,
         
         /// Latest version available
         SKELETON_VERSION_LATEST = 100
@@ -109,14 +111,16 @@ namespace Ogre {
     private:
         
         void setWorkingVersion(SkeletonVersion ver);
+        static bool hasCompressedTracks(const Skeleton* pSkel);
         
         // Internal export methods
         void writeSkeleton(const Skeleton* pSkel, SkeletonVersion ver);
         void writeBone(const Skeleton* pSkel, const Bone* pBone);
         void writeBoneParent(const Skeleton* pSkel, unsigned short boneId, unsigned short parentId);
         void writeAnimation(const Skeleton* pSkel, const Animation* anim, SkeletonVersion ver);
-        void writeAnimationTrack(const Skeleton* pSkel, const NodeAnimationTrack* track);
+        void writeAnimationTrack(const Skeleton* pSkel, const NodeAnimationTrack* track, SkeletonVersion ver);
         void writeKeyFrame(const Skeleton* pSkel, const TransformKeyFrame* key);
+        void writeCompressedKeys(const CompressedTransformKeys& keys);
         void writeSkeletonAnimationLink(const Skeleton* pSkel, 
             const LinkedSkeletonAnimationSource& link);
 
@@ -127,15 +131,17 @@ namespace Ogre {
         void readAnimation(DataStreamPtr& stream, Skeleton* pSkel);
         void readAnimationTrack(DataStreamPtr& stream, Animation* anim, Skeleton* pSkel);
         void readKeyFrame(DataStreamPtr& stream, NodeAnimationTrack* track, Skeleton* pSkel);
+        void readCompressedKeys(DataStreamPtr& stream, NodeAnimationTrack* track);
         void readSkeletonAnimationLink(DataStreamPtr& stream, Skeleton* pSkel);
 
         size_t calcBoneSize(const Skeleton* pSkel, const Bone* pBone);
         size_t calcBoneSizeWithoutScale(const Skeleton* pSkel, const Bone* pBone);
         size_t calcBoneParentSize(const Skeleton* pSkel);
         size_t calcAnimationSize(const Skeleton* pSkel, const Animation* pAnim, SkeletonVersion ver);
-        size_t calcAnimationTrackSize(const Skeleton* pSkel, const NodeAnimationTrack* pTrack);
+        size_t calcAnimationTrackSize(const Skeleton* pSkel, const NodeAnimationTrack* pTrack, SkeletonVersion ver);
         size_t calcKeyFrameSize(const Skeleton* pSkel, const TransformKeyFrame* pKey);
         size_t calcKeyFrameSizeWithoutScale(const Skeleton* pSkel, const TransformKeyFrame* pKey);
+        size_t calcCompressedKeysSize(const CompressedTransformKeys& keys);
         size_t calcSkeletonAnimationLinkSize(const Skeleton* pSkel, 
             const LinkedSkeletonAnimationSource& link);
 
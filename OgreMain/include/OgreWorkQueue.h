@@ -159,6 +159,14 @@ namespace Ogre
 
         /** Add a new task to the queue */
         virtual void addTask(std::function<void()> task) = 0;
+
+        /** Calls func(i) for every i in [0, count) using the worker threads.
+
+            The calling thread claims jobs as well and only returns once all of them are done,
+            so this also makes progress if the workers are busy or not started.
+            The first exception thrown by func is rethrown on the calling thread.
+        */
+        void parallelFor(size_t count, const std::function<void(size_t)>& func);
         
         /** Set whether to pause further processing of any requests. 
         If true, any further requests will simply be queued and not processed until
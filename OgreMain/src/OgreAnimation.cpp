@@ -680,6 +680,21 @@ namespace Ogre {
         return mBaseKeyFrameAnimationName;
     }
     //-----------------------------------------------------------------------
+    void Animation::_prepareForSampling()
+    {
+        _applyBaseKeyFrame();
+
+        if (mKeyFrameTimesDirty)
+        {
+            buildKeyFrameTimeList();
+        }
+
+        for (auto& t : mNodeTrackList)
+        {
+            t.second->_prepareForSampling();
+        }
+    }
+    //-----------------------------------------------------------------------
     void Animation::_applyBaseKeyFrame()
     {
         if (mUseBaseKeyFrame)
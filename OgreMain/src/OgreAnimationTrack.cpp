@@ -33,14 +33,89 @@ THE SOFTWARE.
 namespace Ogre {
 
     namespace {
-        // Locally key frame search helper
-        struct KeyFrameTimeLess
+        uint16 quantise(Real v, Real min, Real extent)
         {
-            bool operator() (const KeyFrame* kf, const KeyFrame* kf2) const
-            {
-                return kf->getTime() < kf2->getTime();
-            }
-        };
+            if (extent <= 0)
+                return 0;
+            return uint16(Math::saturate((v - min) / extent) * 65535 + 0.5f);
+        }
+
+        Real dequantise(uint16 v, Real min, Real extent)
+        {
+            return min + extent * (v / Real(65535));
+        }
+
+        void quantise(const Vector3& v, const Vector3& min, const Vector3& extent, uint16* out)
+        {
+            for (int i = 0; i < 3; i++)
+                out[i] = quantise(v[i], min[i], extent[i]);
+        }
+
+        Vector3 dequantise(const uint16* v, const Vector3& min, const Vector3& extent)
+        {
+            return Vector3(dequantise(v[0], min[0], extent[0]), dequantise(v[1], min[1], extent[1]),
+                           dequantise(v[2], min[2], extent[2]));
+        }
+
+        // the three smallest components of a unit quaternion lie within +-1/sqrt(2)
+        const Real QUAT_COMPONENT_RANGE = Real(0.70710678118654752440);
+    }
+    //---------------------------------------------------------------------
+    void CompressedTransformKeys::getKey(size_t index, Vector3& translate, Quaternion& rotate,
+                                         Vector3& scale) const
+    {
+        const uint16* r = &rotations[index * 3];
+        int largest = (r[0] >> 15) | ((r[1] >> 15) << 1);
+        Real* q = rotate.ptr();
+        Real sum = 0;
+        for (int i = 0, k = 0; i < 4; i++)
+        {
+            if (i == largest)
+                continue;
+            q[i] = ((r[k++] & 0x7FFF) / Real(32767) * 2 - 1) * QUAT_COMPONENT_RANGE;
+            sum += q[i] * q[i];
+        }
+        q[largest] = Math::Sqrt(std::max<Real>(0, 1 - sum));
+
+        translate = dequantise(&translations[index * 3], translateMin, translateExtent);
+        scale = scales.empty() ? Vector3::UNIT_SCALE : dequantise(&scales[index * 3], scaleMin, scaleExtent);
+    }
+    //---------------------------------------------------------------------
+    void CompressedTransformKeys::addKey(Real time, const Vector3& translate, const Quaternion& rotate,
+                                         const Vector3& scale)
+    {
+        times.push_back(time);
+
+        // smallest three, the largest component is restored from the unit length
+        const Real* q = rotate.ptr();
+        int largest = 0;
+        for (int i = 1; i < 4; i++)
+        {
+            if (Math::Abs(q[i]) > Math::Abs(q[largest]))
+                largest = i;
+        }
+        Real sign = q[largest] < 0 ? -1 : 1;
+        uint16 r[3];
+        for (int i = 0, k = 0; i < 4; i++)
+        {
+            if (i == largest)
+                continue;
+            Real c = Math::saturate((q[i] * sign / QUAT_COMPONENT_RANGE + 1) * 0.5f);
+            r[k++] = uint16(c * 32767 + 0.5f);
+        }
+        r[0] |= (largest & 1) << 15;
+        r[1] |= (largest >> 1) << 15;
+        rotations.insert(rotations.end(), r, r + 3);
+
+        uint16 v[3];
+        quantise(translate, translateMin, translateExtent, v);
+        translations.insert(translations.end(), v, v + 3);
+
+        if (scaleMin != Vector3::UNIT_SCALE || scaleExtent != Vector3::ZERO)
+        {
+            quantise(scale, scaleMin, scaleExtent, v);
+            scales.insert(scales.end(), v, v + 3);
+        }
     }
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
@@ -54,52 +129,51 @@ namespace Ogre {
         removeAllKeyFrames();
     }
     //---------------------------------------------------------------------
-    float AnimationTrack::getKeyFramesAtTime(const TimeIndex& timeIndex, KeyFrame** keyFrame1, KeyFrame** keyFrame2,
-        unsigned short* firstKeyIndex) const
+    size_t AnimationTrack::findKeyFrameAtTime(const TimeIndex& timeIndex, Real& timePos) const
     {
-        // Parametric time
-        // t1 = time of previous keyframe
-        // t2 = time of next keyframe
-        Real t1, t2;
-
-        Real timePos = timeIndex.getTimePos();
+        const std::vector<Real>& times = _getKeyFrameTimes();
+        timePos = timeIndex.getTimePos();
 
-        // Find first keyframe after or on current time
-        KeyFrameList::const_iterator i;
         if (timeIndex.hasKeyIndex())
         {
             // Global keyframe index available, map to local keyframe index directly.
             assert(timeIndex.getKeyIndex() < mKeyFrameIndexMap.size());
-            i = mKeyFrames.begin() + mKeyFrameIndexMap[timeIndex.getKeyIndex()];
+            size_t i = mKeyFrameIndexMap[timeIndex.getKeyIndex()];
 #if OGRE_DEBUG_MODE
-            KeyFrame timeKey(NULL, timePos);
-            if (i != std::lower_bound(mKeyFrames.begin(), mKeyFrames.end() - 1, &timeKey, KeyFrameTimeLess()))
+            if (i != size_t(std::lower_bound(times.begin(), times.end() - 1, timePos) - times.begin()))
             {
                 OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "Optimised key frame search failed");
             }
 #endif
+            return i;
         }
-        else
-        {
-            // Wrap time
-            Real totalAnimationLength = mParent->getLength();
-            OgreAssertDbg(totalAnimationLength > 0.0f, "Invalid animation length!");
 
-            if( timePos > totalAnimationLength && totalAnimationLength > 0.0f )
-                timePos = std::fmod( timePos, totalAnimationLength );
+        // Wrap time
+        Real totalAnimationLength = mParent->getLength();
+        OgreAssertDbg(totalAnimationLength > 0.0f, "Invalid animation length!");
 
-            // No global keyframe index, need to search with local keyframes.
-            KeyFrame timeKey(NULL, timePos);
-            i = std::lower_bound(mKeyFrames.begin(), mKeyFrames.end() - 1, &timeKey, KeyFrameTimeLess());
-        }
+        if( timePos > totalAnimationLength && totalAnimationLength > 0.0f )
+            timePos = std::fmod( timePos, totalAnimationLength );
 
-        OgreAssertDbg(i != mKeyFrames.end(), "time should have been wrapped before this");
+        // No global keyframe index, need to search with local keyframes.
+        return std::lower_bound(times.begin(), times.end() - 1, timePos) - times.begin();
+    }
+    //---------------------------------------------------------------------
+    float AnimationTrack::getKeyFramesAtTime(const TimeIndex& timeIndex, KeyFrame** keyFrame1, KeyFrame** keyFrame2,
+        unsigned short* firstKeyIndex) const
+    {
+        // Find first keyframe after or on current time
+        Real timePos;
+        size_t i = findKeyFrameAtTime(timeIndex, timePos);
 
-        *keyFrame2 = *i;
-        t2 = (*keyFrame2)->getTime();
+        OgreAssertDbg(i < mKeyFrames.size(), "time should have been wrapped before this");
+
+        *keyFrame2 = mKeyFrames[i];
+        // t2 = time of next keyframe
+        Real t2 = mKeyFrameTimes[i];
 
         // Find last keyframe before or on current time
-        if (i != mKeyFrames.begin() && timePos < (*i)->getTime())
+        if (i != 0 && timePos < t2)
         {
             --i;
         }
@@ -107,12 +181,12 @@ namespace Ogre {
         // Fill index of the first key
         if (firstKeyIndex)
         {
-            *firstKeyIndex = static_cast<unsigned short>(std::distance(mKeyFrames.begin(), i));
+            *firstKeyIndex = static_cast<unsigned short>(i);
         }
 
-        *keyFrame1 = *i;
-
-        t1 = (*keyFrame1)->getTime();
+        *keyFrame1 = mKeyFrames[i];
+        // t1 = time of previous keyframe
+        Real t1 = mKeyFrameTimes[i];
 
         if (t1 == t2)
         {
@@ -130,9 +204,9 @@ namespace Ogre {
         KeyFrame* kf = createKeyFrameImpl(timePos);
 
         // Insert just before upper bound
-        KeyFrameList::iterator i =
-            std::upper_bound(mKeyFrames.begin(), mKeyFrames.end(), kf, KeyFrameTimeLess());
-        mKeyFrames.insert(i, kf);
+        auto t = std::upper_bound(mKeyFrameTimes.begin(), mKeyFrameTimes.end(), kf->getTime());
+        mKeyFrames.insert(mKeyFrames.begin() + (t - mKeyFrameTimes.begin()), kf);
+        mKeyFrameTimes.insert(t, kf->getTime());
 
         _keyFrameDataChanged();
         mParent->_keyFrameListChanged();
@@ -153,6 +227,7 @@ namespace Ogre {
         OGRE_DELETE *i;
 
         mKeyFrames.erase(i);
+        mKeyFrameTimes.erase(mKeyFrameTimes.begin() + index);
 
         _keyFrameDataChanged();
         mParent->_keyFrameListChanged();
@@ -169,14 +244,14 @@ namespace Ogre {
         mParent->_keyFrameListChanged();
 
         mKeyFrames.clear();
+        mKeyFrameTimes.clear();
 
     }
     //---------------------------------------------------------------------
     void AnimationTrack::_collectKeyFrameTimes(std::vector<Real>& keyFrameTimes)
     {
-        for (auto k : mKeyFrames)
+        for (Real timePos : _getKeyFrameTimes())
         {
-            Real timePos = k->getTime();
 
             std::vector<Real>::iterator it =
                 std::lower_bound(keyFrameTimes.begin(), keyFrameTimes.end(), timePos);
@@ -189,6 +264,13 @@ namespace Ogre {
     //---------------------------------------------------------------------
     void AnimationTrack::_buildKeyFrameIndexMap(const std::vector<Real>& keyFrameTimes)
     {
+        const std::vector<Real>& times = _getKeyFrameTimes();
+        if (times.empty())
+        {
+            mKeyFrameIndexMap.clear();
+            return;
+        }
+
         // Pre-allocate memory
         mKeyFrameIndexMap.resize(keyFrameTimes.size());
 
@@ -197,7 +279,7 @@ namespace Ogre {
         while (j < keyFrameTimes.size())
         {
             mKeyFrameIndexMap[j] = static_cast<ushort>(i);
-            while (i < (mKeyFrames.size() - 1) && mKeyFrames[i]->getTime() <= keyFrameTimes[j])
+            while (i < (times.size() - 1) && times[i] <= keyFrameTimes[j])
             {
                 ++i;
             }
@@ -217,6 +299,7 @@ namespace Ogre {
             KeyFrame* clonekf = k->_clone(clone);
             clone->mKeyFrames.push_back(clonekf);
         }
+        clone->mKeyFrameTimes = mKeyFrameTimes;
     }
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
@@ -360,7 +443,7 @@ namespace Ogre {
     //---------------------------------------------------------------------
     NodeAnimationTrack::NodeAnimationTrack(Animation* parent, unsigned short handle, Node* targetNode)
         : AnimationTrack(parent, handle), mSplineBuildNeeded(false), mUseShortestRotationPath(true),
-          mTargetNode(targetNode), mSplines(0)
+          mTargetNode(targetNode), mSplines(0), mCompressed(0)
 
     {
     }
@@ -368,6 +451,7 @@ namespace Ogre {
     NodeAnimationTrack::~NodeAnimationTrack()
     {
         OGRE_DELETE_T(mSplines, Splines, MEMCATEGORY_ANIMATION);
+        OGRE_DELETE_T(mCompressed, CompressedTransformKeys, MEMCATEGORY_ANIMATION);
     }
     //---------------------------------------------------------------------
     void NodeAnimationTrack::getInterpolatedKeyFrame(const TimeIndex& timeIndex, KeyFrame* kf) const
@@ -384,10 +468,22 @@ namespace Ogre {
         KeyFrame *kBase1, *kBase2;
         TransformKeyFrame *k1, *k2;
         unsigned short firstKeyIndex;
+        Real t;
 
-        Real t = this->getKeyFramesAtTime(timeIndex, &kBase1, &kBase2, &firstKeyIndex);
-        k1 = static_cast<TransformKeyFrame*>(kBase1);
-        k2 = static_cast<TransformKeyFrame*>(kBase2);
+        // Storage for keys decoded from the compressed representation
+        TransformKeyFrame decoded1(0, 0), decoded2(0, 0);
+        if (mCompressed)
+        {
+            t = getCompressedKeysAtTime(timeIndex, &decoded1, &decoded2, &firstKeyIndex);
+            k1 = &decoded1;
+            k2 = &decoded2;
+        }
+        else
+        {
+            t = this->getKeyFramesAtTime(timeIndex, &kBase1, &kBase2, &firstKeyIndex);
+            k1 = static_cast<TransformKeyFrame*>(kBase1);
+            k2 = static_cast<TransformKeyFrame*>(kBase2);
+        }
 
         if (t == 0.0)
         {
@@ -473,30 +569,44 @@ namespace Ogre {
     void NodeAnimationTrack::applyToNode(Node* node, const TimeIndex& timeIndex, Real weight,
         Real scl)
     {
-        // Nothing to do if no keyframes or zero weight or no node
-        if (mKeyFrames.empty() || !weight || !node)
+        // Nothing to do if no node
+        if (!node)
+            return;
+
+        Vector3 translate, scale;
+        Quaternion rotate;
+        if (!_getWeightedTransform(timeIndex, weight, scl, translate, rotate, scale))
             return;
 
+        node->translate(translate);
+        node->rotate(rotate);
+        node->scale(scale);
+    }
+    //---------------------------------------------------------------------
+    bool NodeAnimationTrack::_getWeightedTransform(const TimeIndex& timeIndex, Real weight, Real scl,
+        Vector3& outTranslate, Quaternion& outRotate, Vector3& outScale) const
+    {
+        // Nothing to do if no keyframes or zero weight
+        if ((mKeyFrames.empty() && !mCompressed) || !weight)
+            return false;
+
         TransformKeyFrame kf(0, timeIndex.getTimePos());
         getInterpolatedKeyFrame(timeIndex, &kf);
 
         // add to existing. Weights are not relative, but treated as absolute multipliers for the animation
-        Vector3 translate = kf.getTranslate() * weight * scl;
-        node->translate(translate);
+        outTranslate = kf.getTranslate() * weight * scl;
 
         // interpolate between no-rotation and full rotation, to point 'weight', so 0 = no rotate, 1 = full
-        Quaternion rotate;
         Animation::RotationInterpolationMode rim =
             mParent->getRotationInterpolationMode();
         if (rim == Animation::RIM_LINEAR)
         {
-            rotate = Quaternion::nlerp(weight, Quaternion::IDENTITY, kf.getRotation(), mUseShortestRotationPath);
+            outRotate = Quaternion::nlerp(weight, Quaternion::IDENTITY, kf.getRotation(), mUseShortestRotationPath);
         }
         else //if (rim == Animation::RIM_SPHERICAL)
         {
-            rotate = Quaternion::Slerp(weight, Quaternion::IDENTITY, kf.getRotation(), mUseShortestRotationPath);
+            outRotate = Quaternion::Slerp(weight, Quaternion::IDENTITY, kf.getRotation(), mUseShortestRotationPath);
         }
-        node->rotate(rotate);
 
         Vector3 scale = kf.getScale();
         // Not sure how to modify scale for cumulative anims... leave it alone
@@ -508,8 +618,9 @@ namespace Ogre {
             else if (weight != 1.0f)
                 scale = Vector3::UNIT_SCALE + (scale - Vector3::UNIT_SCALE) * weight;
         }
-        node->scale(scale);
+        outScale = scale;
 
+        return true;
     }
     //---------------------------------------------------------------------
     void NodeAnimationTrack::buildInterpolationSplines(void) const
@@ -532,6 +643,19 @@ namespace Ogre {
         splines->rotationSpline.clear();
         splines->scaleSpline.clear();
 
+        if (mCompressed)
+        {
+            Vector3 translate, scale;
+            Quaternion rotate;
+            for (size_t i = 0; i < mCompressed->getNumKeys(); ++i)
+            {
+                mCompressed->getKey(i, translate, rotate, scale);
+                splines->positionSpline.addPoint(translate);
+                splines->rotationSpline.addPoint(rotate);
+                splines->scaleSpline.addPoint(scale);
+            }
+        }
+
         for (auto *f : mKeyFrames)
         {
             TransformKeyFrame* kf = static_cast<TransformKeyFrame*>(f);
@@ -548,6 +672,126 @@ namespace Ogre {
         mSplineBuildNeeded = false;
     }
 
+    //---------------------------------------------------------------------
+    Real NodeAnimationTrack::getCompressedKeysAtTime(const TimeIndex& timeIndex, TransformKeyFrame* keyFrame1,
+                                                     TransformKeyFrame* keyFrame2,
+                                                     unsigned short* firstKeyIndex) const
+    {
+        Real timePos;
+        const std::vector<Real>& times = mCompressed->times;
+        size_t i2 = findKeyFrameAtTime(timeIndex, timePos);
+        size_t i1 = (i2 != 0 && timePos < times[i2]) ? i2 - 1 : i2;
+        *firstKeyIndex = static_cast<unsigned short>(i1);
+
+        Vector3 translate, scale;
+        Quaternion rotate;
+        mCompressed->getKey(i1, translate, rotate, scale);
+        keyFrame1->setTranslate(translate);
+        keyFrame1->setRotation(rotate);
+        keyFrame1->setScale(scale);
+        mCompressed->getKey(i2, translate, rotate, scale);
+        keyFrame2->setTranslate(translate);
+        keyFrame2->setRotation(rotate);
+        keyFrame2->setScale(scale);
+
+        Real t1 = times[i1], t2 = times[i2];
+        return t1 == t2 ? 0.0f : (timePos - t1) / (t2 - t1);
+    }
+    //---------------------------------------------------------------------
+    void NodeAnimationTrack::compress(Real translationTolerance, const Radian& rotationTolerance,
+                                      Real scaleTolerance)
+    {
+        if (mCompressed || mKeyFrames.empty())
+            return;
+
+        std::vector<const TransformKeyFrame*> keys;
+        for (auto *k : mKeyFrames)
+            keys.push_back(static_cast<const TransformKeyFrame*>(k));
+
+        // Drop keys while the segment between the last kept key and the candidate
+        // reproduces everything in between within tolerance
+        std::vector<const TransformKeyFrame*> kept(1, keys.front());
+        size_t anchor = 0;
+        for (size_t next = 2; next < keys.size(); ++next)
+        {
+            const TransformKeyFrame* a = keys[anchor];
+            const TransformKeyFrame* b = keys[next];
+            Real span = b->getTime() - a->getTime();
+            bool reproduced = span > 0;
+            for (size_t m = anchor + 1; m < next && reproduced; ++m)
+            {
+                const TransformKeyFrame* k = keys[m];
+                Real t = (k->getTime() - a->getTime()) / span;
+                reproduced =
+                    Math::lerp(a->getTranslate(), b->getTranslate(), t).distance(k->getTranslate()) <=
+                        translationTolerance &&
+                    Quaternion::Slerp(t, a->getRotation(), b->getRotation(), mUseShortestRotationPath)
+                        .equals(k->getRotation(), rotationTolerance) &&
+                    Math::lerp(a->getScale(), b->getScale(), t).distance(k->getScale()) <= scaleTolerance;
+            }
+            if (!reproduced)
+            {
+                anchor = next - 1;
+                kept.push_back(keys[anchor]);
+            }
+        }
+        if (keys.size() > 1)
+            kept.push_back(keys.back());
+
+        CompressedTransformKeys compressed;
+        Vector3 translateMax, scaleMax;
+        compressed.translateMin = translateMax = kept.front()->getTranslate();
+        compressed.scaleMin = scaleMax = kept.front()->getScale();
+        for (auto *k : kept)
+        {
+            compressed.translateMin.makeFloor(k->getTranslate());
+            translateMax.makeCeil(k->getTranslate());
+            compressed.scaleMin.makeFloor(k->getScale());
+            scaleMax.makeCeil(k->getScale());
+        }
+        compressed.translateExtent = translateMax - compressed.translateMin;
+        compressed.scaleExtent = scaleMax - compressed.scaleMin;
+
+        for (auto *k : kept)
+            compressed.addKey(k->getTime(), k->getTranslate(), k->getRotation(), k->getScale());
+
+        _setCompressedKeys(compressed);
+    }
+    //---------------------------------------------------------------------
+    void NodeAnimationTrack::decompress()
+    {
+        if (!mCompressed)
+            return;
+
+        CompressedTransformKeys* compressed = mCompressed;
+        mCompressed = 0;
+
+        Vector3 translate, scale;
+        Quaternion rotate;
+        for (size_t i = 0; i < compressed->getNumKeys(); ++i)
+        {
+            compressed->getKey(i, translate, rotate, scale);
+            TransformKeyFrame* kf = createNodeKeyFrame(compressed->times[i]);
+            kf->setTranslate(translate);
+            kf->setRotation(rotate);
+            kf->setScale(scale);
+        }
+
+        OGRE_DELETE_T(compressed, CompressedTransformKeys, MEMCATEGORY_ANIMATION);
+    }
+    //---------------------------------------------------------------------
+    void NodeAnimationTrack::_setCompressedKeys(const CompressedTransformKeys& keys)
+    {
+        OgreAssert(!keys.times.empty(), "Compressed track needs at least one key");
+        removeAllKeyFrames();
+
+        if (!mCompressed)
+            mCompressed = OGRE_NEW_T(CompressedTransformKeys, MEMCATEGORY_ANIMATION)();
+        *mCompressed = keys;
+
+        _keyFrameDataChanged();
+        mParent->_keyFrameListChanged();
+    }
     //---------------------------------------------------------------------
     void NodeAnimationTrack::setUseShortestRotationPath(bool useShortestPath)
     {
@@ -565,8 +809,20 @@ namespace Ogre {
         mSplineBuildNeeded = true;
     }
     //---------------------------------------------------------------------
+    void NodeAnimationTrack::_prepareForSampling(void) const
+    {
+        if (mSplineBuildNeeded && mParent->getInterpolationMode() == Animation::IM_SPLINE)
+        {
+            buildInterpolationSplines();
+        }
+    }
+    //---------------------------------------------------------------------
     bool NodeAnimationTrack::hasNonZeroKeyFrames(void) const
     {
+        // compressed tracks already dropped redundant keys
+        if (mCompressed)
+            return true;
+
         for (auto *k : mKeyFrames)
         {
             // look for keyframes which have any component which is non-zero
@@ -596,6 +852,9 @@ namespace Ogre {
         // NB only eliminate middle keys from sequences of 5+ identical keyframes
         // since we need to preserve the boundary keys in place, and we need
         // 2 at each end to preserve tangents for spline interpolation
+        if (mCompressed)
+            return;
+
         Vector3 lasttrans = Vector3::ZERO;
         Vector3 lastscale = Vector3::ZERO;
         Quaternion lastorientation;
@@ -646,6 +905,7 @@ namespace Ogre {
     //--------------------------------------------------------------------------
     KeyFrame* NodeAnimationTrack::createKeyFrameImpl(Real time)
     {
+        OgreAssert(!mCompressed, "decompress the track before editing it");
         return OGRE_NEW TransformKeyFrame(this, time);
     }
     //--------------------------------------------------------------------------
@@ -664,14 +924,21 @@ namespace Ogre {
         NodeAnimationTrack* newTrack = 
             newParent->createNodeTrack(mHandle, mTargetNode);
         newTrack->mUseShortestRotationPath = mUseShortestRotationPath;
-        populateClone(newTrack);
+        if (mCompressed)
+            newTrack->_setCompressedKeys(*mCompressed);
+        else
+            populateClone(newTrack);
         return newTrack;
     }
     //--------------------------------------------------------------------------
     void NodeAnimationTrack::_applyBaseKeyFrame(const KeyFrame* b)
     {
         const TransformKeyFrame* base = static_cast<const TransformKeyFrame*>(b);
-        
+
+        // rebase the decoded keys, keeping the key set that was already reduced
+        bool compressed = isCompressed();
+        decompress();
+
         for (auto& k : mKeyFrames)
         {
             TransformKeyFrame* kf = static_cast<TransformKeyFrame*>(k);
@@ -679,6 +946,9 @@ namespace Ogre {
             kf->setRotation(base->getRotation().Inverse() * kf->getRotation());
             kf->setScale(kf->getScale() * (Vector3::UNIT_SCALE / base->getScale()));
         }
+
+        if (compressed)
+            compress(0, Radian(0), 0);
             
     }
     //--------------------------------------------------------------------------
@@ -30,10 +30,17 @@ THE SOFTWARE.
 #include "OgreBillboardSet.h"
 #include "OgreBillboard.h"
 
+#include "OgreWorkQueue.h"
+
 #include <algorithm>
 #include <memory>
 
 namespace Ogre {
+    /// billboards generated per WorkQueue job
+    static const size_t GEN_CHUNK_SIZE = 2048;
+
+    static const Billboard& derefBillboard(const Billboard& bb) { return bb; }
+    static const Billboard& derefBillboard(const Billboard* bb) { return *bb; }
     //-----------------------------------------------------------------------
     BillboardSet::BillboardSet() :
         mBoundingRadius(0.0f), 
@@ -41,12 +48,14 @@ namespace Ogre {
         mRotationType( BBR_TEXCOORD ),
         mAutoExtendPool( true ),
         mSortingEnabled(false),
+        mSortingCoherent(false),
         mAccurateFacing(false),
         mWorldSpace(false),
         mCullIndividual( false ),
         mBillboardType(BBT_POINT),
         mCommonDirection(Ogre::Vector3::UNIT_Z),
         mCommonUpVector(Vector3::UNIT_Y),
+        mNumVisibleBillboards(0),
         mPointRendering(false),
         mBuffersCreated(false),
         mPoolSize(0),
@@ -72,6 +81,7 @@ namespace Ogre {
         mRotationType( BBR_TEXCOORD ),
         mAutoExtendPool( true ),
         mSortingEnabled(false),
+        mSortingCoherent(false),
         mAccurateFacing(false),
         mWorldSpace(false),
         mActiveBillboards(0),
@@ -79,6 +89,7 @@ namespace Ogre {
         mBillboardType(BBT_POINT),
         mCommonDirection(Ogre::Vector3::UNIT_Z),
         mCommonUpVector(Vector3::UNIT_Y),
+        mNumVisibleBillboards(0),
         mPointRendering(false),
         mBuffersCreated(false),
         mPoolSize(poolSize),
@@ -189,20 +200,48 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void BillboardSet::_sortBillboards( Camera* cam)
     {
-        static RadixSort<BillboardPool, Billboard*, float> mRadixSorter;
-
         switch (_getSortMode())
         {
         case SM_DIRECTION:
-            mRadixSorter.sort(mBillboardPool.begin(), mBillboardPool.begin() + mActiveBillboards,
-                              SortByDirectionFunctor(-mCamDir));
+            sortBillboards(SortByDirectionFunctor(-mCamDir));
             break;
         case SM_DISTANCE:
-            mRadixSorter.sort(mBillboardPool.begin(), mBillboardPool.begin() + mActiveBillboards,
-                              SortByDistanceFunctor(mCamPos));
+            sortBillboards(SortByDistanceFunctor(mCamPos));
             break;
         }
     }
+    //-----------------------------------------------------------------------
+    template <typename F> void BillboardSet::sortBillboards(const F& func)
+    {
+        if (mSortingCoherent)
+        {
+            // insertion sort of last frame's order, giving up once it does more work than the radix sort
+            mSortKeys.resize(mActiveBillboards);
+            for (size_t i = 0; i < mActiveBillboards; ++i)
+                mSortKeys[i] = func(mBillboardPool[i]);
+
+            size_t budget = mActiveBillboards * 4;
+            for (size_t i = 1; i < mActiveBillboards && budget; ++i)
+            {
+                float key = mSortKeys[i];
+                Billboard* bb = mBillboardPool[i];
+                size_t j = i;
+                for (; j > 0 && mSortKeys[j - 1] > key && budget; --j, --budget)
+                {
+                    mSortKeys[j] = mSortKeys[j - 1];
+                    mBillboardPool[j] = mBillboardPool[j - 1];
+                }
+                mSortKeys[j] = key;
+                mBillboardPool[j] = bb;
+            }
+
+            if (budget)
+                return;
+        }
+
+        static RadixSort<BillboardPool, Billboard*, float> radixSorter;
+        radixSorter.sort(mBillboardPool.begin(), mBillboardPool.begin() + mActiveBillboards, func);
+    }
     BillboardSet::SortByDirectionFunctor::SortByDirectionFunctor(const Vector3& dir)
         : sortDir(dir)
     {
@@ -353,17 +392,57 @@ namespace Ogre {
         // Increment visibles
         mNumVisibleBillboards++;
 
+        genVertices(bb, mLockPtr);
+    }
+    //-----------------------------------------------------------------------
+    void BillboardSet::injectBillboards(const Billboard* billboards, size_t count)
+    {
+        injectBillboardsImpl(billboards, count);
+    }
+    //-----------------------------------------------------------------------
+    template <typename T> void BillboardSet::injectBillboardsImpl(const T* billboards, size_t count)
+    {
+        // Don't accept injections beyond pool size
+        count = std::min(count, mPoolSize - mNumVisibleBillboards);
+
+        // culling changes where the vertices of each billboard go, so that stays sequential
+        if (mCullIndividual || count < 2 * GEN_CHUNK_SIZE)
+        {
+            for (size_t i = 0; i < count; ++i)
+                injectBillboard(derefBillboard(billboards[i]));
+            return;
+        }
+
+        size_t stride = (mMainBuf->getVertexSize() / sizeof(float)) * (mPointRendering ? 1 : 4);
+        float* pDest = mLockPtr;
+
+        size_t numChunks = (count + GEN_CHUNK_SIZE - 1) / GEN_CHUNK_SIZE;
+        Root::getSingleton().getWorkQueue()->parallelFor(numChunks, [&](size_t chunk) {
+            size_t begin = chunk * GEN_CHUNK_SIZE;
+            size_t end = std::min(begin + GEN_CHUNK_SIZE, count);
+            float* pChunkDest = pDest + begin * stride;
+            for (size_t i = begin; i < end; ++i)
+                genVertices(derefBillboard(billboards[i]), pChunkDest);
+        });
+
+        mLockPtr += count * stride;
+        mNumVisibleBillboards += count;
+    }
+    //-----------------------------------------------------------------------
+    void BillboardSet::genVertices(const Billboard& bb, float*& pDest) const
+    {
         if(mPointRendering)
         {
-            genPointVertices(bb);
+            genPointVertices(bb, pDest);
             return;
         }
 
+        Vector3 camX = mCamX, camY = mCamY;
         if ((mBillboardType == BBT_ORIENTED_SELF || mBillboardType == BBT_PERPENDICULAR_SELF ||
              (mAccurateFacing && mBillboardType != BBT_PERPENDICULAR_COMMON)))
         {
             // Have to generate axes & offsets per billboard
-            genBillboardAxes(&mCamX, &mCamY, &bb);
+            genBillboardAxes(&camX, &camY, &bb);
         }
 
         if ((mBillboardType == BBT_ORIENTED_SELF || mBillboardType == BBT_PERPENDICULAR_SELF ||
@@ -374,13 +453,13 @@ namespace Ogre {
             Real width = bb.mOwnDimensions ? bb.mWidth : mDefaultWidth;
             Real height = bb.mOwnDimensions ? bb.mHeight : mDefaultHeight;
             genVertOffsets(mLeftOff, mRightOff, mTopOff, mBottomOff,
-                width, height, mCamX, mCamY, vOwnOffset);
-            genQuadVertices(vOwnOffset, bb);
+                width, height, camX, camY, vOwnOffset);
+            genQuadVertices(vOwnOffset, bb, pDest);
         }
         else
         {
             // Use default dimension, already computed before the loop, for faster creation
-            genQuadVertices(mVOffset, bb);
+            genQuadVertices(mVOffset, bb, pDest);
         }
     }
     //-----------------------------------------------------------------------
@@ -446,11 +525,7 @@ namespace Ogre {
             }
 
             beginBillboards(mActiveBillboards);
-            auto iend = mBillboardPool.begin() + mActiveBillboards;
-            for (auto it = mBillboardPool.begin(); it != iend; ++it)
-            {
-                injectBillboard(*(*it));
-            }
+            injectBillboardsImpl(mBillboardPool.data(), mActiveBillboards);
             endBillboards();
             mBillboardDataChanged = false;
         }
@@ -537,6 +612,26 @@ namespace Ogre {
         _destroyBuffers();
     }
 
+    //-----------------------------------------------------------------------
+    template <typename T> static void genIndices(T* pIdx, size_t poolSize)
+    {
+        for(
+            size_t idx, idxOff, bboard = 0;
+            bboard < poolSize;
+            ++bboard )
+        {
+            // Do indexes
+            idx    = bboard * 6;
+            idxOff = bboard * 4;
+
+            pIdx[idx] = static_cast<T>(idxOff); // + 0;, for clarity
+            pIdx[idx+1] = static_cast<T>(idxOff + 2);
+            pIdx[idx+2] = static_cast<T>(idxOff + 1);
+            pIdx[idx+3] = static_cast<T>(idxOff + 1);
+            pIdx[idx+4] = static_cast<T>(idxOff + 2);
+            pIdx[idx+5] = static_cast<T>(idxOff + 3);
+        }
+    }
     //-----------------------------------------------------------------------
     void BillboardSet::_createBuffers(void)
     {
@@ -599,8 +694,10 @@ namespace Ogre {
             mIndexData->indexStart = 0;
             mIndexData->indexCount = mPoolSize * 6;
 
+            // large sets need 32 bit indices
+            bool use32BitIndices = mPoolSize * 4 > 0xFFFF;
             mIndexData->indexBuffer = HardwareBufferManager::getSingleton().
-                createIndexBuffer(HardwareIndexBuffer::IT_16BIT,
+                createIndexBuffer(use32BitIndices ? HardwareIndexBuffer::IT_32BIT : HardwareIndexBuffer::IT_16BIT,
                     mIndexData->indexCount,
                     HardwareBuffer::HBU_STATIC_WRITE_ONLY);
 
@@ -617,25 +714,10 @@ namespace Ogre {
             */
 
             HardwareBufferLockGuard indexLock(mIndexData->indexBuffer, HardwareBuffer::HBL_DISCARD);
-            ushort* pIdx = static_cast<ushort*>(indexLock.pData);
-
-            for(
-                size_t idx, idxOff, bboard = 0;
-                bboard < mPoolSize;
-                ++bboard )
-            {
-                // Do indexes
-                idx    = bboard * 6;
-                idxOff = bboard * 4;
-
-                pIdx[idx] = static_cast<unsigned short>(idxOff); // + 0;, for clarity
-                pIdx[idx+1] = static_cast<unsigned short>(idxOff + 2);
-                pIdx[idx+2] = static_cast<unsigned short>(idxOff + 1);
-                pIdx[idx+3] = static_cast<unsigned short>(idxOff + 1);
-                pIdx[idx+4] = static_cast<unsigned short>(idxOff + 2);
-                pIdx[idx+5] = static_cast<unsigned short>(idxOff + 3);
-
-            }
+            if (use32BitIndices)
+                genIndices(static_cast<uint32*>(indexLock.pData), mPoolSize);
+            else
+                genIndices(static_cast<uint16*>(indexLock.pData), mPoolSize);
         }
         mBuffersCreated = true;
     }
@@ -759,17 +841,18 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
-    void BillboardSet::genBillboardAxes(Vector3* pX, Vector3 *pY, const Billboard* bb)
+    void BillboardSet::genBillboardAxes(Vector3* pX, Vector3 *pY, const Billboard* bb) const
     {
         // If we're using accurate facing, recalculate camera direction per BB
+        Vector3 camDir = mCamDir;
         if (mAccurateFacing && 
             (mBillboardType == BBT_POINT || 
             mBillboardType == BBT_ORIENTED_COMMON ||
             mBillboardType == BBT_ORIENTED_SELF))
         {
             // cam -> bb direction
-            mCamDir = bb->mPosition - mCamPos;
-            mCamDir.normalise();
+            camDir = bb->mPosition - mCamPos;
+            camDir.normalise();
         }
 
 
@@ -781,9 +864,9 @@ namespace Ogre {
                 // Point billboards will have 'up' based on but not equal to cameras
                 // Use pY temporarily to avoid allocation
                 *pY = mCamQ * Vector3::UNIT_Y;
-                *pX = mCamDir.crossProduct(*pY);
+                *pX = camDir.crossProduct(*pY);
                 pX->normalise();
-                *pY = pX->crossProduct(mCamDir); // both normalised already
+                *pY = pX->crossProduct(camDir); // both normalised already
             }
             else
             {
@@ -797,7 +880,7 @@ namespace Ogre {
             // Y-axis is common direction
             // X-axis is cross with camera direction
             *pY = mCommonDirection;
-            *pX = mCamDir.crossProduct(*pY);
+            *pX = camDir.crossProduct(*pY);
             pX->normalise();
             break;
 
@@ -806,7 +889,7 @@ namespace Ogre {
             // X-axis is cross with camera direction
             // Scale direction first
             *pY = bb->mDirection;
-            *pX = mCamDir.crossProduct(*pY);
+            *pX = camDir.crossProduct(*pY);
             pX->normalise();
             break;
 
@@ -833,19 +916,19 @@ namespace Ogre {
         return SceneManager::FX_TYPE_MASK;
     }
     //-----------------------------------------------------------------------
-    void BillboardSet::genPointVertices(const Billboard& bb)
+    void BillboardSet::genPointVertices(const Billboard& bb, float*& pDest) const
     {
         RGBA colour = bb.mColour;
         // Single vertex per billboard, ignore offsets
         // position
-        *mLockPtr++ = bb.mPosition.x;
-        *mLockPtr++ = bb.mPosition.y;
-        *mLockPtr++ = bb.mPosition.z;
+        *pDest++ = bb.mPosition.x;
+        *pDest++ = bb.mPosition.y;
+        *pDest++ = bb.mPosition.z;
         // Colour
-        memcpy(mLockPtr++, &colour, sizeof(RGBA));
+        memcpy(pDest++, &colour, sizeof(RGBA));
         // No texture coords in point rendering
     }
-    void BillboardSet::genQuadVertices(const Vector3* const offsets, const Billboard& bb)
+    void BillboardSet::genQuadVertices(const Vector3* const offsets, const Billboard& bb, float*& pDest) const
     {
         RGBA colour = bb.mColour;
 
@@ -858,47 +941,47 @@ namespace Ogre {
         {
             // Left-top
             // Positions
-            *mLockPtr++ = offsets[0].x + bb.mPosition.x;
-            *mLockPtr++ = offsets[0].y + bb.mPosition.y;
-            *mLockPtr++ = offsets[0].z + bb.mPosition.z;
+            *pDest++ = offsets[0].x + bb.mPosition.x;
+            *pDest++ = offsets[0].y + bb.mPosition.y;
+            *pDest++ = offsets[0].z + bb.mPosition.z;
             // Colour
-            memcpy(mLockPtr++, &colour, sizeof(RGBA));
+            memcpy(pDest++, &colour, sizeof(RGBA));
             // Texture coords
-            *mLockPtr++ = r.left;
-            *mLockPtr++ = r.top;
+            *pDest++ = r.left;
+            *pDest++ = r.top;
 
             // Right-top
             // Positions
-            *mLockPtr++ = offsets[1].x + bb.mPosition.x;
-            *mLockPtr++ = offsets[1].y + bb.mPosition.y;
-            *mLockPtr++ = offsets[1].z + bb.mPosition.z;
+            *pDest++ = offsets[1].x + bb.mPosition.x;
+            *pDest++ = offsets[1].y + bb.mPosition.y;
+            *pDest++ = offsets[1].z + bb.mPosition.z;
             // Colour
-            memcpy(mLockPtr++, &colour, sizeof(RGBA));
+            memcpy(pDest++, &colour, sizeof(RGBA));
             // Texture coords
-            *mLockPtr++ = r.right;
-            *mLockPtr++ = r.top;
+            *pDest++ = r.right;
+            *pDest++ = r.top;
 
             // Left-bottom
             // Positions
-            *mLockPtr++ = offsets[2].x + bb.mPosition.x;
-            *mLockPtr++ = offsets[2].y + bb.mPosition.y;
-            *mLockPtr++ = offsets[2].z + bb.mPosition.z;
+            *pDest++ = offsets[2].x + bb.mPosition.x;
+            *pDest++ = offsets[2].y + bb.mPosition.y;
+            *pDest++ = offsets[2].z + bb.mPosition.z;
             // Colour
-            memcpy(mLockPtr++, &colour, sizeof(RGBA));
+            memcpy(pDest++, &colour, sizeof(RGBA));
             // Texture coords
-            *mLockPtr++ = r.left;
-            *mLockPtr++ = r.bottom;
+            *pDest++ = r.left;
+            *pDest++ = r.bottom;
 
             // Right-bottom
             // Positions
-            *mLockPtr++ = offsets[3].x + bb.mPosition.x;
-            *mLockPtr++ = offsets[3].y + bb.mPosition.y;
-            *mLockPtr++ = offsets[3].z + bb.mPosition.z;
+            *pDest++ = offsets[3].x + bb.mPosition.x;
+            *pDest++ = offsets[3].y + bb.mPosition.y;
+            *pDest++ = offsets[3].z + bb.mPosition.z;
             // Colour
-            memcpy(mLockPtr++, &colour, sizeof(RGBA));
+            memcpy(pDest++, &colour, sizeof(RGBA));
             // Texture coords
-            *mLockPtr++ = r.right;
-            *mLockPtr++ = r.bottom;
+            *pDest++ = r.right;
+            *pDest++ = r.bottom;
         }
         else if (mRotationType == BBR_VERTEX)
         {
@@ -913,50 +996,50 @@ namespace Ogre {
             // Left-top
             // Positions
             pt = rotation * offsets[0];
-            *mLockPtr++ = pt.x + bb.mPosition.x;
-            *mLockPtr++ = pt.y + bb.mPosition.y;
-            *mLockPtr++ = pt.z + bb.mPosition.z;
+            *pDest++ = pt.x + bb.mPosition.x;
+            *pDest++ = pt.y + bb.mPosition.y;
+            *pDest++ = pt.z + bb.mPosition.z;
             // Colour
-            memcpy(mLockPtr++, &colour, sizeof(RGBA));
+            memcpy(pDest++, &colour, sizeof(RGBA));
             // Texture coords
-            *mLockPtr++ = r.left;
-            *mLockPtr++ = r.top;
+            *pDest++ = r.left;
+            *pDest++ = r.top;
 
             // Right-top
             // Positions
             pt = rotation * offsets[1];
-            *mLockPtr++ = pt.x + bb.mPosition.x;
-            *mLockPtr++ = pt.y + bb.mPosition.y;
-            *mLockPtr++ = pt.z + bb.mPosition.z;
+            *pDest++ = pt.x + bb.mPosition.x;
+            *pDest++ = pt.y + bb.mPosition.y;
+            *pDest++ = pt.z + bb.mPosition.z;
             // Colour
-            memcpy(mLockPtr++, &colour, sizeof(RGBA));
+            memcpy(pDest++, &colour, sizeof(RGBA));
             // Texture coords
-            *mLockPtr++ = r.right;
-            *mLockPtr++ = r.top;
+            *pDest++ = r.right;
+            *pDest++ = r.top;
 
             // Left-bottom
             // Positions
             pt = rotation * offsets[2];
-            *mLockPtr++ = pt.x + bb.mPosition.x;
-            *mLockPtr++ = pt.y + bb.mPosition.y;
-            *mLockPtr++ = pt.z + bb.mPosition.z;
+            *pDest++ = pt.x + bb.mPosition.x;
+            *pDest++ = pt.y + bb.mPosition.y;
+            *pDest++ = pt.z + bb.mPosition.z;
             // Colour
-            memcpy(mLockPtr++, &colour, sizeof(RGBA));
+            memcpy(pDest++, &colour, sizeof(RGBA));
             // Texture coords
-            *mLockPtr++ = r.left;
-            *mLockPtr++ = r.bottom;
+            *pDest++ = r.left;
+            *pDest++ = r.bottom;
 
             // Right-bottom
             // Positions
             pt = rotation * offsets[3];
-            *mLockPtr++ = pt.x + bb.mPosition.x;
-            *mLockPtr++ = pt.y + bb.mPosition.y;
-            *mLockPtr++ = pt.z + bb.mPosition.z;
+            *pDest++ = pt.x + bb.mPosition.x;
+            *pDest++ = pt.y + bb.mPosition.y;
+            *pDest++ = pt.z + bb.mPosition.z;
             // Colour
-            memcpy(mLockPtr++, &colour, sizeof(RGBA));
+            memcpy(pDest++, &colour, sizeof(RGBA));
             // Texture coords
-            *mLockPtr++ = r.right;
-            *mLockPtr++ = r.bottom;
+            *pDest++ = r.right;
+            *pDest++ = r.bottom;
         }
         else
         {
@@ -975,47 +1058,47 @@ namespace Ogre {
 
             // Left-top
             // Positions
-            *mLockPtr++ = offsets[0].x + bb.mPosition.x;
-            *mLockPtr++ = offsets[0].y + bb.mPosition.y;
-            *mLockPtr++ = offsets[0].z + bb.mPosition.z;
+            *pDest++ = offsets[0].x + bb.mPosition.x;
+            *pDest++ = offsets[0].y + bb.mPosition.y;
+            *pDest++ = offsets[0].z + bb.mPosition.z;
             // Colour
-            memcpy(mLockPtr++, &colour, sizeof(RGBA));
+            memcpy(pDest++, &colour, sizeof(RGBA));
             // Texture coords
-            *mLockPtr++ = mid_u - cos_rot_w + sin_rot_h;
-            *mLockPtr++ = mid_v - sin_rot_w - cos_rot_h;
+            *pDest++ = mid_u - cos_rot_w + sin_rot_h;
+            *pDest++ = mid_v - sin_rot_w - cos_rot_h;
 
             // Right-top
             // Positions
-            *mLockPtr++ = offsets[1].x + bb.mPosition.x;
-            *mLockPtr++ = offsets[1].y + bb.mPosition.y;
-            *mLockPtr++ = offsets[1].z + bb.mPosition.z;
+            *pDest++ = offsets[1].x + bb.mPosition.x;
+            *pDest++ = offsets[1].y + bb.mPosition.y;
+            *pDest++ = offsets[1].z + bb.mPosition.z;
             // Colour
-            memcpy(mLockPtr++, &colour, sizeof(RGBA));
+            memcpy(pDest++, &colour, sizeof(RGBA));
             // Texture coords
-            *mLockPtr++ = mid_u + cos_rot_w + sin_rot_h;
-            *mLockPtr++ = mid_v + sin_rot_w - cos_rot_h;
+            *pDest++ = mid_u + cos_rot_w + sin_rot_h;
+            *pDest++ = mid_v + sin_rot_w - cos_rot_h;
 
             // Left-bottom
             // Positions
-            *mLockPtr++ = offsets[2].x + bb.mPosition.x;
-            *mLockPtr++ = offsets[2].y + bb.mPosition.y;
-            *mLockPtr++ = offsets[2].z + bb.mPosition.z;
+            *pDest++ = offsets[2].x + bb.mPosition.x;
+            *pDest++ = offsets[2].y + bb.mPosition.y;
+            *pDest++ = offsets[2].z + bb.mPosition.z;
             // Colour
-            memcpy(mLockPtr++, &colour, sizeof(RGBA));
+            memcpy(pDest++, &colour, sizeof(RGBA));
             // Texture coords
-            *mLockPtr++ = mid_u - cos_rot_w - sin_rot_h;
-            *mLockPtr++ = mid_v - sin_rot_w + cos_rot_h;
+            *pDest++ = mid_u - cos_rot_w - sin_rot_h;
+            *pDest++ = mid_v - sin_rot_w + cos_rot_h;
 
             // Right-bottom
             // Positions
-            *mLockPtr++ = offsets[3].x + bb.mPosition.x;
-            *mLockPtr++ = offsets[3].y + bb.mPosition.y;
-            *mLockPtr++ = offsets[3].z + bb.mPosition.z;
+            *pDest++ = offsets[3].x + bb.mPosition.x;
+            *pDest++ = offsets[3].y + bb.mPosition.y;
+            *pDest++ = offsets[3].z + bb.mPosition.z;
             // Colour
-            memcpy(mLockPtr++, &colour, sizeof(RGBA));
+            memcpy(pDest++, &colour, sizeof(RGBA));
             // Texture coords
-            *mLockPtr++ = mid_u + cos_rot_w - sin_rot_h;
-            *mLockPtr++ = mid_v + sin_rot_w + cos_rot_h;
+            *pDest++ = mid_u + cos_rot_w - sin_rot_h;
+            *pDest++ = mid_v + sin_rot_w + cos_rot_h;
         }
     }
     //-----------------------------------------------------------------------
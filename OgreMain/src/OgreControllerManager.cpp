@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include "OgreControllerManager.h"
 
 #include "OgrePredefinedControllers.h"
+#include "OgreWorkQueue.h"
 
 namespace Ogre {
     //-----------------------------------------------------------------------
@@ -46,6 +47,7 @@ namespace Ogre {
         : mFrameTimeController(OGRE_NEW FrameTimeControllerValue())
         , mPassthroughFunction(OGRE_NEW PassthroughControllerFunction())
         , mLastFrameNumber(0)
+        , mParallelUpdates(false)
     {
 
     }
@@ -77,8 +79,26 @@ namespace Ogre {
         unsigned long thisFrameNumber = Root::getSingleton().getNextFrameNumber();
         if (thisFrameNumber != mLastFrameNumber)
         {
-            auto controllersCopy = mControllers;
-            for (auto *ci : controllersCopy)
+            // iterate over a copy, as updates may create or destroy controllers
+            mSerialControllers.clear();
+            mParallelControllers.clear();
+            if (mParallelUpdates)
+            {
+                for (auto *ci : mControllers)
+                {
+                    if (ci->getSource() == mFrameTimeController && !ci->getUpdateOnMainThread())
+                        mParallelControllers.push_back({ci->getUpdateGroup(), mParallelControllers.size(), ci});
+                    else
+                        mSerialControllers.push_back(ci);
+                }
+                updateParallel();
+            }
+            else
+            {
+                mSerialControllers.assign(mControllers.begin(), mControllers.end());
+            }
+
+            for (auto *ci : mSerialControllers)
             {
                 ci->update();
             }
@@ -86,6 +106,30 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------
+    void ControllerManager::updateParallel(void)
+    {
+        static const size_t BATCH_SIZE = 256;
+
+        // keep the groups together, in creation order
+        std::sort(mParallelControllers.begin(), mParallelControllers.end());
+
+        // close a batch at the first group boundary after BATCH_SIZE controllers
+        mParallelBatches.clear();
+        mParallelBatches.push_back(0);
+        for (size_t i = 1; i < mParallelControllers.size(); ++i)
+        {
+            if (i - mParallelBatches.back() >= BATCH_SIZE &&
+                mParallelControllers[i].group != mParallelControllers[i - 1].group)
+                mParallelBatches.push_back(i);
+        }
+        mParallelBatches.push_back(mParallelControllers.size());
+
+        Root::getSingleton().getWorkQueue()->parallelFor(mParallelBatches.size() - 1, [this](size_t batch) {
+            for (size_t i = mParallelBatches[batch]; i < mParallelBatches[batch + 1]; ++i)
+                mParallelControllers[i].controller->update();
+        });
+    }
+    //-----------------------------------------------------------------------
     void ControllerManager::clearControllers(void)
     {
         for (auto *ci : mControllers)
@@ -107,12 +151,16 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     ControllerFloat* ControllerManager::createTextureAnimator(TextureUnitState* layer, Real sequenceTime)
     {
-        return createController(mFrameTimeController, TextureFrameControllerValue::create(layer),
-                                AnimationControllerFunction::create(sequenceTime));
+        // changing the frame may dirty the pass hash, so group by pass
+        ControllerFloat* ret = createController(mFrameTimeController, TextureFrameControllerValue::create(layer),
+                                                AnimationControllerFunction::create(sequenceTime));
+        ret->setUpdateGroup(layer->getParent());
+        return ret;
     }
     //-----------------------------------------------------------------------
     ControllerFloat* ControllerManager::createTextureUVScroller(TextureUnitState* layer, Real speed)
     {
+        // the texture modifiers below all write the texture matrix of the layer, so group by layer
         ControllerFloat* ret = 0;
 
         if (speed != 0)
@@ -121,6 +169,7 @@ namespace Ogre {
             // Create function: use -speed since we're altering texture coords so they have reverse effect
             ret = createController(mFrameTimeController, TexCoordModifierControllerValue::create(layer, true, true),
                                    ScaleControllerFunction::create(-speed, true));
+            ret->setUpdateGroup(layer);
         }
 
         return ret;
@@ -135,6 +184,7 @@ namespace Ogre {
             // Create function: use -speed since we're altering texture coords so they have reverse effect
             ret = createController(mFrameTimeController, TexCoordModifierControllerValue::create(layer, true),
                                    ScaleControllerFunction::create(-uSpeed, true));
+            ret->setUpdateGroup(layer);
         }
 
         return ret;
@@ -150,6 +200,7 @@ namespace Ogre {
             // Create function: use -speed since we're altering texture coords so they have reverse effect
             ret = createController(mFrameTimeController, TexCoordModifierControllerValue::create(layer, false, true),
                                    ScaleControllerFunction::create(-vSpeed, true));
+            ret->setUpdateGroup(layer);
         }
 
         return ret;
@@ -160,9 +211,11 @@ namespace Ogre {
         // Target value is texture coord rotation
         // Function is simple scale (seconds * speed)
         // Use -speed since altering texture coords has the reverse visible effect
-        return createController(mFrameTimeController,
-                                TexCoordModifierControllerValue::create(layer, false, false, false, false, true),
-                                ScaleControllerFunction::create(-speed, true));
+        ControllerFloat* ret = createController(
+            mFrameTimeController, TexCoordModifierControllerValue::create(layer, false, false, false, false, true),
+            ScaleControllerFunction::create(-speed, true));
+        ret->setUpdateGroup(layer);
+        return ret;
     }
     //-----------------------------------------------------------------------
     ControllerFloat* ControllerManager::createTextureWaveTransformer(TextureUnitState* layer,
@@ -194,15 +247,22 @@ namespace Ogre {
             break;
         }
         // Create new wave function for alterations
-        return createController(mFrameTimeController, val,
-                                WaveformControllerFunction::create(waveType, base, frequency, phase, amplitude, true));
+        ControllerFloat* ret = createController(
+            mFrameTimeController, val,
+            WaveformControllerFunction::create(waveType, base, frequency, phase, amplitude, true));
+        ret->setUpdateGroup(layer);
+        return ret;
     }
     //-----------------------------------------------------------------------
     ControllerFloat* ControllerManager::createGpuProgramTimerParam(
         GpuProgramParametersSharedPtr params, size_t paramIndex, Real timeFactor)
     {
-        return createController(mFrameTimeController, FloatGpuParameterControllerValue::create(params, paramIndex),
-                                ScaleControllerFunction::create(timeFactor, true));
+        // the parameters may be shared with other controllers and track their dirty range
+        ControllerFloat* ret =
+            createController(mFrameTimeController, FloatGpuParameterControllerValue::create(params, paramIndex),
+                             ScaleControllerFunction::create(timeFactor, true));
+        ret->setUpdateGroup(params.get());
+        return ret;
     }
     //-----------------------------------------------------------------------
     void ControllerManager::destroyController(ControllerFloat* controller)
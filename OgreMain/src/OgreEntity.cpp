@@ -1269,6 +1269,39 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------
+    bool Entity::_prepareSkeletonUpdate(void)
+    {
+        if (!mInitialised || !hasSkeleton())
+            return false;
+
+        // Same dirty test as updateAnimation, skipping poses already evaluated this frame
+        bool animationDirty =
+            (mFrameAnimationLastUpdated != mAnimationState->getDirtyFrameNumber()) ||
+            getSkeleton()->getManualBonesDirty();
+        if (!animationDirty || *mFrameBonesLastUpdated == Root::getSingleton().getNextFrameNumber())
+            return false;
+
+        // Tag points notify the parent scene node when the bones move
+        if (!mChildObjectList.empty())
+            return false;
+        if (mSharedSkeletonEntities)
+        {
+            for (auto *e : *mSharedSkeletonEntities)
+            {
+                if (!e->mChildObjectList.empty())
+                    return false;
+            }
+        }
+
+        // Animations are shared between skeleton instances, build their lazy data now
+        for (auto *state : mAnimationState->getEnabledAnimationStates())
+        {
+            if (Animation* anim = mSkeletonInstance->_getAnimationImpl(state->getAnimationName()))
+                anim->_prepareForSampling();
+        }
+        return true;
+    }
+    //-----------------------------------------------------------------------
     bool Entity::_isAnimated(void) const
     {
         return (mAnimationState && mAnimationState->hasEnabledAnimationState()) ||
@@ -1306,9 +1339,19 @@ namespace Ogre {
         if ((*mFrameBonesLastUpdated != currentFrameNumber) ||
             (hasSkeleton() && getSkeleton()->getManualBonesDirty()))
         {
-            if ((!mSkipAnimStateUpdates) && (*mFrameBonesLastUpdated != currentFrameNumber))
-                mSkeletonInstance->setAnimationState(*mAnimationState);
-            mSkeletonInstance->_getBoneMatrices(mBoneMatrices);
+            bool updateAnimState = (!mSkipAnimStateUpdates) && (*mFrameBonesLastUpdated != currentFrameNumber);
+            // the flat path leaves the bone nodes alone, so only use it when nothing reads them
+            if (updateAnimState && mChildObjectList.empty() && !mUpdateBoundingBoxFromSkeleton &&
+                !mDisplaySkeleton)
+            {
+                mSkeletonInstance->_getBoneMatrices(*mAnimationState, mBoneMatrices);
+            }
+            else
+            {
+                if (updateAnimState)
+                    mSkeletonInstance->setAnimationState(*mAnimationState);
+                mSkeletonInstance->_getBoneMatrices(mBoneMatrices);
+            }
             *mFrameBonesLastUpdated  = currentFrameNumber;
 
             return true;
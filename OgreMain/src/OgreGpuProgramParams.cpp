@@ -323,6 +323,7 @@ namespace Ogre
     GpuSharedParameters::GpuSharedParameters(const String& name)
         :mName(name)
         , mVersion(0), mOffset(0), mDirty(false)
+        , mDirtyBegin(0), mDirtyEnd(std::numeric_limits<size_t>::max())
     {
 
     }
@@ -398,6 +399,8 @@ namespace Ogre
 
         mNamedConstants.map[name] = def;
 
+        mDirtyBegin = 0;
+        mDirtyEnd = std::numeric_limits<size_t>::max();
         ++mVersion;
     }
     //---------------------------------------------------------------------
@@ -436,19 +439,30 @@ namespace Ogre
                 //TODO exception handling
             }
 
+            mDirtyBegin = 0;
+            mDirtyEnd = std::numeric_limits<size_t>::max();
             ++mVersion;
         }
 
     }
 
-    void GpuSharedParameters::_upload() const
+    size_t GpuSharedParameters::_upload(bool partialUpload) const
     {
         OgreAssert(mHardwareBuffer, "not backed by a HardwareBuffer");
 
-        if (!mDirty)
-            return;
+        size_t begin = mDirtyBegin;
+        size_t end = std::min(mDirtyEnd, mConstants.size());
+        if (!mDirty || begin >= end)
+            return 0;
 
-        mHardwareBuffer->writeData(0, mConstants.size(), mConstants.data());
+        if (!partialUpload)
+        {
+            begin = 0;
+            end = mConstants.size();
+        }
+
+        mHardwareBuffer->writeData(begin, end - begin, &mConstants[begin], begin == 0 && end == mConstants.size());
+        return end - begin;
     }
     void GpuSharedParameters::download()
     {
@@ -462,6 +476,8 @@ namespace Ogre
         mNamedConstants.map.clear();
         mNamedConstants.bufferSize = 0;
         mConstants.clear();
+        mDirtyBegin = 0;
+        mDirtyEnd = std::numeric_limits<size_t>::max();
     }
     //---------------------------------------------------------------------
     GpuConstantDefinitionIterator GpuSharedParameters::getConstantDefinitionIterator(void) const
@@ -508,8 +524,12 @@ namespace Ogre
             return; // ignore
 
         const GpuConstantDefinition& def = i->second;
-        memcpy(&mConstants[def.physicalIndex], val, sizeof(float) * std::min(count, def.elementSize * def.arraySize));
-        _markDirty();
+        size_t bytes = sizeof(float) * std::min(count, def.elementSize * def.arraySize);
+        memcpy(&mConstants[def.physicalIndex], val, bytes);
+
+        mDirty = true;
+        mDirtyBegin = std::min(mDirtyBegin, def.physicalIndex);
+        mDirtyEnd = std::max(mDirtyEnd, def.physicalIndex + bytes);
     }
     void GpuSharedParameters::setNamedConstant(const String& name, const float* val, uint32 count)
     {
@@ -534,11 +554,15 @@ namespace Ogre
     void GpuSharedParameters::_markClean()
     {
         mDirty = false;
+        mDirtyBegin = std::numeric_limits<size_t>::max();
+        mDirtyEnd = 0;
     }
     //---------------------------------------------------------------------
     void GpuSharedParameters::_markDirty()
     {
         mDirty = true;
+        mDirtyBegin = 0;
+        mDirtyEnd = std::numeric_limits<size_t>::max();
     }
     
 
@@ -596,10 +620,15 @@ namespace Ogre
 
         for (const CopyDataEntry& e : mCopyDataList)
         {
+            // only the copied range needs to be uploaded again
+            mParams->_markDirty(e.dstDefinition->physicalIndex,
+                                (e.dstDefinition->isDouble() ? sizeof(double) : sizeof(float)) *
+                                    e.dstDefinition->elementSize * e.dstDefinition->arraySize);
+
             if (e.dstDefinition->isFloat())
             {
                 const float* pSrc = sharedParams->getFloatPointer(e.srcDefinition->physicalIndex);
-                float* pDst = mParams->getFloatPointer(e.dstDefinition->physicalIndex);
+                float* pDst = (float*)&mParams->mConstants[e.dstDefinition->physicalIndex];
 
                 // Deal with matrix transposition here!!!
                 // transposition is specific to the dest param set, shared params don't do it
@@ -642,7 +671,7 @@ namespace Ogre
             else if (e.dstDefinition->isDouble())
             {
                 const double* pSrc = sharedParams->getDoublePointer(e.srcDefinition->physicalIndex);
-                double* pDst = mParams->getDoublePointer(e.dstDefinition->physicalIndex);
+                double* pDst = (double*)&mParams->mConstants[e.dstDefinition->physicalIndex];
 
                 // Deal with matrix transposition here!!!
                 // transposition is specific to the dest param set, shared params don't do it
@@ -685,7 +714,7 @@ namespace Ogre
             else if (e.dstDefinition->isInt())
             {
                 const int* pSrc = sharedParams->getIntPointer(e.srcDefinition->physicalIndex);
-                int* pDst = mParams->getIntPointer(e.dstDefinition->physicalIndex);
+                int* pDst = (int*)&mParams->mConstants[e.dstDefinition->physicalIndex];
 
                 if (e.dstDefinition->elementSize == e.srcDefinition->elementSize)
                 {
@@ -711,7 +740,7 @@ namespace Ogre
             else if (e.dstDefinition->isUnsignedInt() || e.dstDefinition->isBool()) 
             {
                 const uint* pSrc = sharedParams->getUnsignedIntPointer(e.srcDefinition->physicalIndex);
-                uint* pDst = mParams->getUnsignedIntPointer(e.dstDefinition->physicalIndex);
+                uint* pDst = (uint*)&mParams->mConstants[e.dstDefinition->physicalIndex];
 
                 if (e.dstDefinition->elementSize == e.srcDefinition->elementSize)
                 {
@@ -747,6 +776,9 @@ namespace Ogre
     //-----------------------------------------------------------------------------
     GpuProgramParameters::GpuProgramParameters() :
         mCombinedVariability(GPV_GLOBAL)
+        , mDirtyBegin(0)
+        , mDirtyEnd(std::numeric_limits<size_t>::max())
+        , mAutoConstantPlanDirty(true)
         , mTransposeMatrices(false)
         , mIgnoreMissingParams(false)
         , mActivePassIterationIndex(std::numeric_limits<size_t>::max())
@@ -776,6 +808,8 @@ namespace Ogre
         copySharedParamSetUsage(oth.mSharedParamSets);
 
         mCombinedVariability = oth.mCombinedVariability;
+        mAutoConstantPlanDirty = true;
+        _markDirty();
         mTransposeMatrices = oth.mTransposeMatrices;
         mIgnoreMissingParams  = oth.mIgnoreMissingParams;
         mActivePassIterationIndex = oth.mActivePassIterationIndex;
@@ -819,6 +853,7 @@ namespace Ogre
         if (namedConstants->bufferSize*4 > mConstants.size())
         {
             mConstants.insert(mConstants.end(), namedConstants->bufferSize * 4 - mConstants.size(), 0);
+            _markDirty();
         }
 
         if(namedConstants->registerCount > mRegisters.size())
@@ -837,6 +872,7 @@ namespace Ogre
         if (indexMap && indexMap->bufferSize*4 > mConstants.size())
         {
             mConstants.insert(mConstants.end(), indexMap->bufferSize * 4 - mConstants.size(), 0);
+            _markDirty();
         }
     }
     //---------------------------------------------------------------------()
@@ -1016,6 +1052,7 @@ namespace Ogre
             float tmp = val[i];
             memcpy(&mConstants[physicalIndex + i * sizeof(float)], &tmp, sizeof(float));
         }
+        _markDirty(physicalIndex, sizeof(float) * count);
     }
     void GpuProgramParameters::_writeRegisters(size_t index, const int* val, size_t count)
     {
@@ -1218,6 +1255,7 @@ namespace Ogre
 
                 // Expand at buffer end
                 mConstants.insert(mConstants.end(), requestedSize*4, 0);
+                _markDirty(physicalIndex, requestedSize*4);
 
                 // Record extended size for future GPU params re-using this information
                 mLogicalToPhysical->bufferSize = mConstants.size()/4;
@@ -1263,6 +1301,7 @@ namespace Ogre
                 auto insertPos = mConstants.begin();
                 std::advance(insertPos, physicalIndex);
                 mConstants.insert(insertPos, insertCount*4, 0);
+                _markDirty(); // everything after insertPos moved
 
                 // shift all physical positions after this one
                 for (auto& p : mLogicalToPhysical->map)
@@ -1434,6 +1473,7 @@ namespace Ogre
             mAutoConstants.push_back(AutoConstantEntry(acType, physicalIndex, extraInfo, variability, elementSize));
 
         mCombinedVariability |= variability;
+        mAutoConstantPlanDirty = true;
 
 
     }
@@ -1459,6 +1499,7 @@ namespace Ogre
             mAutoConstants.push_back(AutoConstantEntry(acType, physicalIndex, rData, variability, elementSize));
 
         mCombinedVariability |= variability;
+        mAutoConstantPlanDirty = true;
     }
     //-----------------------------------------------------------------------------
     void GpuProgramParameters::clearAutoConstant(size_t index)
@@ -1477,6 +1518,7 @@ namespace Ogre
                 if (i->physicalIndex == physicalIndex)
                 {
                     mAutoConstants.erase(i);
+                    mAutoConstantPlanDirty = true;
                     break;
                 }
             }
@@ -1498,6 +1540,7 @@ namespace Ogre
                     if (i->physicalIndex == def->physicalIndex)
                     {
                         mAutoConstants.erase(i);
+                        mAutoConstantPlanDirty = true;
                         break;
                     }
                 }
@@ -1509,6 +1552,7 @@ namespace Ogre
     {
         mAutoConstants.clear();
         mCombinedVariability = GPV_GLOBAL;
+        mAutoConstantPlanDirty = true;
     }
     //-----------------------------------------------------------------------------
     void GpuProgramParameters::setAutoConstantReal(size_t index, AutoConstantType acType, float rData)
@@ -1534,6 +1578,30 @@ namespace Ogre
     }
     //-----------------------------------------------------------------------------
 
+    //-----------------------------------------------------------------------------
+    void GpuProgramParameters::buildAutoConstantPlan()
+    {
+        mAutoConstantPlan.resize(mAutoConstants.size());
+        for (uint32 i = 0; i < mAutoConstantPlan.size(); ++i)
+            mAutoConstantPlan[i] = i;
+
+        // keep the declaration order within a group
+        std::stable_sort(mAutoConstantPlan.begin(), mAutoConstantPlan.end(),
+                         [this](uint32 a, uint32 b) {
+                             return mAutoConstants[a].variability < mAutoConstants[b].variability;
+                         });
+
+        mAutoConstantGroups.clear();
+        for (uint32 i = 0; i < mAutoConstantPlan.size(); ++i)
+        {
+            uint16 variability = mAutoConstants[mAutoConstantPlan[i]].variability;
+            if (mAutoConstantGroups.empty() || mAutoConstantGroups.back().first != variability)
+                mAutoConstantGroups.push_back(std::make_pair(variability, i));
+            mAutoConstantGroups.back().second = i + 1;
+        }
+
+        mAutoConstantPlanDirty = false;
+    }
     //-----------------------------------------------------------------------------
     void GpuProgramParameters::_updateAutoParams(const AutoParamDataSource* source, uint16 mask)
     {
@@ -1543,6 +1611,9 @@ namespace Ogre
         if (!(mask & mCombinedVariability))
             return;
 
+        if (mAutoConstantPlanDirty)
+            buildAutoConstantPlan();
+
         size_t index;
         size_t numMatrices;
         const Affine3* pMatrix;
@@ -1556,11 +1627,19 @@ namespace Ogre
         mActivePassIterationIndex = std::numeric_limits<size_t>::max();
 
         // Autoconstant index is not a physical index
-        for (const auto& ac : mAutoConstants)
+        uint32 planPos = 0;
+        for (const auto& group : mAutoConstantGroups)
         {
-            // Only update needed slots
-            if (ac.variability & mask)
+            // Only update needed slots, the rest of the group is skipped at once
+            if (!(group.first & mask))
+            {
+                planPos = group.second;
+                continue;
+            }
+
+            for (; planPos < group.second; ++planPos)
             {
+                const AutoConstantEntry& ac = mAutoConstants[mAutoConstantPlan[planPos]];
 
                 switch(ac.paramType)
                 {
@@ -2400,6 +2479,8 @@ namespace Ogre
     {
         if (index < mAutoConstants.size())
         {
+            // the caller may change the variability
+            mAutoConstantPlanDirty = true;
             return &(mAutoConstants[index]);
         }
         else
@@ -2458,6 +2539,8 @@ namespace Ogre
         mRegisters = source.mRegisters;
         mAutoConstants = source.getAutoConstantList();
         mCombinedVariability = source.mCombinedVariability;
+        mAutoConstantPlanDirty = true;
+        _markDirty();
         copySharedParamSetUsage(source.mSharedParamSets);
     }
     //---------------------------------------------------------------------
@@ -2578,7 +2661,8 @@ namespace Ogre
         if (mActivePassIterationIndex != std::numeric_limits<size_t>::max())
         {
             // This is a physical index
-            *getFloatPointer(mActivePassIterationIndex) += 1;
+            *(float*)&mConstants[mActivePassIterationIndex] += 1;
+            _markDirty(mActivePassIterationIndex, sizeof(float));
         }
     }
     //---------------------------------------------------------------------
@@ -2637,19 +2721,21 @@ namespace Ogre
         }
     }
 
-    void GpuProgramParameters::_updateSharedParams()
+    size_t GpuProgramParameters::_updateSharedParams(bool partialUpload)
     {
+        size_t uploaded = 0;
         for (auto& usage : mSharedParamSets)
         {
             const GpuSharedParametersPtr& sharedParams = usage.getSharedParams();
             if(sharedParams->_getHardwareBuffer())
             {
-                sharedParams->_upload();
+                uploaded += sharedParams->_upload(partialUpload);
                 sharedParams->_markClean();
                 continue;
             }
 
             usage._copySharedParamsToTargetParams();
         }
+        return uploaded;
     }
 }
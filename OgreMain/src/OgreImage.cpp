@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include "OgreImage.h"
 #include "OgreImageCodec.h"
 #include "OgreImageResampler.h"
+#include "OgreWorkQueue.h"
 
 namespace Ogre {
     //-----------------------------------------------------------------------------
@@ -386,6 +387,31 @@ namespace Ogre {
         Image::scale(temp.getPixelBox(), getPixelBox(), filter);
     }
     //-----------------------------------------------------------------------
+    /// destination pixels per job when a resample is spread across the WorkQueue
+    static const size_t RESAMPLE_BAND_PIXELS = 16384;
+
+    template <typename Resampler> static void resample(const PixelBox& src, const PixelBox& dst)
+    {
+        size_t rows = dst.getHeight();
+        if (rows == 0 || dst.getWidth() == 0 || dst.getDepth() == 0)
+            return; // nothing to resample
+
+        size_t rowsPerBand = std::max<size_t>(1, RESAMPLE_BAND_PIXELS / (dst.getWidth() * dst.getDepth()));
+        Root* root = Root::getSingletonPtr();
+        if (!root || rows <= rowsPerBand)
+        {
+            Resampler::scale(src, dst, 0, rows);
+            return;
+        }
+
+        // bands write disjoint destination rows and only read the source
+        size_t numBands = (rows + rowsPerBand - 1) / rowsPerBand;
+        root->getWorkQueue()->parallelFor(numBands, [&](size_t band) {
+            size_t begin = band * rowsPerBand;
+            Resampler::scale(src, dst, begin, std::min(begin + rowsPerBand, rows));
+        });
+    }
+    //-----------------------------------------------------------------------
     void Image::scale(const PixelBox &src, const PixelBox &scaled, Filter filter) 
     {
         assert(PixelUtil::isAccessible(src.format));
@@ -406,14 +432,14 @@ namespace Ogre {
             // super-optimized: no conversion
             switch (PixelUtil::getNumElemBytes(src.format)) 
             {
-            case 1: NearestResampler<1>::scale(src, temp); break;
-            case 2: NearestResampler<2>::scale(src, temp); break;
-            case 3: NearestResampler<3>::scale(src, temp); break;
-            case 4: NearestResampler<4>::scale(src, temp); break;
-            case 6: NearestResampler<6>::scale(src, temp); break;
-            case 8: NearestResampler<8>::scale(src, temp); break;
-            case 12: NearestResampler<12>::scale(src, temp); break;
-            case 16: NearestResampler<16>::scale(src, temp); break;
+            case 1: resample<NearestResampler<1>>(src, temp); break;
+            case 2: resample<NearestResampler<2>>(src, temp); break;
+            case 3: resample<NearestResampler<3>>(src, temp); break;
+            case 4: resample<NearestResampler<4>>(src, temp); break;
+            case 6: resample<NearestResampler<6>>(src, temp); break;
+            case 8: resample<NearestResampler<8>>(src, temp); break;
+            case 12: resample<NearestResampler<12>>(src, temp); break;
+            case 16: resample<NearestResampler<16>>(src, temp); break;
             default:
                 // never reached
                 assert(false);
@@ -425,6 +451,9 @@ namespace Ogre {
             }
             break;
 
+        case FILTER_BOX:
+        case FILTER_KAISER:
+            // only generateMipmaps implements these
         case FILTER_BILINEAR:
             switch (src.format) 
             {
@@ -442,10 +471,10 @@ namespace Ogre {
                 // super-optimized: byte-oriented math, no conversion
                 switch (PixelUtil::getNumElemBytes(src.format)) 
                 {
-                case 1: LinearResampler_Byte<1>::scale(src, temp); break;
-                case 2: LinearResampler_Byte<2>::scale(src, temp); break;
-                case 3: LinearResampler_Byte<3>::scale(src, temp); break;
-                case 4: LinearResampler_Byte<4>::scale(src, temp); break;
+                case 1: resample<LinearResampler_Byte<1>>(src, temp); break;
+                case 2: resample<LinearResampler_Byte<2>>(src, temp); break;
+                case 3: resample<LinearResampler_Byte<3>>(src, temp); break;
+                case 4: resample<LinearResampler_Byte<4>>(src, temp); break;
                 default:
                     // never reached
                     assert(false);
@@ -461,18 +490,259 @@ namespace Ogre {
                 if (scaled.format == PF_FLOAT32_RGB || scaled.format == PF_FLOAT32_RGBA)
                 {
                     // float32 to float32, avoid unpack/repack overhead
-                    LinearResampler_Float32::scale(src, scaled);
+                    resample<LinearResampler_Float32>(src, scaled);
                     break;
                 }
                 // else, fall through
             default:
                 // non-optimized: floating-point math, performs conversion but always works
-                LinearResampler::scale(src, scaled);
+                resample<LinearResampler>(src, scaled);
             }
             break;
         }
     }
 
+    //-----------------------------------------------------------------------------
+    /// source pixel and its weight, contributing to one destination pixel along one axis
+    struct MipTap
+    {
+        uint32 index;
+        float weight;
+    };
+    typedef std::vector<std::vector<MipTap>> MipTaps;
+
+    static float besselI0(float x)
+    {
+        // power series, converges quickly for the small arguments used by the Kaiser window
+        float sum = 1, term = 1;
+        for (int k = 1; k < 16; k++)
+        {
+            term *= (x * x / 4) / (k * k);
+            sum += term;
+        }
+        return sum;
+    }
+
+    static MipTaps computeMipTaps(uint32 srcSize, uint32 dstSize, Image::Filter filter)
+    {
+        // Kaiser window support in destination pixels, and its shape parameter
+        const float KAISER_RADIUS = 1.5f, KAISER_ALPHA = 4.0f;
+
+        MipTaps taps(dstSize);
+        float scale = float(srcSize) / dstSize;
+        for (uint32 x = 0; x < dstSize; x++)
+        {
+            auto& t = taps[x];
+            float centre = (x + 0.5f) * scale;
+            if (srcSize == dstSize || filter == Image::FILTER_NEAREST)
+            {
+                t.push_back({std::min(uint32(centre), srcSize - 1), 1.0f});
+                continue;
+            }
+
+            if (filter == Image::FILTER_KAISER)
+            {
+                int first = int(std::floor(centre - KAISER_RADIUS * scale));
+                int last = int(std::ceil(centre + KAISER_RADIUS * scale));
+                for (int i = first; i <= last; i++)
+                {
+                    float d = (i + 0.5f - centre) / scale;
+                    if (std::abs(d) >= KAISER_RADIUS)
+                        continue;
+                    float sinc = d == 0 ? 1.0f : std::sin(Math::PI * d) / (Math::PI * d);
+                    float r = d / KAISER_RADIUS;
+                    float window = besselI0(KAISER_ALPHA * std::sqrt(1 - r * r)) / besselI0(KAISER_ALPHA);
+                    // clamp to edge
+                    uint32 index = uint32(Math::Clamp(i, 0, int(srcSize) - 1));
+                    if (!t.empty() && t.back().index == index)
+                        t.back().weight += sinc * window;
+                    else
+                        t.push_back({index, sinc * window});
+                }
+            }
+            else
+            {
+                // box: weight by how much of each source pixel the footprint covers
+                float begin = x * scale, end = begin + scale;
+                for (uint32 i = uint32(begin); i < std::min(uint32(std::ceil(end)), srcSize); i++)
+                {
+                    float w = std::min(end, i + 1.0f) - std::max(begin, float(i));
+                    if (w > 0)
+                        t.push_back({i, w});
+                }
+            }
+
+            float sum = 0;
+            for (const auto& tap : t)
+                sum += tap.weight;
+            for (auto& tap : t)
+                tap.weight /= sum;
+        }
+        return taps;
+    }
+
+    static float srgbToLinear(float c)
+    {
+        return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+    }
+
+    static float linearToSrgb(float c)
+    {
+        return c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1 / 2.4f) - 0.055f;
+    }
+
+    Image& Image::generateMipmaps(bool gammaCorrected, Filter filter)
+    {
+        OgreAssert(mBuffer, "No image data loaded");
+        OgreAssert(!PixelUtil::isCompressed(mFormat), "compressed formats are not supported");
+
+        if (mNumMipmaps == 0)
+        {
+            uint32 numMips = Bitwise::mostSignificantBitSet(std::max(mWidth, std::max(mHeight, mDepth)));
+            if (numMips == 0)
+                return *this;
+
+            Image chain;
+            chain.create(mFormat, mWidth, mHeight, mDepth, getNumFaces(), numMips);
+            for (uint32 face = 0; face < getNumFaces(); face++)
+                PixelUtil::bulkPixelConversion(getPixelBox(face), chain.getPixelBox(face));
+
+            // take over the buffer of chain
+            chain.mAutoDelete = false;
+            loadDynamicImage(chain.mBuffer, mWidth, mHeight, mDepth, mFormat, true, getNumFaces(), numMips);
+        }
+
+        // 8 bit sRGB values are decoded through a table, everything else through pow
+        static const std::vector<float> srgbTable = []() {
+            std::vector<float> table(256);
+            for (int i = 0; i < 256; i++)
+                table[i] = srgbToLinear(i / 255.0f);
+            return table;
+        }();
+        bool decodeByTable = PixelUtil::getComponentType(mFormat) == PCT_BYTE;
+
+        uint32 numFaces = getNumFaces();
+        // previous level of each face as linear FLOAT32_RGBA, level 0 is read from the image itself
+        std::vector<std::vector<float>> prevLevels(numFaces), nextLevels(numFaces);
+
+        Root* root = Root::getSingletonPtr();
+        for (uint32 mip = 1; mip <= mNumMipmaps; mip++)
+        {
+            PixelBox src = getPixelBox(0, mip - 1), dst = getPixelBox(0, mip);
+            uint32 sw = src.getWidth(), sh = src.getHeight(), sd = src.getDepth();
+            uint32 dw = dst.getWidth(), dh = dst.getHeight(), dd = dst.getDepth();
+            bool lastLevel = mip == mNumMipmaps;
+
+            MipTaps tapsX = computeMipTaps(sw, dw, filter);
+            MipTaps tapsY = computeMipTaps(sh, dh, filter);
+            MipTaps tapsZ = computeMipTaps(sd, dd, filter);
+
+            if (!lastLevel)
+            {
+                for (auto& level : nextLevels)
+                    level.resize(size_t(dw) * dh * dd * 4);
+            }
+
+            // a job is a band of destination rows in one slice of one face
+            uint32 rowsPerBand = std::max<uint32>(1, 16384 / dw);
+            uint32 bandsPerSlice = (dh + rowsPerBand - 1) / rowsPerBand;
+            auto job = [&](size_t index) {
+                uint32 band = uint32(index % bandsPerSlice);
+                uint32 z = uint32(index / bandsPerSlice % dd);
+                uint32 face = uint32(index / bandsPerSlice / dd);
+                uint32 y0 = band * rowsPerBand, y1 = std::min(y0 + rowsPerBand, dh);
+
+                PixelBox srcBox = mip == 1 ? getPixelBox(face, 0)
+                                           : PixelBox(sw, sh, sd, PF_FLOAT32_RGBA, prevLevels[face].data());
+                bool decode = gammaCorrected && mip == 1;
+
+                uint32 syMin = sh, syMax = 0;
+                for (uint32 y = y0; y < y1; y++)
+                {
+                    syMin = std::min(syMin, tapsY[y].front().index);
+                    syMax = std::max(syMax, tapsY[y].back().index);
+                }
+
+                std::vector<float> srcRow(size_t(sw) * 4), filtered(size_t(syMax - syMin + 1) * dw * 4);
+                std::vector<float> out(size_t(y1 - y0) * dw * 4, 0.0f);
+                for (const auto& tz : tapsZ[z])
+                {
+                    // horizontal pass over every source row the band needs
+                    for (uint32 sy = syMin; sy <= syMax; sy++)
+                    {
+                        PixelUtil::bulkPixelConversion(srcBox.getSubVolume(Box(0, sy, tz.index, sw, sy + 1, tz.index + 1)),
+                                                       PixelBox(sw, 1, 1, PF_FLOAT32_RGBA, srcRow.data()));
+                        if (decode)
+                        {
+                            for (size_t i = 0; i < srcRow.size(); i++)
+                            {
+                                if (i % 4 == 3)
+                                    continue;
+                                srcRow[i] = decodeByTable ? srgbTable[int(srcRow[i] * 255 + 0.5f)] : srgbToLinear(srcRow[i]);
+                            }
+                        }
+
+                        float* pFiltered = &filtered[size_t(sy - syMin) * dw * 4];
+                        for (uint32 x = 0; x < dw; x++)
+                        {
+                            float accum[4] = {0, 0, 0, 0};
+                            for (const auto& tx : tapsX[x])
+                            {
+                                const float* p = &srcRow[tx.index * 4];
+                                for (int c = 0; c < 4; c++)
+                                    accum[c] += p[c] * tx.weight;
+                            }
+                            memcpy(pFiltered + x * 4, accum, sizeof(accum));
+                        }
+                    }
+
+                    // vertical pass, weighted by the depth tap
+                    for (uint32 y = y0; y < y1; y++)
+                    {
+                        float* pOut = &out[size_t(y - y0) * dw * 4];
+                        for (const auto& ty : tapsY[y])
+                        {
+                            const float* p = &filtered[size_t(ty.index - syMin) * dw * 4];
+                            float w = ty.weight * tz.weight;
+                            for (size_t i = 0; i < size_t(dw) * 4; i++)
+                                pOut[i] += p[i] * w;
+                        }
+                    }
+                }
+
+                PixelBox dstBox = getPixelBox(face, mip);
+                for (uint32 y = y0; y < y1; y++)
+                {
+                    float* pOut = &out[size_t(y - y0) * dw * 4];
+                    if (!lastLevel)
+                        memcpy(&nextLevels[face][(size_t(z) * dh + y) * dw * 4], pOut, size_t(dw) * 4 * sizeof(float));
+                    if (gammaCorrected)
+                    {
+                        for (size_t i = 0; i < size_t(dw) * 4; i++)
+                        {
+                            if (i % 4 != 3)
+                                pOut[i] = linearToSrgb(std::max(pOut[i], 0.0f));
+                        }
+                    }
+                    PixelUtil::bulkPixelConversion(PixelBox(dw, 1, 1, PF_FLOAT32_RGBA, pOut),
+                                                   dstBox.getSubVolume(Box(0, y, z, dw, y + 1, z + 1)));
+                }
+            };
+
+            size_t numJobs = size_t(numFaces) * dd * bandsPerSlice;
+            if (root)
+                root->getWorkQueue()->parallelFor(numJobs, job);
+            else
+            {
+                for (size_t i = 0; i < numJobs; i++)
+                    job(i);
+            }
+
+            std::swap(prevLevels, nextLevels);
+        }
+
+        return *this;
+    }
     //-----------------------------------------------------------------------------    
 
     ColourValue Image::getColourAt(uint32 x, uint32 y, uint32 z) const
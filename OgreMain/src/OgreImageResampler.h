@@ -29,6 +29,7 @@ THE SOFTWARE.
 #define OGREIMAGERESAMPLER_H
 
 #include <algorithm>
+#include <vector>
 
 // this file is inlined into OgreImage.cpp!
 // do not include anywhere else.
@@ -47,17 +48,20 @@ namespace Ogre {
 // sx2 = upper-bound integer x-position in source
 // sxf = fractional weight between sx1 and sx2
 // x,y,z = location of output pixel in destination
+//
+// every resampler only writes destination rows [rowBegin, rowEnd) of each
+// slice, so Image::scale can hand disjoint row bands to separate threads
 
 // nearest-neighbor resampler, does not convert formats.
 // templated on bytes-per-pixel to allow compiler optimizations, such
 // as simplifying memcpy() and replacing multiplies with bitshifts
 template<unsigned int elemsize> struct NearestResampler {
-    static void scale(const PixelBox& src, const PixelBox& dst) {
+    static void scale(const PixelBox& src, const PixelBox& dst, size_t rowBegin, size_t rowEnd) {
         // assert(src.format == dst.format);
 
-        // srcdata stays at beginning, pdst is a moving pointer
+        // srcdata and dstdata stay at beginning, pdst is a moving pointer
         uchar* srcdata = (uchar*)src.getTopLeftFrontPixelPtr();
-        uchar* pdst = (uchar*)dst.getTopLeftFrontPixelPtr();
+        uchar* dstdata = (uchar*)dst.getTopLeftFrontPixelPtr();
 
         // sx_48,sy_48,sz_48 represent current position in source
         // using 16/48-bit fixed precision, incremented by steps
@@ -68,23 +72,22 @@ template<unsigned int elemsize> struct NearestResampler {
         // note: ((stepz>>1) - 1) is an extra half-step increment to adjust
         // for the center of the destination pixel, not the top-left corner
         uint64 sz_48 = (stepz >> 1) - 1;
-        for (size_t z = dst.front; z < dst.back; z++, sz_48 += stepz) {
+        for (size_t z = 0; z < dst.getDepth(); z++, sz_48 += stepz) {
             size_t srczoff = (size_t)(sz_48 >> 48) * src.slicePitch;
             
-            uint64 sy_48 = (stepy >> 1) - 1;
-            for (size_t y = dst.top; y < dst.bottom; y++, sy_48 += stepy) {
+            uint64 sy_48 = (stepy >> 1) - 1 + rowBegin * stepy;
+            for (size_t y = rowBegin; y < rowEnd; y++, sy_48 += stepy) {
                 size_t srcyoff = (size_t)(sy_48 >> 48) * src.rowPitch;
+                uchar* pdst = dstdata + elemsize*(z*dst.slicePitch + y*dst.rowPitch);
             
                 uint64 sx_48 = (stepx >> 1) - 1;
-                for (size_t x = dst.left; x < dst.right; x++, sx_48 += stepx) {
+                for (size_t x = 0; x < dst.getWidth(); x++, sx_48 += stepx) {
                     uchar* psrc = srcdata +
                         elemsize*((size_t)(sx_48 >> 48) + srcyoff + srczoff);
                     memcpy(pdst, psrc, elemsize);
                     pdst += elemsize;
                 }
-                pdst += elemsize*dst.getRowSkip();
             }
-            pdst += elemsize*dst.getSliceSkip();
         }
     }
 };
@@ -92,13 +95,13 @@ template<unsigned int elemsize> struct NearestResampler {
 
 // default floating-point linear resampler, does format conversion
 struct LinearResampler {
-    static void scale(const PixelBox& src, const PixelBox& dst) {
+    static void scale(const PixelBox& src, const PixelBox& dst, size_t rowBegin, size_t rowEnd) {
         size_t srcelemsize = PixelUtil::getNumElemBytes(src.format);
         size_t dstelemsize = PixelUtil::getNumElemBytes(dst.format);
 
-        // srcdata stays at beginning, pdst is a moving pointer
+        // srcdata and dstdata stay at beginning, pdst is a moving pointer
         uchar* srcdata = (uchar*)src.getTopLeftFrontPixelPtr();
-        uchar* pdst = (uchar*)dst.getTopLeftFrontPixelPtr();
+        uchar* dstdata = (uchar*)dst.getTopLeftFrontPixelPtr();
         
         // sx_48,sy_48,sz_48 represent current position in source
         // using 16/48-bit fixed precision, incremented by steps
@@ -109,7 +112,7 @@ struct LinearResampler {
         // note: ((stepz>>1) - 1) is an extra half-step increment to adjust
         // for the center of the destination pixel, not the top-left corner
         uint64 sz_48 = (stepz >> 1) - 1;
-        for (size_t z = dst.front; z < dst.back; z++, sz_48+=stepz) {
+        for (size_t z = 0; z < dst.getDepth(); z++, sz_48+=stepz) {
             // temp is 16/16 bit fixed precision, used to adjust a source
             // coordinate (x, y, or z) backwards by half a pixel so that the
             // integer bits represent the first sample (eg, sx1) and the
@@ -121,16 +124,17 @@ struct LinearResampler {
             uint32 sz2 = std::min(sz1+1,src.getDepth()-1);// src z, sample #2
             float szf = (temp & 0xFFFF) / 65536.f; // weight of sample #2
 
-            uint64 sy_48 = (stepy >> 1) - 1;
-            for (size_t y = dst.top; y < dst.bottom; y++, sy_48+=stepy) {
+            uint64 sy_48 = (stepy >> 1) - 1 + rowBegin * stepy;
+            for (size_t y = rowBegin; y < rowEnd; y++, sy_48+=stepy) {
                 temp = static_cast<unsigned int>(sy_48 >> 32);
                 temp = (temp > 0x8000)? temp - 0x8000 : 0;
                 uint32 sy1 = temp >> 16;                    // src y #1
                 uint32 sy2 = std::min(sy1+1,src.getHeight()-1);// src y #2
                 float syf = (temp & 0xFFFF) / 65536.f; // weight of #2
-                
+                uchar* pdst = dstdata + dstelemsize*(z*dst.slicePitch + y*dst.rowPitch);
+
                 uint64 sx_48 = (stepx >> 1) - 1;
-                for (size_t x = dst.left; x < dst.right; x++, sx_48+=stepx) {
+                for (size_t x = 0; x < dst.getWidth(); x++, sx_48+=stepx) {
                     temp = static_cast<unsigned int>(sx_48 >> 32);
                     temp = (temp > 0x8000)? temp - 0x8000 : 0;
                     uint32 sx1 = temp >> 16;                    // src x #1
@@ -163,9 +167,7 @@ struct LinearResampler {
 
                     pdst += dstelemsize;
                 }
-                pdst += dstelemsize*dst.getRowSkip();
             }
-            pdst += dstelemsize*dst.getSliceSkip();
         }
     }
 };
@@ -174,15 +176,15 @@ struct LinearResampler {
 // float32 linear resampler, converts FLOAT32_RGB/FLOAT32_RGBA only.
 // avoids overhead of pixel unpack/repack function calls
 struct LinearResampler_Float32 {
-    static void scale(const PixelBox& src, const PixelBox& dst) {
+    static void scale(const PixelBox& src, const PixelBox& dst, size_t rowBegin, size_t rowEnd) {
         size_t srcchannels = PixelUtil::getNumElemBytes(src.format) / sizeof(float);
         size_t dstchannels = PixelUtil::getNumElemBytes(dst.format) / sizeof(float);
         // assert(srcchannels == 3 || srcchannels == 4);
         // assert(dstchannels == 3 || dstchannels == 4);
 
-        // srcdata stays at beginning, pdst is a moving pointer
+        // srcdata and dstdata stay at beginning, pdst is a moving pointer
         float* srcdata = (float*)src.getTopLeftFrontPixelPtr();
-        float* pdst = (float*)dst.getTopLeftFrontPixelPtr();
+        float* dstdata = (float*)dst.getTopLeftFrontPixelPtr();
         
         // sx_48,sy_48,sz_48 represent current position in source
         // using 16/48-bit fixed precision, incremented by steps
@@ -193,7 +195,7 @@ struct LinearResampler_Float32 {
         // note: ((stepz>>1) - 1) is an extra half-step increment to adjust
         // for the center of the destination pixel, not the top-left corner
         uint64 sz_48 = (stepz >> 1) - 1;
-        for (size_t z = dst.front; z < dst.back; z++, sz_48+=stepz) {
+        for (size_t z = 0; z < dst.getDepth(); z++, sz_48+=stepz) {
             // temp is 16/16 bit fixed precision, used to adjust a source
             // coordinate (x, y, or z) backwards by half a pixel so that the
             // integer bits represent the first sample (eg, sx1) and the
@@ -205,16 +207,17 @@ struct LinearResampler_Float32 {
             uint32 sz2 = std::min(sz1+1,src.getDepth()-1);// src z, sample #2
             float szf = (temp & 0xFFFF) / 65536.f; // weight of sample #2
 
-            uint64 sy_48 = (stepy >> 1) - 1;
-            for (size_t y = dst.top; y < dst.bottom; y++, sy_48+=stepy) {
+            uint64 sy_48 = (stepy >> 1) - 1 + rowBegin * stepy;
+            for (size_t y = rowBegin; y < rowEnd; y++, sy_48+=stepy) {
                 temp = static_cast<unsigned int>(sy_48 >> 32);
                 temp = (temp > 0x8000)? temp - 0x8000 : 0;
                 uint32 sy1 = temp >> 16;                    // src y #1
                 uint32 sy2 = std::min(sy1+1,src.getHeight()-1);// src y #2
                 float syf = (temp & 0xFFFF) / 65536.f; // weight of #2
-                
+                float* pdst = dstdata + dstchannels*(z*dst.slicePitch + y*dst.rowPitch);
+
                 uint64 sx_48 = (stepx >> 1) - 1;
-                for (size_t x = dst.left; x < dst.right; x++, sx_48+=stepx) {
+                for (size_t x = 0; x < dst.getWidth(); x++, sx_48+=stepx) {
                     temp = static_cast<unsigned int>(sx_48 >> 32);
                     temp = (temp > 0x8000)? temp - 0x8000 : 0;
                     uint32 sx1 = temp >> 16;                    // src x #1
@@ -266,9 +269,7 @@ struct LinearResampler_Float32 {
 
                     pdst += dstchannels;
                 }
-                pdst += dstchannels*dst.getRowSkip();
             }
-            pdst += dstchannels*dst.getSliceSkip();
         }
     }
 };
@@ -281,59 +282,69 @@ struct LinearResampler_Float32 {
 // templated on bytes-per-pixel to allow compiler optimizations, such
 // as unrolling loops and replacing multiplies with bitshifts
 template<unsigned int channels> struct LinearResampler_Byte {
-    static void scale(const PixelBox& src, const PixelBox& dst) {
+    static void scale(const PixelBox& src, const PixelBox& dst, size_t rowBegin, size_t rowEnd) {
         // assert(src.format == dst.format);
 
         // only optimized for 2D
         if (src.getDepth() > 1 || dst.getDepth() > 1) {
-            LinearResampler::scale(src, dst);
+            LinearResampler::scale(src, dst, rowBegin, rowEnd);
             return;
         }
 
-        // srcdata stays at beginning of slice, pdst is a moving pointer
+        // srcdata and dstdata stay at beginning of slice, pdst is a moving pointer
         uchar* srcdata = (uchar*)src.getTopLeftFrontPixelPtr();
-        uchar* pdst = (uchar*)dst.getTopLeftFrontPixelPtr();
+        uchar* dstdata = (uchar*)dst.getTopLeftFrontPixelPtr();
 
         // sx_48,sy_48 represent current position in source
         // using 16/48-bit fixed precision, incremented by steps
         uint64 stepx = ((uint64)src.getWidth() << 48) / dst.getWidth();
         uint64 stepy = ((uint64)src.getHeight() << 48) / dst.getHeight();
-        
-        uint64 sy_48 = (stepy >> 1) - 1;
-        for (size_t y = dst.top; y < dst.bottom; y++, sy_48+=stepy) {
+
+        // the horizontal sample positions are the same for every row, so resolve
+        // them once up front and keep the per-pixel loop free of fixed-point stepping
+        struct Column { size_t off1, off2; unsigned int sxf; };
+        std::vector<Column> columns(dst.getWidth());
+        uint64 sx_48 = (stepx >> 1) - 1;
+        for (size_t x = 0; x < columns.size(); x++, sx_48+=stepx) {
             // bottom 28 bits of temp are 16/12 bit fixed precision, used to
             // adjust a source coordinate backwards by half a pixel so that the
             // integer bits represent the first sample (eg, sx1) and the
             // fractional bits are the blend weight of the second sample
+            unsigned int temp = static_cast<unsigned int>(sx_48 >> 36);
+            temp = (temp > 0x800)? temp - 0x800 : 0;
+            uint32 sx1 = temp >> 12;
+            uint32 sx2 = std::min(sx1+1, src.right-src.left-1);
+            columns[x].off1 = sx1 * channels;
+            columns[x].off2 = sx2 * channels;
+            columns[x].sxf = temp & 0xFFF;
+        }
+
+        uint64 sy_48 = (stepy >> 1) - 1 + rowBegin * stepy;
+        for (size_t y = rowBegin; y < rowEnd; y++, sy_48+=stepy) {
             unsigned int temp = static_cast<unsigned int>(sy_48 >> 36);
             temp = (temp > 0x800)? temp - 0x800: 0;
             unsigned int syf = temp & 0xFFF;
             uint32 sy1 = temp >> 12;
             uint32 sy2 = std::min(sy1+1, src.bottom-src.top-1);
-            size_t syoff1 = sy1 * src.rowPitch;
-            size_t syoff2 = sy2 * src.rowPitch;
-
-            uint64 sx_48 = (stepx >> 1) - 1;
-            for (size_t x = dst.left; x < dst.right; x++, sx_48+=stepx) {
-                temp = static_cast<unsigned int>(sx_48 >> 36);
-                temp = (temp > 0x800)? temp - 0x800 : 0;
-                unsigned int sxf = temp & 0xFFF;
-                uint32 sx1 = temp >> 12;
-                uint32 sx2 = std::min(sx1+1, src.right-src.left-1);
+            const uchar* srcrow1 = srcdata + sy1 * src.rowPitch * channels;
+            const uchar* srcrow2 = srcdata + sy2 * src.rowPitch * channels;
+            uchar* pdst = dstdata + y * dst.rowPitch * channels;
 
+            for (const Column& c : columns) {
+                unsigned int sxf = c.sxf;
                 unsigned int sxfsyf = sxf*syf;
+                unsigned int w11 = 0x1000000-(sxf<<12)-(syf<<12)+sxfsyf;
+                unsigned int w21 = (sxf<<12)-sxfsyf;
+                unsigned int w12 = (syf<<12)-sxfsyf;
                 for (unsigned int k = 0; k < channels; k++) {
                     unsigned int accum =
-                        srcdata[(sx1 + syoff1)*channels+k]*(0x1000000-(sxf<<12)-(syf<<12)+sxfsyf) +
-                        srcdata[(sx2 + syoff1)*channels+k]*((sxf<<12)-sxfsyf) +
-                        srcdata[(sx1 + syoff2)*channels+k]*((syf<<12)-sxfsyf) +
-                        srcdata[(sx2 + syoff2)*channels+k]*sxfsyf;
+                        srcrow1[c.off1+k]*w11 + srcrow1[c.off2+k]*w21 +
+                        srcrow2[c.off1+k]*w12 + srcrow2[c.off2+k]*sxfsyf;
                     // accum is computed using 8/24-bit fixed-point math
                     // (maximum is 0xFF000000; rounding will not cause overflow)
                     *pdst++ = static_cast<uchar>((accum + 0x800000) >> 24);
                 }
             }
-            pdst += channels*dst.getRowSkip();
         }
     }
 };
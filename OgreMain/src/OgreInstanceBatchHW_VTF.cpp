@@ -220,7 +220,7 @@ namespace Ogre
         //Now create the instance buffer that will be incremented per instance, contains UV offsets
         newSource = thisVertexData->vertexDeclaration->getMaxSource() + 1;
         offset = thisVertexData->vertexDeclaration->addElement( newSource, 0, VET_FLOAT2, VES_TEXTURE_COORDINATES,thisVertexData->vertexDeclaration->getNextFreeTextureCoordinate() ).getSize();
-        if (useBoneMatrixLookup())
+        if (useBoneMatrixLookup() || useBakedAnimation())
         {
             //if using bone matrix lookup we will need to add 3 more float4 to contain the matrix. containing
             //the personal world transform of each entity.
@@ -253,7 +253,9 @@ namespace Ogre
     size_t InstanceBatchHW_VTF::updateInstanceDataBuffer(bool isFirstTime, Camera* currentCamera)
     {
         size_t visibleEntityCount = 0;
-        bool useMatrixLookup = useBoneMatrixLookup();
+        //Baked animation uses the same per instance data, with the pose as lookup number
+        bool useBaked = useBakedAnimation();
+        bool useMatrixLookup = useBoneMatrixLookup() || useBaked;
         if (isFirstTime ^ useMatrixLookup)
         {
             //update the mTransformLookupNumber value in the entities if needed 
@@ -285,7 +287,8 @@ namespace Ogre
                     //and static mode).
                     (entity->findVisible(currentCamera)))
                 {
-                    size_t matrixIndex = useMatrixLookup ? entity->mTransformLookupNumber : i;
+                    size_t matrixIndex = useBaked ? getBakedPoseIndex( entity->getAllAnimationStates() ) :
+                                         useMatrixLookup ? entity->mTransformLookupNumber : i;
                     size_t instanceIdx = matrixIndex * mMatricesPerInstance * mRowLength;
                     *thisVec = ((instanceIdx % maxPixelsPerLine) / texWidth) - (float)(texelOffsets.x);
                     *(thisVec + 1) = ((instanceIdx / maxPixelsPerLine) / texHeight) - (float)(texelOffsets.y);
@@ -331,7 +334,7 @@ namespace Ogre
     {
         //Max number of texture coordinates is _usually_ 8, we need at least 2 available
         unsigned short neededTextureCoord = 2;
-        if (useBoneMatrixLookup())
+        if (useBoneMatrixLookup() || useBakedAnimation())
         {
             //we need another 3 for the unique world transform of each instanced entity
             neededTextureCoord += 3;
@@ -369,6 +372,10 @@ namespace Ogre
             //See InstanceBatchHW::calculateMaxNumInstances for the 65535
             retVal = std::min<size_t>( 65535, maxUsableWidth * c_maxTexHeightHW / mRowLength / numBones );
 
+            //The baked texture holds poses, not instances
+            if( flags & IM_VTFBAKEDANIMATION )
+                return 65535;
+
             if( flags & IM_VTFBESTFIT )
             {
                 size_t numUsedSkeletons = mInstancesPerBatch;
@@ -394,6 +401,15 @@ namespace Ogre
     size_t InstanceBatchHW_VTF::updateVertexTexture( Camera *currentCamera )
     {
         size_t renderedInstances = 0;
+
+        if (useBakedAnimation())
+        {
+            //The bone matrices are already in the baked texture, only the poses and world
+            //transforms in the instance buffer change
+            mDirtyAnimation = false;
+            return updateInstanceDataBuffer(false, currentCamera);
+        }
+
         bool useMatrixLookup = useBoneMatrixLookup();
         if (useMatrixLookup)
         {
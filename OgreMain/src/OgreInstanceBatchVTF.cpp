@@ -31,6 +31,9 @@ THE SOFTWARE.
 #include "OgreInstancedEntity.h"
 #include "OgreMaterial.h"
 #include "OgreDualQuaternion.h"
+#include "OgreInstanceManager.h"
+#include "OgreSkeletonInstance.h"
+#include "OgreAnimation.h"
 
 namespace Ogre
 {
@@ -53,7 +56,10 @@ namespace Ogre
                 mMaxLookupTableInstances(16),
                 mUseBoneDualQuaternions(false),
                 mForceOneWeight(false),
-                mUseOneWeight(false)
+                mUseOneWeight(false),
+                mUseBakedAnimation(false),
+                mBakedAnimationRate(30),
+                mNumBakedPoses(0)
     {
         cloneMaterial( mMaterial );
     }
@@ -73,8 +79,8 @@ namespace Ogre
         //Remove cloned material
         MaterialManager::getSingleton().remove( mMaterial );
 
-        //Remove the VTF texture
-        if( mMatrixTexture )
+        //Remove the VTF texture. The baked animation texture is shared, the InstanceManager owns it
+        if( mMatrixTexture && !mUseBakedAnimation )
             TextureManager::getSingleton().remove( mMatrixTexture );
 
         delete[] mTempTransformsArray3x4;
@@ -83,7 +89,7 @@ namespace Ogre
     //-----------------------------------------------------------------------
     void BaseInstanceBatchVTF::buildFrom( const SubMesh *baseSubMesh, const RenderOperation &renderOperation )
     {
-        if (useBoneMatrixLookup())
+        if (useBoneMatrixLookup() || useBakedAnimation())
         {
             //when using bone matrix lookup resource are not shared
             //
@@ -236,6 +242,11 @@ namespace Ogre
         {
             uniqueAnimations = std::min<size_t>(getMaxLookupTableInstances(), uniqueAnimations);
         }
+        if (useBakedAnimation())
+        {
+            planBakedAnimation();
+            uniqueAnimations = mNumBakedPoses;
+        }
         mMatricesPerInstance = std::max<size_t>( 1, baseSubMesh->blendIndexToBoneIndexMap.size() );
 
         if(mUseBoneDualQuaternions && !mTempTransformsArray3x4)
@@ -276,6 +287,31 @@ namespace Ogre
         //Don't use 1D textures, as OGL goes crazy because the shader should be calling texture1D()...
         TextureType texType = TEX_TYPE_2D;
 
+        if( useBakedAnimation() )
+        {
+            if( texHeight > c_maxTexHeight )
+            {
+                OGRE_EXCEPT( Exception::ERR_INVALIDPARAMS, "Baked animations of '" +
+                             mMeshReference->getName() + "' don't fit in the vertex texture. "
+                             "Lower the baked animation rate", "BaseInstanceBatchVTF::createVertexTexture" );
+            }
+
+            //All batches of the same manager share the same baked texture (the layout is the same)
+            const String bakedName = mCreator->getName() + "/BakedAnimation";
+            mMatrixTexture = TextureManager::getSingleton().getByName( bakedName, mMeshReference->getGroup() );
+            if( !mMatrixTexture )
+            {
+                mMatrixTexture = TextureManager::getSingleton().createManual(
+                                        bakedName, mMeshReference->getGroup(), texType,
+                                        (uint)texWidth, (uint)texHeight,
+                                        0, PF_FLOAT32_RGBA, TU_STATIC_WRITE_ONLY );
+                OgreAssert(mMatrixTexture->getFormat() == PF_FLOAT32_RGBA, "float texture support required");
+                bakeAnimationTexture();
+            }
+            setupMaterialToUseVTF( texType, mMaterial );
+            return;
+        }
+
         mMatrixTexture = TextureManager::getSingleton().createManual(
                                         mName + "/VTF", mMeshReference->getGroup(), texType,
                                         (uint)texWidth, (uint)texHeight,
@@ -286,6 +322,122 @@ namespace Ogre
         setupMaterialToUseVTF( texType, mMaterial );
     }
 
+    //-----------------------------------------------------------------------
+    void BaseInstanceBatchVTF::planBakedAnimation()
+    {
+        OgreAssert( mMeshReference->hasSkeleton() && mMeshReference->getSkeleton(),
+                    "baked animation requires a skeletally animated mesh" );
+        OgreAssert( mBakedAnimationRate > 0, "baked animation rate must be positive" );
+
+        mBakedClips.clear();
+        mNumBakedPoses = 1; //The binding pose
+
+        const SkeletonPtr &skeleton = mMeshReference->getSkeleton();
+
+        //getBakedPoseIndex falls back to the binding pose for anything not baked here
+        if( !skeleton->getLinkedSkeletonAnimationSources().empty() )
+        {
+            LogManager::getSingleton().logWarning( "Baked animation of '" + mMeshReference->getName() +
+                                                   "' ignores the animations of linked skeletons, "
+                                                   "instances playing them show the binding pose" );
+        }
+
+        for( unsigned short i=0; i<skeleton->getNumAnimations(); ++i )
+        {
+            const Animation *anim = skeleton->getAnimation( i );
+
+            BakedClip clip;
+            clip.firstPose  = mNumBakedPoses;
+            clip.numPoses   = static_cast<size_t>( Math::Floor( anim->getLength() * mBakedAnimationRate ) ) + 1;
+            mBakedClips[anim->getName()] = clip;
+
+            mNumBakedPoses += clip.numPoses;
+        }
+    }
+    //-----------------------------------------------------------------------
+    void BaseInstanceBatchVTF::bakeAnimationTexture()
+    {
+        //Work on our own instance, so neither the master skeleton nor the entities are touched
+        SkeletonInstance skeleton( mMeshReference->getSkeleton() );
+        skeleton.load();
+        skeleton.setFlatPoseEvaluation( true );
+
+        AnimationStateSet animationStates;
+        skeleton._initAnimationState( &animationStates );
+
+        std::vector<Affine3> boneMatrices( skeleton.getNumBones() );
+        std::vector<Matrix3x4f> transforms( mMatricesPerInstance );
+        const Mesh::IndexMap &indexMap = *_getIndexToBoneMap();
+
+        HardwareBufferLockGuard matTexLock(mMatrixTexture->getBuffer(), HardwareBuffer::HBL_DISCARD);
+        const PixelBox &pixelBox = mMatrixTexture->getBuffer()->getCurrentLock();
+        float *pSource = reinterpret_cast<float*>(pixelBox.data);
+
+        const size_t floatPerPose = mMatricesPerInstance * mRowLength * 4;
+        const size_t posesPerPadding = mMaxFloatsPerLine / floatPerPose;
+
+        //Pose 0 is the binding pose (no enabled states), then every clip frame by frame
+        AnimationState *current = 0;
+        BakedClipMap::const_iterator itClip = mBakedClips.begin();
+        size_t frame = 0;
+        for( size_t pose=0; pose<mNumBakedPoses; ++pose )
+        {
+            if( pose > 0 )
+            {
+                if( !current || frame == itClip->second.numPoses )
+                {
+                    if( current )
+                    {
+                        current->setEnabled( false );
+                        ++itClip;
+                    }
+                    current = animationStates.getAnimationState( itClip->first );
+                    current->setEnabled( true );
+                    current->setWeight( 1 );
+                    frame = 0;
+                }
+
+                current->setTimePosition( std::min( frame / mBakedAnimationRate, current->getLength() ) );
+                ++frame;
+            }
+
+            skeleton._getBoneMatrices( animationStates, boneMatrices.data() );
+
+            size_t numMatrices = 0;
+            for( auto i : indexMap )
+                transforms[numMatrices++] = Matrix3x4f( boneMatrices[i][0] );
+
+            float *pDest = pSource + floatPerPose * pose + (pose / posesPerPadding) * mWidthFloatsPadding;
+            if( mUseBoneDualQuaternions )
+                convert3x4MatricesToDualQuaternions( transforms.data(), numMatrices, pDest );
+            else
+                memcpy( pDest, transforms.data(), numMatrices * sizeof(Matrix3x4f) );
+        }
+    }
+    //-----------------------------------------------------------------------
+    size_t BaseInstanceBatchVTF::getBakedPoseIndex( const AnimationStateSet *animationStates ) const
+    {
+        if( !animationStates )
+            return 0;
+
+        const AnimationState *best = 0;
+        for( const AnimationState *state : animationStates->getEnabledAnimationStates() )
+        {
+            if( !best || state->getWeight() > best->getWeight() )
+                best = state;
+        }
+
+        if( !best )
+            return 0;
+
+        BakedClipMap::const_iterator itor = mBakedClips.find( best->getAnimationName() );
+        if( itor == mBakedClips.end() )
+            return 0;
+
+        const size_t frame = static_cast<size_t>( std::max<Real>( 0,
+                                Math::Floor( best->getTimePosition() * mBakedAnimationRate + Real(0.5) ) ) );
+        return itor->second.firstPose + std::min( frame, itor->second.numPoses - 1 );
+    }
     //-----------------------------------------------------------------------
     size_t BaseInstanceBatchVTF::convert3x4MatricesToDualQuaternions(Matrix3x4f* matrices, size_t numOfMatrices, float* outDualQuaternions)
     {
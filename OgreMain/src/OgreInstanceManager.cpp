@@ -46,6 +46,7 @@ namespace Ogre
                 mSubMeshIdx( subMeshIdx ),
                 mSceneManager( sceneManager ),
                 mMaxLookupTableInstances(16),
+                mBakedAnimationRate(30),
                 mNumCustomParams( 0 )
     {
         mMeshReference = MeshManager::getSingleton().load( meshName, groupName );
@@ -65,6 +66,11 @@ namespace Ogre
             for (auto *it : i.second)
                 OGRE_DELETE it;
         }
+
+        //The baked animation texture is shared by all our batches
+        const String bakedName = mName + "/BakedAnimation";
+        if( TextureManager::getSingleton().resourceExists( bakedName, mMeshReference->getGroup() ) )
+            TextureManager::getSingleton().remove( bakedName, mMeshReference->getGroup() );
     }
     //----------------------------------------------------------------------
     void InstanceManager::setInstancesPerBatch( size_t instancesPerBatch )
@@ -79,6 +85,13 @@ namespace Ogre
         OgreAssert(mInstanceBatches.empty(), "can only be changed before building the batch");
         mMaxLookupTableInstances = maxLookupTableInstances;
     }
+
+    //----------------------------------------------------------------------
+    void InstanceManager::setBakedAnimationRate( Real samplesPerSecond )
+    {
+        OgreAssert(mInstanceBatches.empty(), "can only be changed before building the batch");
+        mBakedAnimationRate = samplesPerSecond;
+    }
     
     //----------------------------------------------------------------------
     void InstanceManager::setNumCustomParams( unsigned char numCustomParams )
@@ -120,6 +133,7 @@ namespace Ogre
             batch = OGRE_NEW InstanceBatchHW_VTF( this, mMeshReference, mat, suggestedSize,
                                                     0, mName + "/TempBatch" );
             static_cast<InstanceBatchHW_VTF*>(batch)->setBoneMatrixLookup((mInstancingFlags & IM_VTFBONEMATRIXLOOKUP) != 0, mMaxLookupTableInstances);
+            static_cast<InstanceBatchHW_VTF*>(batch)->setBakedAnimation((mInstancingFlags & IM_VTFBAKEDANIMATION) != 0, mBakedAnimationRate);
             static_cast<InstanceBatchHW_VTF*>(batch)->setBoneDualQuaternions((mInstancingFlags & IM_USEBONEDUALQUATERNIONS) != 0);
             static_cast<InstanceBatchHW_VTF*>(batch)->setUseOneWeight((mInstancingFlags & IM_USEONEWEIGHT) != 0);
             static_cast<InstanceBatchHW_VTF*>(batch)->setForceOneWeight((mInstancingFlags & IM_FORCEONEWEIGHT) != 0);
@@ -205,6 +219,7 @@ namespace Ogre
                                                     &idxMap, mName + "/InstanceBatch_" +
                                                     StringConverter::toString(mIdCount++) );
             static_cast<InstanceBatchHW_VTF*>(batch)->setBoneMatrixLookup((mInstancingFlags & IM_VTFBONEMATRIXLOOKUP) != 0, mMaxLookupTableInstances);
+            static_cast<InstanceBatchHW_VTF*>(batch)->setBakedAnimation((mInstancingFlags & IM_VTFBAKEDANIMATION) != 0, mBakedAnimationRate);
             static_cast<InstanceBatchHW_VTF*>(batch)->setBoneDualQuaternions((mInstancingFlags & IM_USEBONEDUALQUATERNIONS) != 0);
             static_cast<InstanceBatchHW_VTF*>(batch)->setUseOneWeight((mInstancingFlags & IM_USEONEWEIGHT) != 0);
             static_cast<InstanceBatchHW_VTF*>(batch)->setForceOneWeight((mInstancingFlags & IM_FORCEONEWEIGHT) != 0);
@@ -401,8 +401,7 @@ namespace Ogre
 
             if( animationDirty || (mNeedAnimTransformUpdate &&  mBatchOwner->useBoneWorldMatrices()))
             {
-                mSkeletonInstance->setAnimationState( *mAnimationState );
-                mSkeletonInstance->_getBoneMatrices( mBoneMatrices );
+                mSkeletonInstance->_getBoneMatrices( *mAnimationState, mBoneMatrices );
 
                 // Cache last parent transform for next frame use too.
                 if (mBatchOwner->useBoneWorldMatrices())
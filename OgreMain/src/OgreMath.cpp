@@ -47,6 +47,7 @@ namespace Ogre
     float *Math::mTanTable = NULL;
 
     Math::RandomValueProvider* Math::mRandProvider = NULL;
+    static thread_local Math::RandomValueProvider* tlsRandProvider = NULL;
 
     //-----------------------------------------------------------------------
     Math::Math( unsigned int trigTableSize )
@@ -142,6 +143,18 @@ namespace Ogre
     {
         mRandProvider = provider;
     }
+    //-----------------------------------------------------------------------
+    void Math::_setThreadRandomValueProvider(RandomValueProvider* provider)
+    {
+        tlsRandProvider = provider;
+    }
+    //-----------------------------------------------------------------------
+    float Math::UnitRandom()
+    {
+        if (tlsRandProvider)
+            return tlsRandProvider->getRandomUnit();
+        return mRandProvider ? mRandProvider->getRandomUnit() : rand() / float(RAND_MAX);
+    }
 
    //-----------------------------------------------------------------------
     void Math::setAngleUnit(Math::AngleUnit unit)
@@ -141,8 +141,31 @@ namespace Ogre {
 
         float getValue(void) const override { return 0; } // N/A
 
-        void setValue(float value) override { mTarget->_update(value); }
+        void setValue(float value) override
+        {
+            ParticleSystemManager& mgr = ParticleSystemManager::getSingleton();
+            if (mgr.getParallelUpdates())
+                mgr._queueUpdate(mTarget, value);
+            else
+                mTarget->_update(value);
+        }
+
+    };
+    /** Random sequence of a particle system (xorshift32), installed for the thread running _simulate. */
+    class ParticleSystemRandom : public Math::RandomValueProvider
+    {
+        uint32& mState;
+    public:
+        ParticleSystemRandom(uint32& state) : mState(state) { Math::_setThreadRandomValueProvider(this); }
+        ~ParticleSystemRandom() { Math::_setThreadRandomValueProvider(NULL); }
 
+        Real getRandomUnit() override
+        {
+            mState ^= mState << 13;
+            mState ^= mState >> 17;
+            mState ^= mState << 5;
+            return (mState >> 8) * (1.0f / 16777215.0f);
+        }
     };
     //-----------------------------------------------------------------------
     ParticleSystem::ParticleSystem() 
@@ -168,8 +191,11 @@ namespace Ogre {
         mRenderer(0),
         mCullIndividual(false),
         mPoolSize(0),
-        mEmittedEmitterPoolSize(0)
+        mEmittedEmitterPoolSize(0),
+        mRandomState(0),
+        mBoundsChanged(false)
     {
+        setRandomSeed(FastHash(mName.c_str(), mName.size()));
         initParameters();
 
         // Default to billboard renderer
@@ -201,8 +227,11 @@ namespace Ogre {
         mRenderer(0), 
         mCullIndividual(false),
         mPoolSize(0),
-        mEmittedEmitterPoolSize(0)
+        mEmittedEmitterPoolSize(0),
+        mRandomState(0),
+        mBoundsChanged(false)
     {
+        setRandomSeed(FastHash(mName.c_str(), mName.size()));
         setDefaultDimensions( 100, 100 );
         mMaterial = MaterialManager::getSingleton().getDefaultMaterial();
         // Default to 10 particles, expect app to specify (will only be increased, not decreased)
@@ -222,6 +251,7 @@ namespace Ogre {
             // Destroy controller
             ControllerManager::getSingleton().destroyController(mTimeController);
             mTimeController = 0;
+            ParticleSystemManager::getSingleton()._cancelUpdate(this);
         }
 
         // Arrange for the deletion of emitters & affectors
@@ -229,12 +259,6 @@ namespace Ogre {
         removeAllEmittedEmitters();
         removeAllAffectors();
 
-        // Free pool items
-        for (auto p : mParticlePool)
-        {
-            OGRE_DELETE p;
-        }
-
         if (mRenderer)
         {
             ParticleSystemManager::getSingleton()._destroyRenderer(mRenderer);
@@ -429,9 +453,18 @@ namespace Ogre {
     void ParticleSystem::_update(Real timeElapsed)
     {
         OgreProfile("ParticleSystem");
+        if (!_prepareUpdate(timeElapsed))
+            return;
+
+        simulate(timeElapsed);
+        _finishUpdate();
+    }
+    //-----------------------------------------------------------------------
+    bool ParticleSystem::_prepareUpdate(Real timeElapsed)
+    {
         // Only update if attached to a node
         if (!mParentNode)
-            return;
+            return false;
 
         Real nonvisibleTimeout = mNonvisibleTimeoutSet ?
             mNonvisibleTimeout : msDefaultNonvisibleTimeout;
@@ -447,20 +480,41 @@ namespace Ogre {
                 if (mTimeSinceLastVisible >= nonvisibleTimeout)
                 {
                     // No update
-                    return;
+                    return false;
                 }
             }
         }
 
-        // Scale incoming speed for the rest of the calculation
-        timeElapsed *= mSpeedFactor;
-
         // Init renderer if not done already
         configureRenderer();
 
         // Initialise emitted emitters list if not done already
         initialiseEmittedEmitters();
 
+        for (auto a : mAffectors)
+            a->_prepare(this);
+
+        return true;
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystem::_simulate(Real timeElapsed)
+    {
+        ParticleSystemRandom random(mRandomState);
+        simulate(timeElapsed);
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystem::_finishUpdate(void)
+    {
+        if (mBoundsChanged)
+            mParentNode->needUpdate();
+        mBoundsChanged = false;
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystem::simulate(Real timeElapsed)
+    {
+        // Scale incoming speed for the rest of the calculation
+        timeElapsed *= mSpeedFactor;
+
         Real iterationInterval = mIterationIntervalSet ? 
             mIterationInterval : msDefaultIterationInterval;
         if (iterationInterval > 0)
@@ -499,8 +553,7 @@ namespace Ogre {
 
         if (!mBoundsAutoUpdate && mBoundsUpdateTime > 0.0f)
             mBoundsUpdateTime -= timeElapsed; // count down 
-        _updateBounds();
-
+        mBoundsChanged = calculateBounds();
     }
     //-----------------------------------------------------------------------
     void ParticleSystem::_expire(Real timeElapsed)
@@ -553,8 +606,8 @@ namespace Ogre {
     {
         OgreProfile("_triggerEmitters");
         // Add up requests for emission
-        static std::vector<unsigned> requested;
-        static std::vector<unsigned> emittedRequested;
+        std::vector<unsigned>& requested = mEmitRequested;
+        std::vector<unsigned>& emittedRequested = mEmittedEmitRequested;
 
         if( requested.size() != mEmitters.size() )
             requested.resize( mEmitters.size() );
@@ -696,14 +749,18 @@ namespace Ogre {
     void ParticleSystem::increasePool(size_t size)
     {
         size_t oldSize = mParticlePool.size();
+        if (size <= oldSize)
+            return;
 
-        // Increase size
-        mParticlePool.resize(size);
+        // Create new particles in one block
+        mParticleBlocks.emplace_back(new Particle[size - oldSize]);
+        Particle* block = mParticleBlocks.back().get();
 
-        // Create new particles
-        for( size_t i = oldSize; i < size; i++ )
+        // Increase size
+        mParticlePool.reserve(size);
+        for( size_t i = 0; i < size - oldSize; i++ )
         {
-            mParticlePool[i] = OGRE_NEW Particle();
+            mParticlePool.push_back(block + i);
         }
     }
     //-----------------------------------------------------------------------
@@ -834,6 +891,12 @@ namespace Ogre {
     }
     //-----------------------------------------------------------------------
     void ParticleSystem::_updateBounds()
+    {
+        if (calculateBounds())
+            mParentNode->needUpdate();
+    }
+    //-----------------------------------------------------------------------
+    bool ParticleSystem::calculateBounds()
     {
         OgreProfile("_updateBounds");
         if (mParentNode && (mBoundsAutoUpdate || mBoundsUpdateTime > 0.0f))
@@ -896,11 +959,11 @@ namespace Ogre {
                     mAABB.merge(newAABB);
             }
 
-            mParentNode->needUpdate();
-
             if (mRenderer)
                 mRenderer->_notifyBoundingBox(mAABB);
+            return true;
         }
+        return false;
     }
     //-----------------------------------------------------------------------
     void ParticleSystem::fastForward(Real time, Real interval)
@@ -1012,6 +1075,8 @@ namespace Ogre {
             ControllerManager& mgr = ControllerManager::getSingleton(); 
             ControllerValueRealPtr updValue(OGRE_NEW ParticleSystemUpdateValue(this));
             mTimeController = mgr.createFrameTimePassthroughController(updValue);
+            // queues the system or updates it right away, neither is safe on a worker thread
+            mTimeController->setUpdateOnMainThread(true);
         }
         else if (!parent && mTimeController)
         {
@@ -1052,7 +1117,8 @@ namespace Ogre {
         // reset active and free lists
         mActiveParticles.clear();
         mFreeParticles.clear();
-        mFreeParticles.insert(mFreeParticles.end(), mParticlePool.begin(), mParticlePool.end());
+        // the free list is used as a stack, keep emission in memory order
+        mFreeParticles.insert(mFreeParticles.end(), mParticlePool.rbegin(), mParticlePool.rend());
 
         // Add active emitted emitters to free list
         addActiveEmittedEmittersToFreeList();
@@ -1089,9 +1155,9 @@ namespace Ogre {
         {
             this->increasePool(size);
 
-            // Add new items to the queue
-            mFreeParticles.insert(mFreeParticles.end(), mParticlePool.begin() + currSize,
-                                  mParticlePool.end());
+            // Add new items to the queue, in reverse as it is used as a stack
+            mFreeParticles.insert(mFreeParticles.end(), mParticlePool.rbegin(),
+                                  mParticlePool.rbegin() + (size - currSize));
 
             // Tell the renderer, if already configured
             if (mRenderer && mIsRendererConfigured)
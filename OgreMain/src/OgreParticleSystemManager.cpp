@@ -32,6 +32,7 @@ THE SOFTWARE.
 #include "OgreParticleSystemRenderer.h"
 #include "OgreBillboardParticleRenderer.h"
 #include "OgreParticleSystem.h"
+#include "OgreWorkQueue.h"
 
 namespace Ogre {
     //-----------------------------------------------------------------------
@@ -48,7 +49,7 @@ namespace Ogre {
         assert( msSingleton );  return ( *msSingleton );  
     }
     //-----------------------------------------------------------------------
-    ParticleSystemManager::ParticleSystemManager()
+    ParticleSystemManager::ParticleSystemManager() : mParallelUpdates(false)
     {
         OGRE_LOCK_AUTO_MUTEX;
         mFactory = OGRE_NEW ParticleSystemFactory();
@@ -331,6 +332,58 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
+    void ParticleSystemManager::_queueUpdate(ParticleSystem* system, Real timeElapsed)
+    {
+        mQueuedUpdates.emplace_back(system, timeElapsed);
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystemManager::_cancelUpdate(ParticleSystem* system)
+    {
+        mQueuedUpdates.erase(std::remove_if(mQueuedUpdates.begin(), mQueuedUpdates.end(),
+                                            [system](const std::pair<ParticleSystem*, Real>& u)
+                                            { return u.first == system; }),
+                             mQueuedUpdates.end());
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystemManager::_updateQueuedSystems(void)
+    {
+        if (mQueuedUpdates.empty())
+            return;
+
+        OgreProfile("ParticleSystems");
+
+        // setup on the main thread, keeping the systems that need an update
+        size_t count = 0;
+        for (const auto& u : mQueuedUpdates)
+        {
+            if (u.first->_prepareUpdate(u.second))
+            {
+                // bring the derived transform up to date, so the workers only read it
+                u.first->getParentNode()->_getFullTransform();
+                mQueuedUpdates[count++] = u;
+            }
+        }
+        mQueuedUpdates.resize(count);
+
+        std::exception_ptr error;
+        try
+        {
+            Root::getSingleton().getWorkQueue()->parallelFor(
+                count, [this](size_t i) { mQueuedUpdates[i].first->_simulate(mQueuedUpdates[i].second); });
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        for (const auto& u : mQueuedUpdates)
+            u.first->_finishUpdate();
+        mQueuedUpdates.clear();
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+    //-----------------------------------------------------------------------
     ParticleSystemManager::ParticleAffectorFactoryIterator 
     ParticleSystemManager::getAffectorFactoryIterator(void)
     {
@@ -365,6 +365,39 @@ struct A8R8G8B8toB8G8R8: public PixelConverter <Ogre::uint32, Col3b, FMTCONVERTE
     }
 };
 
+// 8-bit channels of a native endian uint32 <-> PF_FLOAT32_RGBA, with the same rounding as
+// PixelUtil::unpackColour/packColour. Branch free per channel, so the loop in
+// PixelBoxConverter::conversion is left to the auto-vectoriser.
+template <int id, unsigned int rshift, unsigned int gshift, unsigned int bshift, unsigned int ashift> struct Uint32toCol4fswizzler:
+    public PixelConverter <Ogre::uint32, Col4f, id>
+{
+    inline static Col4f pixelConvert(Ogre::uint32 inp)
+    {
+        return Col4f(((inp>>rshift)&0xFF)/255.0f, ((inp>>gshift)&0xFF)/255.0f,
+                     ((inp>>bshift)&0xFF)/255.0f, ((inp>>ashift)&0xFF)/255.0f);
+    }
+};
+template <int id, unsigned int rshift, unsigned int gshift, unsigned int bshift, unsigned int ashift> struct Col4ftoUint32swizzler:
+    public PixelConverter <Col4f, Ogre::uint32, id>
+{
+    inline static Ogre::uint32 pixelConvert(const Col4f &inp)
+    {
+        return ((Ogre::Bitwise::floatToFixed(inp.r, 8)<<rshift) & (0xFFu<<rshift)) |
+               ((Ogre::Bitwise::floatToFixed(inp.g, 8)<<gshift) & (0xFFu<<gshift)) |
+               ((Ogre::Bitwise::floatToFixed(inp.b, 8)<<bshift) & (0xFFu<<bshift)) |
+               ((Ogre::Bitwise::floatToFixed(inp.a, 8)<<ashift) & (0xFFu<<ashift));
+    }
+};
+
+struct A8R8G8B8toFLOAT32_RGBA: public Uint32toCol4fswizzler<FMTCONVERTERID(Ogre::PF_A8R8G8B8, Ogre::PF_FLOAT32_RGBA), 16, 8, 0, 24> { };
+struct A8B8G8R8toFLOAT32_RGBA: public Uint32toCol4fswizzler<FMTCONVERTERID(Ogre::PF_A8B8G8R8, Ogre::PF_FLOAT32_RGBA), 0, 8, 16, 24> { };
+struct B8G8R8A8toFLOAT32_RGBA: public Uint32toCol4fswizzler<FMTCONVERTERID(Ogre::PF_B8G8R8A8, Ogre::PF_FLOAT32_RGBA), 8, 16, 24, 0> { };
+struct R8G8B8A8toFLOAT32_RGBA: public Uint32toCol4fswizzler<FMTCONVERTERID(Ogre::PF_R8G8B8A8, Ogre::PF_FLOAT32_RGBA), 24, 16, 8, 0> { };
+struct FLOAT32_RGBAtoA8R8G8B8: public Col4ftoUint32swizzler<FMTCONVERTERID(Ogre::PF_FLOAT32_RGBA, Ogre::PF_A8R8G8B8), 16, 8, 0, 24> { };
+struct FLOAT32_RGBAtoA8B8G8R8: public Col4ftoUint32swizzler<FMTCONVERTERID(Ogre::PF_FLOAT32_RGBA, Ogre::PF_A8B8G8R8), 0, 8, 16, 24> { };
+struct FLOAT32_RGBAtoB8G8R8A8: public Col4ftoUint32swizzler<FMTCONVERTERID(Ogre::PF_FLOAT32_RGBA, Ogre::PF_B8G8R8A8), 8, 16, 24, 0> { };
+struct FLOAT32_RGBAtoR8G8B8A8: public Col4ftoUint32swizzler<FMTCONVERTERID(Ogre::PF_FLOAT32_RGBA, Ogre::PF_R8G8B8A8), 24, 16, 8, 0> { };
+
 // Only conversions from X8R8G8B8 to formats with alpha need to be defined, the rest is implicitly the same
 // as A8R8G8B8
 struct X8R8G8B8toA8R8G8B8: public PixelConverter <Ogre::uint32, Ogre::uint32, FMTCONVERTERID(Ogre::PF_X8R8G8B8, Ogre::PF_A8R8G8B8)>
@@ -478,6 +511,14 @@ inline int doOptimizedConversion(const Ogre::PixelBox &src, const Ogre::PixelBox
         CASECONVERTER(X8B8G8R8toA8B8G8R8);
         CASECONVERTER(X8B8G8R8toB8G8R8A8);
         CASECONVERTER(X8B8G8R8toR8G8B8A8);
+        CASECONVERTER(A8R8G8B8toFLOAT32_RGBA);
+        CASECONVERTER(A8B8G8R8toFLOAT32_RGBA);
+        CASECONVERTER(B8G8R8A8toFLOAT32_RGBA);
+        CASECONVERTER(R8G8B8A8toFLOAT32_RGBA);
+        CASECONVERTER(FLOAT32_RGBAtoA8R8G8B8);
+        CASECONVERTER(FLOAT32_RGBAtoA8B8G8R8);
+        CASECONVERTER(FLOAT32_RGBAtoB8G8R8A8);
+        CASECONVERTER(FLOAT32_RGBAtoR8G8B8A8);
 
         default:
             return 0;
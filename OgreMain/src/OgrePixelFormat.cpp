@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "OgreStableHeaders.h"
 #include "OgrePixelFormat.h"
 #include "OgrePixelFormatDescriptions.h"
+#include "OgreWorkQueue.h"
 
 namespace {
 #include "OgrePixelConversions.h"
@@ -655,23 +656,12 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------
+    /// pixels per job when a conversion is spread across the WorkQueue
+    static const size_t CONVERSION_BAND_PIXELS = 65536;
+
     /* Convert pixels from one format to another */
-    void PixelUtil::bulkPixelConversion(const PixelBox &src, const PixelBox &dst)
+    static void convertPixels(const PixelBox &src, const PixelBox &dst)
     {
-        OgreAssert(src.getSize() == dst.getSize(), "");
-
-        // Check for compressed formats, we don't support decompression, compression or recoding
-        if(PixelUtil::isCompressed(src.format) || PixelUtil::isCompressed(dst.format))
-        {
-            OgreAssert(src.format == dst.format && src.isConsecutive() && dst.isConsecutive(),
-                       "This method can not be used to compress or decompress images");
-            // we can copy with slice granularity, useful for Tex2DArray handling
-            size_t bytesPerSlice = getMemorySize(src.getWidth(), src.getHeight(), 1, src.format);
-            memcpy(dst.data + bytesPerSlice * dst.front, src.data + bytesPerSlice * src.front,
-                   bytesPerSlice * src.getDepth());
-            return;
-        }
-
         // The easy case
         if(src.format == dst.format) {
             uint8 *srcptr = src.getTopLeftFrontPixelPtr();
@@ -719,18 +709,18 @@ namespace Ogre {
             // optimized conversions
             PixelBox tempdst = dst;
             tempdst.format = dst.format==PF_X8R8G8B8?PF_A8R8G8B8:PF_A8B8G8R8;
-            bulkPixelConversion(src, tempdst);
+            convertPixels(src, tempdst);
             return;
         }
         // Converting from PF_X8R8G8B8 is exactly the same as converting from
         // PF_A8R8G8B8, given that the destination format does not have alpha.
-        if((src.format == PF_X8R8G8B8||src.format == PF_X8B8G8R8) && !hasAlpha(dst.format))
+        if((src.format == PF_X8R8G8B8||src.format == PF_X8B8G8R8) && !PixelUtil::hasAlpha(dst.format))
         {
             // Do the same conversion, with PF_A8R8G8B8, which has a lot of
             // optimized conversions
             PixelBox tempsrc = src;
             tempsrc.format = src.format==PF_X8R8G8B8?PF_A8R8G8B8:PF_A8B8G8R8;
-            bulkPixelConversion(tempsrc, dst);
+            convertPixels(tempsrc, dst);
             return;
         }
 
@@ -766,8 +756,8 @@ namespace Ogre {
             {
                 for(size_t x=src.left; x<src.right; x++)
                 {
-                    unpackColour(&r, &g, &b, &a, src.format, srcptr);
-                    packColour(r, g, b, a, dst.format, dstptr);
+                    PixelUtil::unpackColour(&r, &g, &b, &a, src.format, srcptr);
+                    PixelUtil::packColour(r, g, b, a, dst.format, dstptr);
                     srcptr += srcPixelSize;
                     dstptr += dstPixelSize;
                 }
@@ -779,6 +769,48 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------
+    void PixelUtil::bulkPixelConversion(const PixelBox &src, const PixelBox &dst)
+    {
+        OgreAssert(src.getSize() == dst.getSize(), "");
+
+        // Check for compressed formats, we don't support decompression, compression or recoding
+        if(PixelUtil::isCompressed(src.format) || PixelUtil::isCompressed(dst.format))
+        {
+            OgreAssert(src.format == dst.format && src.isConsecutive() && dst.isConsecutive(),
+                       "This method can not be used to compress or decompress images");
+            // we can copy with slice granularity, useful for Tex2DArray handling
+            size_t bytesPerSlice = getMemorySize(src.getWidth(), src.getHeight(), 1, src.format);
+            memcpy(dst.data + bytesPerSlice * dst.front, src.data + bytesPerSlice * src.front,
+                   bytesPerSlice * src.getDepth());
+            return;
+        }
+
+        size_t rows = src.getHeight();
+        if (rows == 0 || src.getWidth() == 0 || src.getDepth() == 0)
+            return; // nothing to convert
+
+        size_t rowsPerBand = std::max<size_t>(1, CONVERSION_BAND_PIXELS / (src.getWidth() * src.getDepth()));
+        Root* root = Root::getSingletonPtr();
+        if (!root || rows <= rowsPerBand)
+        {
+            convertPixels(src, dst);
+            return;
+        }
+
+        // split into bands of whole rows, each band spanning all slices
+        size_t numBands = (rows + rowsPerBand - 1) / rowsPerBand;
+        root->getWorkQueue()->parallelFor(numBands, [&](size_t band) {
+            uint32 begin = uint32(band * rowsPerBand);
+            uint32 end = uint32(std::min(begin + rowsPerBand, rows));
+            PixelBox srcBand = src, dstBand = dst;
+            srcBand.top = src.top + begin;
+            srcBand.bottom = src.top + end;
+            dstBand.top = dst.top + begin;
+            dstBand.bottom = dst.top + end;
+            convertPixels(srcBand, dstBand);
+        });
+    }
+    //-----------------------------------------------------------------------
     void PixelUtil::bulkPixelVerticalFlip(const PixelBox &box)
     {
         // Check for compressed formats, we don't support decompression, compression or recoding
@@ -80,8 +80,8 @@ namespace Ogre {
     @note
         Radix sorting is often associated with just unsigned integer values. Our
         implementation can handle both unsigned and signed integers, as well as
-        floats (which are often not supported by other radix sorters). doubles
-        are not supported; you will need to implement your functor object to convert
+        floats (which are often not supported by other radix sorters) and unsigned
+        64 bit keys. Signed 64 bit values and doubles are not supported; you will need to implement your functor object to convert
         to float if you wish to use this sort routine.
     */
     template <class TContainer, class TContainerValueType, typename TCompValueType>
@@ -91,8 +91,8 @@ namespace Ogre {
         typedef typename TContainer::iterator ContainerIter;
     protected:
         /// Alpha-pass counters of values (histogram)
-        /// 4 of them so we can radix sort a maximum of a 32bit value
-        int mCounters[4][256];
+        /// one per byte of the sort value
+        int mCounters[sizeof(TCompValueType)][256];
         /// Beta-pass offsets 
         int mOffsets[256];
         /// Sort area size
@@ -309,6 +309,10 @@ namespace Ogre {
 
             for (p = 0; p < mNumPasses - 1; ++p)
             {
+                // all values share this byte, e.g. the unused high bits of a 64bit key
+                if (mCounters[p][getByte(p, prevValue)] == mSortSize)
+                    continue;
+
                 sortPass(p);
                 // flip src/dst
                 SortVector* tmp = mSrc;
@@ -41,7 +41,9 @@ namespace Ogre {
         : mSplitPassesByLightingType(false)
         , mSplitNoShadowPasses(false)
         , mShadowCastersCannotBeReceivers(false)
+        , mPersistent(false)
         , mRenderableListener(0)
+        , mGroupStats(0)
     {
         // Create the 'main' queue up-front since we'll always need that
         mGroups[RENDER_QUEUE_MAIN] = std::make_unique<RenderQueueGroup>(
@@ -117,10 +119,24 @@ namespace Ogre {
         RenderQueueGroup* pGroup = getQueueGroup(groupID);
         pGroup->addRenderable(pRend, pTech, priority);
 
+        if (mGroupStats)
+            ++mGroupStats[groupID].renderablesQueued;
+
     }
     //-----------------------------------------------------------------------
     void RenderQueue::clear(bool destroyPassMaps)
     {
+        // persistent queues may only keep their contents if all passes stay as they are
+        bool passesChanged = destroyPassMaps;
+        {
+            OGRE_LOCK_MUTEX(Pass::msPassGraveyardMutex);
+            passesChanged |= !Pass::getPassGraveyard().empty();
+        }
+        {
+            OGRE_LOCK_MUTEX(Pass::msDirtyHashListMutex);
+            passesChanged |= !Pass::getDirtyHashList().empty();
+        }
+
         // Note: We clear dirty passes from all RenderQueues in all 
         // SceneManagers, because the following recalculation of pass hashes
         // also considers all RenderQueues and could become inconsistent, otherwise.
@@ -128,9 +144,18 @@ namespace Ogre {
         {
             RenderQueue* queue = p.second->getRenderQueue();
 
+            bool keep = queue->mPersistent && !passesChanged;
+            if (keep && queue != this)
+                continue;
+
             for (auto & g : queue->mGroups)
             {
-                if(g)
+                if(!g)
+                    continue;
+
+                if (keep)
+                    g->_beginIncrementalUpdate();
+                else
                     g->clear(destroyPassMaps);
             }
         }
@@ -271,6 +296,8 @@ namespace Ogre {
         if (!onlyShadowCasters || mo->getCastShadows())
         {
             mo->_updateRenderQueue(this);
+            if (mGroupStats)
+                ++mGroupStats[mo->getRenderQueueGroup()].objectsVisible;
             if (visibleBounds)
             {
                 visibleBounds->merge(bbox, bsphere, cam, receiveShadows);
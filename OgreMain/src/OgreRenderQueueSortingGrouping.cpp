@@ -28,73 +28,67 @@ THE SOFTWARE.
 #include "OgreStableHeaders.h"
 #include "OgreRenderQueueSortingGrouping.h"
 #include <algorithm>
-#include <unordered_map>
 
 namespace Ogre {
 namespace {
-    /// Comparator to order objects by descending camera distance
-    struct DistanceSortDescendingLess
+    /// map a float to an unsigned int with the same ordering
+    uint32 floatToSortable(float f)
     {
-        const Camera* camera;
-
-        DistanceSortDescendingLess(const Camera* cam)
-            : camera(cam)
-        {
-        }
+        uint32 u;
+        memcpy(&u, &f, sizeof(u));
+        return (u & 0x80000000) ? ~u : (u | 0x80000000);
+    }
 
-        bool operator()(const RenderablePass& a, const RenderablePass& b) const
+    /// Functor for accessing the sort key for radix sort
+    struct RadixSortFunctorKey
+    {
+        uint64 operator()(const RenderablePass& p) const
         {
-            if (a.renderable == b.renderable)
-            {
-                // Same renderable, sort by pass hash
-                return a.pass->getHash() < b.pass->getHash();
-            }
-            else
-            {
-                // Different renderables, sort by distance
-                Real adist = a.renderable->getSquaredViewDepth(camera);
-                Real bdist = b.renderable->getSquaredViewDepth(camera);
-                if (Math::RealEqual(adist, bdist))
-                {
-                    // Must return deterministic result, doesn't matter what
-                    return a.pass < b.pass;
-                }
-                else
-                {
-                    // Sort DESCENDING by dist (i.e. far objects first)
-                    return (adist > bdist);
-                }
-            }
-
+            return p.sortKey;
         }
     };
 
-    /// Functor for accessing sort value 1 for radix sort (Pass)
-    struct RadixSortFunctorPass
+    struct SortKeyLess
     {
-        uint32 operator()(const RenderablePass& p) const
+        bool operator()(const RenderablePass& a, const RenderablePass& b) const
         {
-            return p.pass->getHash();
+            return a.sortKey < b.sortKey;
         }
     };
 
-    /// Functor for descending sort value 2 for radix sort (distance)
-    struct RadixSortFunctorDistance
+    typedef std::vector<RenderablePass>::iterator RenderablePassIterator;
+    void sortByKey(RenderablePassIterator begin, RenderablePassIterator end)
     {
-        const Camera* camera;
+        static RadixSort<std::vector<RenderablePass>, RenderablePass, uint64> msRadixSorter;
 
-        RadixSortFunctorDistance(const Camera* cam)
-            : camera(cam)
-        {
-        }
+        // The radix sort makes a histogram pass and one pass per key byte that
+        // actually varies, i.e. up to 8 passes over the data plus the copies.
+        // stable_sort on the precomputed keys wins below a few thousand items.
+        if (std::distance(begin, end) > 2000)
+            msRadixSorter.sort(begin, end, RadixSortFunctorKey());
+        else
+            std::stable_sort(begin, end, SortKeyLess());
+    }
 
-        float operator()(const RenderablePass& p) const
+    typedef std::pair<uint64, uint32> KeyIndex;
+    struct RadixSortFunctorKeyIndex
+    {
+        uint64 operator()(const KeyIndex& k) const
         {
-            // Sort DESCENDING by depth (ie far objects first), use negative distance
-            // here because radix sorter always dealing with accessing sort
-            return static_cast<float>(- p.renderable->getSquaredViewDepth(camera));
+            return k.first;
         }
     };
+
+    void sortByKey(std::vector<KeyIndex>& list)
+    {
+        static RadixSort<std::vector<KeyIndex>, KeyIndex, uint64> msRadixSorter;
+
+        if (list.size() > 2000)
+            msRadixSorter.sort(list, RadixSortFunctorKeyIndex());
+        else
+            std::stable_sort(list.begin(), list.end(),
+                             [](const KeyIndex& a, const KeyIndex& b) { return a.first < b.first; });
+    }
 }
     //-----------------------------------------------------------------------
     RenderPriorityGroup::RenderPriorityGroup(RenderQueueGroup* parent, 
@@ -218,51 +212,10 @@ namespace {
         }
     }
     //-----------------------------------------------------------------------
-    void RenderPriorityGroup::removePassEntry(Pass* p)
-    {
-        mSolidsBasic.removePassGroup(p);
-        mSolidsDiffuseSpecular.removePassGroup(p);
-        mSolidsNoShadowReceive.removePassGroup(p);
-        mSolidsDecal.removePassGroup(p);
-        mTransparentsUnsorted.removePassGroup(p);
-        mTransparents.removePassGroup(p); // shouldn't be any, but for completeness
-    }   
-    //-----------------------------------------------------------------------
     void RenderPriorityGroup::clear(void)
     {
-        // Delete queue groups which are using passes which are to be
-        // deleted, we won't need these any more and they clutter up 
-        // the list and can cause problems with future clones
-        {
-            // Hmm, a bit hacky but least obtrusive for now
-                    OGRE_LOCK_MUTEX(Pass::msPassGraveyardMutex);
-            const Pass::PassSet& graveyardList = Pass::getPassGraveyard();
-            for (auto* p : graveyardList)
-            {
-                removePassEntry(p);
-            }
-        }
-
-        // Now remove any dirty passes, these will have their hashes recalculated
-        // by the parent queue after all groups have been processed
-        // If we don't do this, the std::map will become inconsistent for new insterts
-        {
-            // Hmm, a bit hacky but least obtrusive for now
-                    OGRE_LOCK_MUTEX(Pass::msDirtyHashListMutex);
-            const Pass::PassSet& dirtyList = Pass::getDirtyHashList();
-            for (auto* p : dirtyList)
-            {
-                removePassEntry(p);
-            }
-        }
-        // NB we do NOT clear the graveyard or the dirty list here, because 
-        // it needs to be acted on for all groups, the parent queue takes 
-        // care of this afterwards
-
-        // Now empty the remaining collections
-        // Note that groups don't get deleted, just emptied hence the difference
-        // between the pass groups which are removed above, and clearing done
-        // here
+        // The collections are flat lists keyed at sort time, so nothing refers to
+        // passes in the graveyard or with a dirty hash once they are emptied
         mSolidsBasic.clear();
         mSolidsDecal.clear();
         mSolidsDiffuseSpecular.clear();
@@ -272,6 +225,16 @@ namespace {
 
     }
     //-----------------------------------------------------------------------
+    void RenderPriorityGroup::_beginIncrementalUpdate(void)
+    {
+        mSolidsBasic._beginIncrementalUpdate();
+        mSolidsDecal._beginIncrementalUpdate();
+        mSolidsDiffuseSpecular._beginIncrementalUpdate();
+        mSolidsNoShadowReceive._beginIncrementalUpdate();
+        mTransparentsUnsorted._beginIncrementalUpdate();
+        mTransparents._beginIncrementalUpdate();
+    }
+    //-----------------------------------------------------------------------
     void RenderPriorityGroup::sort(const Camera* cam)
     {
         mSolidsBasic.sort(cam);
@@ -293,98 +256,260 @@ namespace {
     }
     //-----------------------------------------------------------------------
     QueuedRenderableCollection::QueuedRenderableCollection(void)
-        :mOrganisationMode(0)
+        : mOrganisationMode(0), mNumPassGroups(0), mPassGroupsDirty(false), mIncremental(false), mFrame(0)
+        , mNumQueued(0), mNumAdded(0)
     {
     }
 
     //-----------------------------------------------------------------------
     void QueuedRenderableCollection::clear(void)
     {
-        for (auto& i : mGrouped)
+        // Clear the lists, the pass group entries are kept for reuse
+        mGrouped.clear();
+        mNumPassGroups = 0;
+        mPassGroupsDirty = false;
+
+        mIncremental = false;
+        mGroupedSlot.clear();
+        mSlots.clear();
+        mFreeSlots.clear();
+        mSlotIndex.clear();
+        mQueuedSlots.clear();
+        mLastQueuedSlots.clear();
+        mPassOrdinals.clear();
+        mHashPassCounts.clear();
+
+        // Clear sorted list
+        mSortedDescending.clear();
+    }
+    //-----------------------------------------------------------------------
+    void QueuedRenderableCollection::_beginIncrementalUpdate(void)
+    {
+        if (!mIncremental || mPassGroupsDirty)
         {
-            // Clear the list associated with this pass, but leave the pass entry
-            i.second.clear();
+            // the current contents are not tracked or were never sorted
+            clear();
+            mIncremental = true;
         }
 
-        // Clear sorted list
+        ++mFrame;
+        mNumQueued = mNumAdded = 0;
+        mLastQueuedSlots.swap(mQueuedSlots);
+        mQueuedSlots.clear();
+        mPassGroupsDirty = true;
+
         mSortedDescending.clear();
     }
     //-----------------------------------------------------------------------
     void QueuedRenderableCollection::removePassGroup(Pass* p)
     {
-        PassGroupRenderableMap::iterator i;
-
-        i = mGrouped.find(p);
-        if (i != mGrouped.end())
+        auto it = std::remove_if(mGrouped.begin(), mGrouped.end(),
+                                 [p](const RenderablePass& rp) { return rp.pass == p; });
+        if (it != mGrouped.end())
         {
-            // erase from map
-            mGrouped.erase(i);
+            mGrouped.erase(it, mGrouped.end());
+            mPassGroupsDirty = true;
+            mIncremental = false; // indices are stale, rebuild next frame
         }
     }
     //-----------------------------------------------------------------------
     void QueuedRenderableCollection::sort(const Camera* cam)
     {
-        /// Radix sorter for accessing sort value 1 (Pass)
-        static RadixSort<RenderablePassList, RenderablePass, uint32> msRadixSorter1;
-        /// Radix sorter for sort value 2 (distance)
-        static RadixSort<RenderablePassList, RenderablePass, float> msRadixSorter2;
-
         // ascending and descending sort both set bit 1
         // We always sort descending, because the only difference is in the
         // acceptVisitor method, where we iterate in reverse in ascending mode
         if (mOrganisationMode & OM_SORT_DESCENDING)
         {
-            
-            // We can either use a stable_sort and the 'less' implementation,
-            // or a 2-pass radix sort (once by pass, then by distance, since
-            // radix sorting is inherently stable this will work)
-            // We use stable_sort if the number of items is 512 or less, since
-            // the complexity of the radix sort is approximately O(10N), since 
-            // each sort is O(5N) (1 pass histograms, 4 passes sort)
-            // Since stable_sort has a worst-case performance of O(N(logN)^2)
-            // the performance tipping point is from about 1500 items, but in
-            // stable_sorts best-case scenario O(NlogN) it would be much higher.
-            // Take a stab at 2000 items.
-            
-            if (mSortedDescending.size() > 2000)
+            for (auto& rp : mSortedDescending)
             {
-                // sort by pass
-                msRadixSorter1.sort(mSortedDescending, RadixSortFunctorPass());
-                // sort by depth
-                msRadixSorter2.sort(mSortedDescending, RadixSortFunctorDistance(cam));
+                // far objects first, passes of the same renderable in pass order
+                uint32 depth = ~floatToSortable(float(rp.renderable->getSquaredViewDepth(cam)));
+                rp.sortKey = (uint64(depth) << 32) | rp.pass->getHash();
             }
-            else
+            sortByKey(mSortedDescending.begin(), mSortedDescending.end());
+        }
+
+        if (mOrganisationMode & OM_PASS_GROUP)
+        {
+            sortGrouped(cam);
+        }
+    }
+    //-----------------------------------------------------------------------
+    void QueuedRenderableCollection::sortGrouped(const Camera* cam)
+    {
+        if (mIncremental)
+        {
+            updateGrouped(cam);
+            return;
+        }
+
+        // the ordinals only have to be consistent within the sorted set
+        mPassOrdinals.clear();
+        mHashPassCounts.clear();
+        computeGroupedKeys(0, cam);
+        sortByKey(mGrouped.begin(), mGrouped.end());
+        buildPassGroups();
+    }
+    //-----------------------------------------------------------------------
+    void QueuedRenderableCollection::computeGroupedKeys(size_t first, const Camera* cam)
+    {
+        // key layout (high to low bits)
+        // 32 pass hash, 12 pass ordinal (splits passes with equal hash), 20 depth or submesh
+        const Pass* lastPass = NULL;
+        uint32 ordinal = 0;
+        for (auto rp = mGrouped.begin() + first; rp != mGrouped.end(); ++rp)
+        {
+            if (rp->pass != lastPass)
             {
-                std::stable_sort(
-                    mSortedDescending.begin(), mSortedDescending.end(), 
-                    DistanceSortDescendingLess(cam));
+                // dense per hash, so it only wraps with more than 4096 passes of one hash
+                auto it = mPassOrdinals.find(rp->pass);
+                if (it == mPassOrdinals.end())
+                    it = mPassOrdinals.emplace(rp->pass, mHashPassCounts[rp->pass->getHash()]++).first;
+                ordinal = it->second;
+                lastPass = rp->pass;
             }
+
+            uint32 minor = 0;
+            if (rp->pass->hasVertexProgram() && rp->pass->getVertexProgram()->isInstancingIncluded())
+            {
+                // cluster by submesh
+                auto subEntity = dynamic_cast<SubEntity*>(rp->renderable);
+                minor = uint32(size_t(subEntity ? subEntity->getSubMesh() : 0) >> 4);
+            }
+            else if (cam)
+            {
+                // front to back to make use of early depth rejection
+                minor = floatToSortable(float(rp->renderable->getSquaredViewDepth(cam))) >> 12;
+            }
+
+            uint32 passBits = (ordinal & 0xFFF) << 20;
+            rp->sortKey = (uint64(rp->pass->getHash()) << 32) | passBits | (minor & 0xFFFFF);
         }
-        else if (mOrganisationMode & OM_PASS_GROUP)
+    }
+    //-----------------------------------------------------------------------
+    void QueuedRenderableCollection::updateGrouped(const Camera* cam)
+    {
+        mPassGroupsDirty = false;
+        if (mNumAdded == 0 && mNumQueued == mGrouped.size())
+            return; // same as last time
+
+        // order the new entries on their own
+        size_t firstNew = mGrouped.size() - mNumAdded;
+        computeGroupedKeys(firstNew, cam);
+        mAddedOrder.clear();
+        for (size_t i = firstNew; i < mGrouped.size(); ++i)
+            mAddedOrder.push_back(KeyIndex(mGrouped[i].sortKey, uint32(i)));
+        sortByKey(mAddedOrder);
+
+        // merge them with the entries queued again, dropping the others
+        mMergedGrouped.clear();
+        mMergedSlot.clear();
+        auto added = mAddedOrder.begin();
+        for (size_t i = 0; i < firstNew; ++i)
         {
-            // cluster by submesh
-            for(auto& it : mGrouped)
+            uint32 slot = mGroupedSlot[i];
+            if (mSlots[slot].frame != mFrame)
             {
-                auto instanced = it.first->hasVertexProgram() && it.first->getVertexProgram()->isInstancingIncluded();
-                if (!instanced)
-                    continue;
+                releaseSlot(slot);
+                continue;
+            }
 
-                std::unordered_map<SubMesh*, RenderableList> bySubMesh;
-                for (auto* rend : it.second)
-                {
-                    auto subEntity = dynamic_cast<SubEntity*>(rend);
-                    SubMesh* subMesh = subEntity ? subEntity->getSubMesh() : 0;
-                    bySubMesh[subMesh].push_back(rend);
-                }
-                it.second.clear();
-                for (auto& it2 : bySubMesh)
-                {
-                    it.second.insert(it.second.end(), it2.second.begin(), it2.second.end());
-                }
+            for (; added != mAddedOrder.end() && added->first < mGrouped[i].sortKey; ++added)
+            {
+                mMergedGrouped.push_back(mGrouped[added->second]);
+                mMergedSlot.push_back(mGroupedSlot[added->second]);
             }
+            mMergedGrouped.push_back(mGrouped[i]);
+            mMergedSlot.push_back(slot);
         }
+        for (; added != mAddedOrder.end(); ++added)
+        {
+            mMergedGrouped.push_back(mGrouped[added->second]);
+            mMergedSlot.push_back(mGroupedSlot[added->second]);
+        }
+        mGrouped.swap(mMergedGrouped);
+        mGroupedSlot.swap(mMergedSlot);
+
+        buildPassGroups();
     }
+    //-----------------------------------------------------------------------
+    bool QueuedRenderableCollection::queueIncremental(Pass* pass, Renderable* rend)
+    {
+        const uint32 NO_SLOT = ~0u;
+        uint32 slot = NO_SLOT;
+
+        // usually renderables are queued in the same order as last time
+        size_t seq = mNumQueued++;
+        if (seq < mLastQueuedSlots.size())
+        {
+            const GroupedSlot& s = mSlots[mLastQueuedSlots[seq]];
+            if (s.renderable == rend && s.pass == pass && s.frame != mFrame)
+                slot = mLastQueuedSlots[seq];
+        }
 
+        if (slot == NO_SLOT)
+        {
+            auto it = mSlotIndex.find(std::make_pair(rend, pass));
+            if (it != mSlotIndex.end() && mSlots[it->second].frame != mFrame)
+                slot = it->second;
+        }
+
+        bool isNew = slot == NO_SLOT;
+        if (isNew)
+        {
+            if (mFreeSlots.empty())
+            {
+                slot = uint32(mSlots.size());
+                mSlots.push_back(GroupedSlot());
+            }
+            else
+            {
+                slot = mFreeSlots.back();
+                mFreeSlots.pop_back();
+            }
+            mSlots[slot].renderable = rend;
+            mSlots[slot].pass = pass;
+            // does nothing for a duplicate queued in the same frame
+            mSlotIndex.emplace(std::make_pair(rend, pass), slot);
+            mGroupedSlot.push_back(slot);
+            ++mNumAdded;
+        }
+
+        mSlots[slot].frame = mFrame;
+        mQueuedSlots.push_back(slot);
+        return isNew;
+    }
+    //-----------------------------------------------------------------------
+    void QueuedRenderableCollection::releaseSlot(uint32 slot)
+    {
+        const GroupedSlot& s = mSlots[slot];
+        auto it = mSlotIndex.find(std::make_pair(s.renderable, s.pass));
+        if (it != mSlotIndex.end() && it->second == slot)
+            mSlotIndex.erase(it);
+        mFreeSlots.push_back(slot);
+    }
+    //-----------------------------------------------------------------------
+    void QueuedRenderableCollection::buildPassGroups()
+    {
+        // collect the runs of equal pass, reusing the lists of the last frame
+        mNumPassGroups = 0;
+        const Pass* current = NULL;
+        for (const auto& rp : mGrouped)
+        {
+            if (rp.pass != current)
+            {
+                if (mNumPassGroups == mPassGroups.size())
+                    mPassGroups.emplace_back();
+
+                current = rp.pass;
+                mPassGroups[mNumPassGroups].first = rp.pass;
+                mPassGroups[mNumPassGroups].second.clear();
+                ++mNumPassGroups;
+            }
+            mPassGroups[mNumPassGroups - 1].second.push_back(rp.renderable);
+        }
+        mPassGroupsDirty = false;
+    }
     //-----------------------------------------------------------------------
     void QueuedRenderableCollection::addRenderable(Pass* pass, Renderable* rend)
     {
@@ -396,15 +521,13 @@ namespace {
 
         if (mOrganisationMode & OM_PASS_GROUP)
         {
-            // Optionally create new pass entry, build a new list
-            // Note that this pass and list are never destroyed until the
-            // engine shuts down, or a pass is destroyed or has it's hash
-            // recalculated, although the lists will be cleared
-            PassGroupRenderableMap::iterator i = mGrouped.emplace(pass, RenderableList()).first;
-
-            // Insert renderable
-            i->second.push_back(rend);
-            
+            // queued last time as well, keep its place
+            if (mIncremental && !queueIncremental(pass, rend))
+                return;
+
+            // grouping happens in sort
+            mGrouped.push_back(RenderablePass(rend, pass));
+            mPassGroupsDirty = true;
         }
         
     }
@@ -446,13 +569,12 @@ namespace {
     void QueuedRenderableCollection::acceptVisitorGrouped(
         QueuedRenderableVisitor* visitor) const
     {
-        for (auto& ipass : mGrouped)
-        {
-            // Fast bypass if this group is now empty
-            if (ipass.second.empty()) continue;
+        OgreAssertDbg(!mPassGroupsDirty, "sort() the collection before visiting it grouped");
 
-            visitor->visit(ipass.first, const_cast<RenderableList&>(ipass.second));
-        } 
+        for (size_t i = 0; i < mNumPassGroups; ++i)
+        {
+            visitor->visit(mPassGroups[i].first, const_cast<RenderableList&>(mPassGroups[i].second));
+        }
 
     }
     //-----------------------------------------------------------------------
@@ -484,17 +606,9 @@ namespace {
     {
         mSortedDescending.insert( mSortedDescending.end(), rhs.mSortedDescending.begin(), rhs.mSortedDescending.end() );
 
-        for (const auto& srcGroup : rhs.mGrouped)
-        {
-            // Optionally create new pass entry, build a new list
-            // Note that this pass and list are never destroyed until the
-            // engine shuts down, or a pass is destroyed or has it's hash
-            // recalculated, although the lists will be cleared
-            PassGroupRenderableMap::iterator dstGroup = mGrouped.emplace(srcGroup.first, RenderableList()).first;
-
-            // Insert renderable
-            dstGroup->second.insert(dstGroup->second.end(), srcGroup.second.begin(), srcGroup.second.end() );
-        }
+        mGrouped.insert( mGrouped.end(), rhs.mGrouped.begin(), rhs.mGrouped.end() );
+        mPassGroupsDirty |= !rhs.mGrouped.empty();
+        mIncremental = false; // untracked entries, rebuild next frame
     }
 }
 
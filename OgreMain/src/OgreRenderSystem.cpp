@@ -56,6 +56,7 @@ namespace Ogre {
         , mBatchCount(0)
         , mFaceCount(0)
         , mVertexCount(0)
+        , mConstantBytesUploaded(0)
         , mInvertVertexWinding(false)
         , mIsReverseDepthBufferEnabled(false)
         , mDisabledTexUnitsFrom(0)
@@ -75,6 +76,7 @@ namespace Ogre {
         , mGlobalInstanceVertexDeclaration(NULL)
         , mGlobalNumberOfInstances(1)
     {
+        std::fill(std::begin(mUniformBufferParams), std::end(mUniformBufferParams), nullptr);
         mEventNames.push_back("RenderSystemCapabilitiesCreated");
     }
 
@@ -136,15 +138,34 @@ namespace Ogre {
         mFixedFunctionParams->setAutoConstant(light_offset + 5, GpuProgramParameters::ACT_SPOTLIGHT_PARAMS, index);
     }
 
-    const HardwareBufferPtr& RenderSystem::updateDefaultUniformBuffer(GpuProgramType gptype, const ConstantList& params)
+    const HardwareBufferPtr& RenderSystem::updateDefaultUniformBuffer(GpuProgramType gptype,
+                                                                      GpuProgramParameters& params,
+                                                                      bool partialUpload)
     {
+        const ConstantList& constants = params.getConstantList();
         auto& ubo = mUniformBuffer[gptype];
-        if (!ubo || ubo->getSizeInBytes() < params.size())
+        if (!ubo || ubo->getSizeInBytes() < constants.size())
         {
-            ubo = HardwareBufferManager::getSingleton().createUniformBuffer(params.size());
+            ubo = HardwareBufferManager::getSingleton().createUniformBuffer(constants.size());
+            params._markDirty();
         }
+        else if (mUniformBufferParams[gptype] != &params)
+        {
+            params._markDirty();
+        }
+        mUniformBufferParams[gptype] = &params;
 
-        ubo->writeData(0, params.size(), params.data(), true);
+        auto range = params._getDirtyRange();
+        if (range.first < range.second)
+        {
+            if (!partialUpload || (range.first == 0 && range.second == constants.size()))
+                range = std::make_pair(size_t(0), constants.size());
+
+            ubo->writeData(range.first, range.second - range.first, &constants[range.first],
+                           range.first == 0 && range.second == constants.size());
+            mConstantBytesUploaded += range.second - range.first;
+        }
+        params._markClean();
 
         return ubo;
     }
@@ -605,7 +626,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void RenderSystem::_beginGeometryCount(void)
     {
-        mBatchCount = mFaceCount = mVertexCount = 0;
+        mBatchCount = mFaceCount = mVertexCount = mConstantBytesUploaded = 0;
     }
     //-----------------------------------------------------------------------
     void RenderSystem::_render(const RenderOperation& op)
@@ -43,6 +43,7 @@ THE SOFTWARE.
 #include "OgreRenderTexture.h"
 #include "OgreLodListener.h"
 #include "OgreDefaultDebugDrawer.h"
+#include "OgreTimer.h"
 
 // This class implements the most basic scene manager
 
@@ -64,12 +65,17 @@ mFogDensity(0),
 mSpecialCaseQueueMode(SCRQM_EXCLUDE),
 mWorldGeometryRenderQueue(RENDER_QUEUE_WORLD_GEOMETRY_1),
 mLastFrameNumber(0),
+mRenderStatsEnabled(false),
+mStatsPass(0),
+mStatsPrograms(),
+mStatsQueueGroup(RENDER_QUEUE_COUNT),
 mResetIdentityView(false),
 mResetIdentityProj(false),
 mFlipCullingOnNegativeScale(true),
 mLightsDirtyCounter(0),
 mMovableNameGenerator("Ogre/MO"),
 mDisplayNodes(false),
+mParallelAnimationUpdate(false),
 mShowBoundingBoxes(false),
 mActiveCompositorChain(0),
 mLateMaterialResolving(false),
@@ -662,6 +668,12 @@ const Pass* SceneManager::_setPass(const Pass* pass, bool shadowDerivation)
     // Tell params about current pass
     mAutoParamDataSource->setCurrentPass(pass);
 
+    if (mRenderStatsEnabled && pass != mStatsPass)
+    {
+        ++mRenderStats.passChanges;
+        mStatsPass = pass;
+    }
+
     GpuProgram* vprog = pass->hasVertexProgram() ? pass->getVertexProgram().get() : 0;
     GpuProgram* fprog = pass->hasFragmentProgram() ? pass->getFragmentProgram().get() : 0;
 
@@ -771,6 +783,11 @@ const Pass* SceneManager::_setPass(const Pass* pass, bool shadowDerivation)
 
     // Set scene blending
     mDestRenderSystem->setColourBlendState(pass->getBlendState());
+    if (mRenderStatsEnabled && pass->getBlendState() != mStatsBlendState)
+    {
+        ++mRenderStats.blendChanges;
+        mStatsBlendState = pass->getBlendState();
+    }
 
     // Line width
     if (mDestRenderSystem->getCapabilities()->hasCapability(RSC_WIDE_LINES))
@@ -842,10 +859,34 @@ const Pass* SceneManager::_setPass(const Pass* pass, bool shadowDerivation)
             pTex->_setTexturePtr(refTex);
         }
         mDestRenderSystem->_setTextureUnitSettings(unit, *pTex);
+
+        if (mRenderStatsEnabled)
+        {
+            if (mStatsTextures.size() <= unit)
+            {
+                mStatsTextures.resize(unit + 1);
+                mStatsSamplers.resize(unit + 1);
+            }
+            if (mStatsTextures[unit] != pTex->_getTexturePtr().get())
+            {
+                ++mRenderStats.textureChanges;
+                mStatsTextures[unit] = pTex->_getTexturePtr().get();
+            }
+            if (mStatsSamplers[unit] != pTex->getSampler().get())
+            {
+                ++mRenderStats.samplerChanges;
+                mStatsSamplers[unit] = pTex->getSampler().get();
+            }
+        }
         ++unit;
     }
     // Disable remaining texture units
     mDestRenderSystem->_disableTextureUnitsFrom(pass->getNumTextureUnitStates());
+    for (size_t i = unit; i < mStatsTextures.size(); ++i)
+    {
+        mStatsTextures[i] = NULL;
+        mStatsSamplers[i] = NULL;
+    }
 
     // Set up non-texture related material settings
     // Depth buffer settings
@@ -959,16 +1000,29 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
 
     mCameraInProgress = camera;
 
+    // the render system state is unknown, e.g. after other scene managers rendered
+    resetStatsState();
+    Timer* timer = Root::getSingleton().getTimer();
+    uint64 phaseStart = 0;
 
     // Update controllers 
     ControllerManager::getSingleton().updateAllControllers();
+    ParticleSystemManager::getSingleton()._updateQueuedSystems();
 
     // Update the scene, only do this once per frame
     unsigned long thisFrameNumber = Root::getSingleton().getNextFrameNumber();
     if (thisFrameNumber != mLastFrameNumber)
     {
+        if (mRenderStatsEnabled)
+        {
+            mRenderStats.reset();
+            mRenderStats.frameNumber = thisFrameNumber;
+        }
+
         // Update animations
         _applySceneAnimations();
+        if (mParallelAnimationUpdate)
+            _updateSkeletalAnimations();
         updateDirtyInstanceManagers();
         mLastFrameNumber = thisFrameNumber;
     }
@@ -980,6 +1034,8 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
         // Update scene graph for this camera (can happen multiple times per frame)
         {
             OgreProfileGroup("_updateSceneGraph", OGREPROF_GENERAL);
+            if (mRenderStatsEnabled)
+                phaseStart = timer->getMicroseconds();
             _updateSceneGraph(camera);
 
             // Auto-track nodes
@@ -993,6 +1049,8 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
             camera->_autoTrack();
             OGRE_IGNORE_DEPRECATED_END
 #endif
+            if (mRenderStatsEnabled)
+                mRenderStats.sceneGraphTime += timer->getMicroseconds() - phaseStart;
         }
 
         if (mIlluminationStage != IRS_RENDER_TO_TEXTURE && mFindVisibleObjects)
@@ -1046,6 +1104,7 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
         {
             OgreProfileGroup("prepareRenderQueue", OGREPROF_GENERAL);
             prepareRenderQueue();
+            getRenderQueue()->_setGroupStats(mRenderStatsEnabled ? mRenderStats.queueGroups : NULL);
         }
 
         if (mFindVisibleObjects)
@@ -1063,16 +1122,33 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
             // reset the bounds
             camVisObjIt->second.reset();
 
+            uint32 visibleBefore[RENDER_QUEUE_COUNT];
+            if (mRenderStatsEnabled)
+            {
+                for (int i = 0; i < RENDER_QUEUE_COUNT; ++i)
+                    visibleBefore[i] = mRenderStats.queueGroups[i].objectsVisible;
+                phaseStart = timer->getMicroseconds();
+            }
+
             // Parse the scene and tag visibles
             firePreFindVisibleObjects(vp);
             _findVisibleObjects(camera, &(camVisObjIt->second),
                 mIlluminationStage == IRS_RENDER_TO_TEXTURE? true : false);
             firePostFindVisibleObjects(vp);
 
+            if (mRenderStatsEnabled)
+            {
+                mRenderStats.cullingTime += timer->getMicroseconds() - phaseStart;
+                countCulledObjects(visibleBefore);
+            }
+
             mAutoParamDataSource->setMainCamBoundsInfo(&(camVisObjIt->second));
         }
     } // end lock on scene graph mutex
 
+    if (mRenderStatsEnabled)
+        phaseStart = timer->getMicroseconds();
+
     mDestRenderSystem->_beginGeometryCount();
     // Clear the viewport if required
     if (mCurrentViewport->getClearEveryFrame())
@@ -1096,6 +1172,15 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
     // End frame
     mDestRenderSystem->_endFrame();
 
+    if (mRenderStatsEnabled)
+    {
+        mRenderStats.renderTime += timer->getMicroseconds() - phaseStart;
+        mRenderStats.batches += mDestRenderSystem->_getBatchCount();
+        mRenderStats.faces += mDestRenderSystem->_getFaceCount();
+        mRenderStats.vertices += mDestRenderSystem->_getVertexCount();
+        mRenderStats.constantBytesUploaded += mDestRenderSystem->_getConstantBytesUploaded();
+    }
+
     // Notify camera of vis faces
     camera->_notifyRenderedFaces(mDestRenderSystem->_getFaceCount());
 
@@ -1312,6 +1397,7 @@ void SceneManager::_renderVisibleObjects(void)
                 break;
             }
 
+            mStatsQueueGroup = qId;
             _renderQueueGroupObjects(pGroup, QueuedRenderableCollection::OM_PASS_GROUP);
 
             // Fire queue ended event
@@ -1327,6 +1413,7 @@ void SceneManager::_renderVisibleObjects(void)
         } while (repeatQueue);
 
     } // for each queue group
+    mStatsQueueGroup = RENDER_QUEUE_COUNT;
 
     firePostRenderQueues();
 
@@ -2210,6 +2297,12 @@ void SceneManager::_applySceneAnimations(void)
         }
     }
 
+    if (mParallelAnimationUpdate)
+    {
+        applySceneAnimationsParallel();
+        return;
+    }
+
     // this should allow blended animations
     for(auto *state : mAnimationStates.getEnabledAnimationStates())
     {
@@ -2219,6 +2312,80 @@ void SceneManager::_applySceneAnimations(void)
     }
 }
 //---------------------------------------------------------------------
+void SceneManager::applySceneAnimationsParallel(void)
+{
+    static const size_t BATCH_SIZE = 64;
+
+    mNodeTrackSamples.clear();
+    for(auto *state : mAnimationStates.getEnabledAnimationStates())
+    {
+        Animation* anim = getAnimation(state->getAnimationName());
+        anim->_prepareForSampling();
+        TimeIndex timeIndex = anim->_getTimeIndex(state->getTimePosition());
+        Real weight = state->getWeight();
+
+        for (const auto& it : anim->_getNodeTrackList())
+        {
+            if (it.second->getAssociatedNode())
+                mNodeTrackSamples.push_back({it.second, timeIndex, weight, false, Vector3::ZERO,
+                                             Quaternion::IDENTITY, Vector3::UNIT_SCALE});
+        }
+
+        // these call into animables and vertex buffers, keep them on this thread
+        for (const auto& it : anim->_getNumericTrackList())
+            it.second->apply(timeIndex, weight);
+        for (const auto& it : anim->_getVertexTrackList())
+            it.second->apply(timeIndex, weight);
+    }
+
+    size_t numBatches = (mNodeTrackSamples.size() + BATCH_SIZE - 1) / BATCH_SIZE;
+    Root::getSingleton().getWorkQueue()->parallelFor(numBatches, [this](size_t batch) {
+        size_t end = std::min((batch + 1) * BATCH_SIZE, mNodeTrackSamples.size());
+        for (size_t i = batch * BATCH_SIZE; i < end; ++i)
+        {
+            NodeTrackSample& s = mNodeTrackSamples[i];
+            s.valid = s.track->_getWeightedTransform(s.timeIndex, s.weight, 1.0f, s.translate, s.rotate,
+                                                     s.scale);
+        }
+    });
+
+    // apply in order, as nodes notify their shared parents
+    for (const auto& s : mNodeTrackSamples)
+    {
+        if (!s.valid)
+            continue;
+        Node* node = s.track->getAssociatedNode();
+        node->translate(s.translate);
+        node->rotate(s.rotate);
+        node->scale(s.scale);
+    }
+}
+//---------------------------------------------------------------------
+void SceneManager::_updateSkeletalAnimations(void)
+{
+    MovableObjectCollection* entities = getMovableObjectCollection(MOT_ENTITY);
+    OGRE_LOCK_MUTEX(entities->mutex);
+
+    mSkeletalEntities.clear();
+    for (const auto& it : entities->map)
+    {
+        auto e = static_cast<Entity*>(it.second);
+        if (e->isInScene() && e->isVisible() && e->_prepareSkeletonUpdate())
+            mSkeletalEntities.push_back(e);
+    }
+
+    // entities sharing a skeleton instance share the pose, evaluate it once
+    auto bySkeleton = [](const Entity* a, const Entity* b) { return a->getSkeleton() < b->getSkeleton(); };
+    std::sort(mSkeletalEntities.begin(), mSkeletalEntities.end(), bySkeleton);
+    mSkeletalEntities.erase(std::unique(mSkeletalEntities.begin(), mSkeletalEntities.end(),
+                                        [](const Entity* a, const Entity* b)
+                                        { return a->getSkeleton() == b->getSkeleton(); }),
+                            mSkeletalEntities.end());
+
+    Root::getSingleton().getWorkQueue()->parallelFor(
+        mSkeletalEntities.size(), [this](size_t i) { mSkeletalEntities[i]->_updateSkeleton(); });
+}
+//---------------------------------------------------------------------
 void SceneManager::manualRender(RenderOperation* rend, 
                                 Pass* pass, Viewport* vp, const Affine3& worldMatrix,
                                 const Affine3& viewMatrix, const Matrix4& projMatrix,
@@ -3632,6 +3799,14 @@ void SceneManager::bindGpuProgram(GpuProgram* prog)
     // Hash == 1 is almost impossible to achieve otherwise
     mLastLightHash = 1;
     mGpuParamsDirty = (uint16)GPV_ALL;
+
+    GpuProgramType gptype = prog->getType();
+    if (mRenderStatsEnabled && (mStatsPrograms[gptype] != prog || !mDestRenderSystem->isGpuProgramBound(gptype)))
+    {
+        ++mRenderStats.programChanges;
+        mStatsPrograms[gptype] = prog;
+    }
+
     mDestRenderSystem->bindGpuProgram(prog);
 }
 //---------------------------------------------------------------------
@@ -3686,11 +3861,90 @@ void SceneManager::_issueRenderOp(Renderable* rend, const Pass* pass)
         injectGlobalInstancingDeclaration(ro, mDestRenderSystem);
 
         mDestRenderSystem->_render(ro);
+
+        if (mRenderStatsEnabled && mStatsQueueGroup < RENDER_QUEUE_COUNT)
+            ++mRenderStats.queueGroups[mStatsQueueGroup].renderablesRendered;
     }
 
     rend->postRender(this, mDestRenderSystem);
 }
 //---------------------------------------------------------------------
+void SceneManager::setRenderStatsEnabled(bool enabled)
+{
+    mRenderStatsEnabled = enabled;
+    mRenderStats.reset();
+    if (!enabled)
+        getRenderQueue()->_setGroupStats(NULL);
+}
+//---------------------------------------------------------------------
+void SceneManager::resetStatsState(void)
+{
+    mStatsPass = NULL;
+    std::fill(std::begin(mStatsPrograms), std::end(mStatsPrograms), nullptr);
+    mStatsTextures.clear();
+    mStatsSamplers.clear();
+    // the render system starts with the default blend state
+    mStatsBlendState = ColourBlendState();
+}
+//---------------------------------------------------------------------
+void SceneManager::countCulledObjects(const uint32* visibleBefore)
+{
+    uint32 inScene[RENDER_QUEUE_COUNT] = {};
+    for (const auto& c : mMovableObjectCollectionMap)
+    {
+        for (const auto& mo : c.second->map)
+        {
+            if (mo.second->isInScene())
+                ++inScene[mo.second->getRenderQueueGroup()];
+        }
+    }
+
+    for (int i = 0; i < RENDER_QUEUE_COUNT; ++i)
+    {
+        // static geometry regions and the like are queued without being in a collection
+        auto& stats = mRenderStats.queueGroups[i];
+        uint32 visible = stats.objectsVisible - visibleBefore[i];
+        if (inScene[i] > visible)
+            stats.objectsCulled += inScene[i] - visible;
+    }
+}
+//---------------------------------------------------------------------
+void SceneManager::RenderStats::reset()
+{
+    frameNumber = 0;
+    passChanges = programChanges = textureChanges = samplerChanges = blendChanges = 0;
+    constantBytesUploaded = 0;
+    batches = faces = vertices = 0;
+    sceneGraphTime = cullingTime = renderTime = 0;
+    memset(queueGroups, 0, sizeof(queueGroups));
+}
+//---------------------------------------------------------------------
+String SceneManager::RenderStats::toJSON() const
+{
+    StringStream str;
+    str << "{\"frame\": " << frameNumber << ", \"passChanges\": " << passChanges
+        << ", \"programChanges\": " << programChanges << ", \"textureChanges\": " << textureChanges
+        << ", \"samplerChanges\": " << samplerChanges << ", \"blendChanges\": " << blendChanges
+        << ", \"constantBytesUploaded\": " << constantBytesUploaded << ", \"batches\": " << batches
+        << ", \"faces\": " << faces << ", \"vertices\": " << vertices
+        << ", \"timeUs\": {\"sceneGraph\": " << sceneGraphTime << ", \"culling\": " << cullingTime
+        << ", \"render\": " << renderTime << "}, \"queueGroups\": [";
+
+    const char* sep = "";
+    for (int i = 0; i < RENDER_QUEUE_COUNT; ++i)
+    {
+        const auto& g = queueGroups[i];
+        if (!g.objectsVisible && !g.objectsCulled && !g.renderablesQueued && !g.renderablesRendered)
+            continue;
+        str << sep << "{\"id\": " << i << ", \"objectsVisible\": " << g.objectsVisible
+            << ", \"objectsCulled\": " << g.objectsCulled << ", \"renderablesQueued\": " << g.renderablesQueued
+            << ", \"renderablesRendered\": " << g.renderablesRendered << "}";
+        sep = ", ";
+    }
+    str << "]}";
+    return str.str();
+}
+//---------------------------------------------------------------------
 VisibleObjectsBoundsInfo::VisibleObjectsBoundsInfo()
 {
     reset();
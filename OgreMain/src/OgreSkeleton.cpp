@@ -36,19 +36,46 @@ THE SOFTWARE.
 
 namespace Ogre {
 
+    /** Flat pose evaluation state. All per-bone arrays are indexed by evaluation
+        slot, where every bone comes after its parent.
+    */
+    struct Skeleton::FlatPose
+    {
+        /// Slot to bone handle
+        std::vector<ushort> handles;
+        /// Bone handle to slot
+        std::vector<ushort> slots;
+        /// Slot of the parent bone, -1 for roots
+        std::vector<int> parents;
+        /// Initial local pose
+        std::vector<Vector3> bindPosition;
+        std::vector<Quaternion> bindOrientation;
+        std::vector<Vector3> bindScale;
+        /// Inverse of the derived binding pose
+        std::vector<Vector3> invBindPosition;
+        std::vector<Quaternion> invBindOrientation;
+        std::vector<Vector3> invBindScale;
+        /// Working pose, local after sampling and model space after the sweep
+        std::vector<Vector3> position;
+        std::vector<Quaternion> orientation;
+        std::vector<Vector3> scale;
+        bool valid;
+    };
     //---------------------------------------------------------------------
     Skeleton::Skeleton()
         : Resource(),
         mNextAutoHandle(0),
         mBlendState(ANIMBLEND_AVERAGE),
-        mManualBonesDirty(false)
+        mManualBonesDirty(false),
+        mFlatPoseEvaluation(false)
     {
     }
     //---------------------------------------------------------------------
     Skeleton::Skeleton(ResourceManager* creator, const String& name, ResourceHandle handle,
         const String& group, bool isManual, ManualResourceLoader* loader) 
         : Resource(creator, name, handle, group, isManual, loader), 
-        mNextAutoHandle(0), mBlendState(ANIMBLEND_AVERAGE)
+        mNextAutoHandle(0), mBlendState(ANIMBLEND_AVERAGE), mManualBonesDirty(false),
+        mFlatPoseEvaluation(false)
         // set animation blending to weighted, not cumulative
     {
         if (createParamDictionary("Skeleton"))
@@ -95,6 +122,7 @@ namespace Ogre {
         mRootBones.clear();
         mManualBones.clear();
         mManualBonesDirty = false;
+        mFlatPose.reset();
 
         // Destroy animations
         for (auto& ai : mAnimationsList)
@@ -131,6 +159,7 @@ namespace Ogre {
         }
         Bone* ret = OGRE_NEW Bone(handle, this);
         assert(mBoneListByName.find(ret->getName()) == mBoneListByName.end());
+        mFlatPose.reset();
         if (mBoneList.size() <= handle)
         {
             mBoneList.resize(handle+1);
@@ -165,6 +194,7 @@ namespace Ogre {
         {
             mBoneList.resize(handle+1);
         }
+        mFlatPose.reset();
         mBoneList[handle] = ret;
         mBoneListByName[name] = ret;
         return ret;
@@ -191,29 +221,7 @@ namespace Ogre {
         // Reset bones
         reset();
 
-        Real weightFactor = 1.0f;
-        if (mBlendState == ANIMBLEND_AVERAGE)
-        {
-            // Derive total weights so we can rebalance if > 1.0f
-            Real totalWeights = 0.0f;
-            EnabledAnimationStateList::const_iterator animIt;
-            for(animIt = animSet.getEnabledAnimationStates().begin(); animIt != animSet.getEnabledAnimationStates().end(); ++animIt)
-            {
-                const AnimationState* animState = *animIt;
-                // Make sure we have an anim to match implementation
-                const LinkedSkeletonAnimationSource* linked = 0;
-                if (_getAnimationImpl(animState->getAnimationName(), &linked))
-                {
-                    totalWeights += animState->getWeight();
-                }
-            }
-
-            // Allow < 1.0f, allows fade out of all anims if required 
-            if (totalWeights > 1.0f)
-            {
-                weightFactor = 1.0f / totalWeights;
-            }
-        }
+        Real weightFactor = getAnimationWeightFactor(animSet);
 
         // Per enabled animation state
         for(auto *animState : animSet.getEnabledAnimationStates())
@@ -237,12 +245,34 @@ namespace Ogre {
         }
 
 
+    }
+    //---------------------------------------------------------------------
+    Real Skeleton::getAnimationWeightFactor(const AnimationStateSet& animSet) const
+    {
+        if (mBlendState != ANIMBLEND_AVERAGE)
+            return 1.0f;
+
+        // Derive total weights so we can rebalance if > 1.0f
+        Real totalWeights = 0.0f;
+        for (auto *animState : animSet.getEnabledAnimationStates())
+        {
+            // Make sure we have an anim to match implementation
+            const LinkedSkeletonAnimationSource* linked = 0;
+            if (_getAnimationImpl(animState->getAnimationName(), &linked))
+            {
+                totalWeights += animState->getWeight();
+            }
+        }
+
+        // Allow < 1.0f, allows fade out of all anims if required
+        return totalWeights > 1.0f ? 1.0f / totalWeights : 1.0f;
     }
     //---------------------------------------------------------------------
     void Skeleton::setBindingPose(void)
     {
         // Update the derived transforms
         _updateTransforms();
+        mFlatPose.reset();
 
         for (auto *b : mBoneList)
         {            
@@ -446,6 +476,153 @@ namespace Ogre {
             pMatrices++;
         }
 
+    }
+    //---------------------------------------------------------------------
+    void Skeleton::_getBoneMatrices(const AnimationStateSet& animSet, Affine3* pMatrices)
+    {
+        // Manual bones keep their state in the Bone nodes
+        if (!mFlatPoseEvaluation || !mManualBones.empty() || !buildFlatPose())
+        {
+            setAnimationState(animSet);
+            _getBoneMatrices(pMatrices);
+            return;
+        }
+
+        FlatPose& fp = *mFlatPose;
+        const size_t numBones = fp.handles.size();
+
+        // Start from the initial local pose, same as reset()
+        fp.position = fp.bindPosition;
+        fp.orientation = fp.bindOrientation;
+        fp.scale = fp.bindScale;
+
+        // Sample every enabled animation and accumulate it onto the local pose
+        Real weightFactor = getAnimationWeightFactor(animSet);
+        for (auto *animState : animSet.getEnabledAnimationStates())
+        {
+            const LinkedSkeletonAnimationSource* linked = 0;
+            Animation* anim = _getAnimationImpl(animState->getAnimationName(), &linked);
+            // tolerate state entries for animations we're not aware of
+            if (!anim)
+                continue;
+
+            anim->_applyBaseKeyFrame();
+            TimeIndex timeIndex = anim->_getTimeIndex(animState->getTimePosition());
+            Real weight = animState->getWeight() * weightFactor;
+            Real scale = linked ? linked->scale : 1.0f;
+            const AnimationState::BoneBlendMask* blendMask =
+                animState->hasBlendMask() ? animState->getBlendMask() : NULL;
+
+            for (const auto& t : anim->_getNodeTrackList())
+            {
+                assert(t.first < numBones && "Index out of bounds");
+                Real trackWeight = blendMask ? (*blendMask)[t.first] * weight : weight;
+
+                Vector3 translate, trackScale;
+                Quaternion rotate;
+                if (!t.second->_getWeightedTransform(timeIndex, trackWeight, scale, translate, rotate,
+                                                     trackScale))
+                    continue;
+
+                // same composition as Node::translate, Node::rotate and Node::scale
+                ushort slot = fp.slots[t.first];
+                fp.position[slot] += translate;
+                fp.orientation[slot] = fp.orientation[slot] * rotate;
+                fp.orientation[slot].normalise();
+                fp.scale[slot] *= trackScale;
+            }
+        }
+
+        // Local to model space in a single sweep, parents are always resolved first
+        const int* parents = fp.parents.data();
+        Vector3* position = fp.position.data();
+        Quaternion* orientation = fp.orientation.data();
+        Vector3* scale = fp.scale.data();
+        for (size_t i = 0; i < numBones; ++i)
+        {
+            int p = parents[i];
+            if (p < 0)
+                continue;
+
+            position[i] = orientation[p] * (scale[p] * position[i]) + position[p];
+            orientation[i] = orientation[p] * orientation[i];
+            scale[i] = scale[p] * scale[i];
+        }
+
+        // Combine with the inverse binding pose, see Bone::_getOffsetTransform
+        for (size_t i = 0; i < numBones; ++i)
+        {
+            Vector3 locScale = scale[i] * fp.invBindScale[i];
+            Quaternion locRotate = orientation[i] * fp.invBindOrientation[i];
+            Vector3 locTranslate = position[i] + locRotate * (locScale * fp.invBindPosition[i]);
+
+            pMatrices[fp.handles[i]].makeTransform(locTranslate, locScale, locRotate);
+        }
+    }
+    //---------------------------------------------------------------------
+    bool Skeleton::buildFlatPose()
+    {
+        if (mFlatPose)
+            return mFlatPose->valid;
+
+        mFlatPose.reset(new FlatPose);
+        FlatPose& fp = *mFlatPose;
+        fp.valid = false;
+
+#if OGRE_NODE_INHERIT_TRANSFORM
+        // derived transforms are decomposed from full matrices, keep using the nodes
+        return false;
+#else
+        const size_t numBones = mBoneList.size();
+        if (numBones == 0)
+            return false;
+
+        fp.slots.assign(numBones, 0xFFFF);
+        for (auto *b : getRootBones())
+        {
+            fp.slots[b->getHandle()] = ushort(fp.handles.size());
+            fp.handles.push_back(b->getHandle());
+            fp.parents.push_back(-1);
+        }
+
+        // Breadth first, so every bone is placed after its parent
+        for (size_t i = 0; i < fp.handles.size(); ++i)
+        {
+            const Bone* b = mBoneList[fp.handles[i]];
+            if (!b->getInheritOrientation() || !b->getInheritScale())
+                return false;
+
+            for (auto *c : b->getChildren())
+            {
+                const Bone* child = static_cast<const Bone*>(c);
+                ushort handle = child->getHandle();
+                // skip tag points, they are not part of the bone list
+                if (handle >= numBones || mBoneList[handle] != child)
+                    continue;
+
+                fp.slots[handle] = ushort(fp.handles.size());
+                fp.handles.push_back(handle);
+                fp.parents.push_back(int(i));
+            }
+        }
+
+        if (fp.handles.size() != numBones)
+            return false;
+
+        for (ushort handle : fp.handles)
+        {
+            const Bone* b = mBoneList[handle];
+            fp.bindPosition.push_back(b->getInitialPosition());
+            fp.bindOrientation.push_back(b->getInitialOrientation());
+            fp.bindScale.push_back(b->getInitialScale());
+            fp.invBindPosition.push_back(b->_getBindingPoseInversePosition());
+            fp.invBindOrientation.push_back(b->_getBindingPoseInverseOrientation());
+            fp.invBindScale.push_back(b->_getBindingPoseInverseScale());
+        }
+
+        fp.valid = true;
+        return true;
+#endif
     }
     //---------------------------------------------------------------------
     unsigned short Skeleton::getNumAnimations(void) const
@@ -594,6 +771,16 @@ namespace Ogre {
         mManualBonesDirty = false;
     }
     //---------------------------------------------------------------------
+    void Skeleton::compressAllAnimations(Real translationTolerance, const Radian& rotationTolerance,
+                                         Real scaleTolerance)
+    {
+        for (auto& a : mAnimationsList)
+        {
+            for (const auto& t : a.second->_getNodeTrackList())
+                t.second->compress(translationTolerance, rotationTolerance, scaleTolerance);
+        }
+    }
+    //---------------------------------------------------------------------
     void Skeleton::optimiseAllAnimations(bool preservingIdentityNodeTracks)
     {
         if (!preservingIdentityNodeTracks)
@@ -884,26 +1071,46 @@ namespace Ogre {
                     NodeAnimationTrack* dstTrack = dstAnimation->createNodeTrack(dstHandle, this->getBone(dstHandle));
                     dstTrack->setUseShortestRotationPath(srcTrack->getUseShortestRotationPath());
 
-                    ushort numKeyFrames = srcTrack->getNumKeyFrames();
-                    for (ushort k = 0; k < numKeyFrames; ++k)
+                    const CompressedTransformKeys* srcKeys = srcTrack->_getCompressedKeys();
+                    size_t numKeyFrames = srcKeys ? srcKeys->getNumKeys() : srcTrack->getNumKeyFrames();
+                    for (size_t k = 0; k < numKeyFrames; ++k)
                     {
-                        const TransformKeyFrame* srcKeyFrame = srcTrack->getNodeKeyFrame(k);
-                        TransformKeyFrame* dstKeyFrame = dstTrack->createNodeKeyFrame(srcKeyFrame->getTime());
+                        Real time;
+                        Vector3 translate, scale;
+                        Quaternion rotate;
+                        if (srcKeys)
+                        {
+                            time = srcKeys->times[k];
+                            srcKeys->getKey(k, translate, rotate, scale);
+                        }
+                        else
+                        {
+                            const TransformKeyFrame* srcKeyFrame = srcTrack->getNodeKeyFrame(k);
+                            time = srcKeyFrame->getTime();
+                            translate = srcKeyFrame->getTranslate();
+                            rotate = srcKeyFrame->getRotation();
+                            scale = srcKeyFrame->getScale();
+                        }
+                        TransformKeyFrame* dstKeyFrame = dstTrack->createNodeKeyFrame(time);
 
                         // Adjust keyframes to match target binding pose
                         if (deltaTransform.isIdentity)
                         {
-                            dstKeyFrame->setTranslate(srcKeyFrame->getTranslate());
-                            dstKeyFrame->setRotation(srcKeyFrame->getRotation());
-                            dstKeyFrame->setScale(srcKeyFrame->getScale());
+                            dstKeyFrame->setTranslate(translate);
+                            dstKeyFrame->setRotation(rotate);
+                            dstKeyFrame->setScale(scale);
                         }
                         else
                         {
-                            dstKeyFrame->setTranslate(deltaTransform.translate + srcKeyFrame->getTranslate());
-                            dstKeyFrame->setRotation(deltaTransform.rotate * srcKeyFrame->getRotation());
-                            dstKeyFrame->setScale(deltaTransform.scale * srcKeyFrame->getScale());
+                            dstKeyFrame->setTranslate(deltaTransform.translate + translate);
+                            dstKeyFrame->setRotation(deltaTransform.rotate * rotate);
+                            dstKeyFrame->setScale(deltaTransform.scale * scale);
                         }
                     }
+
+                    // the source keys are already reduced, only requantise them
+                    if (srcKeys)
+                        dstTrack->compress(0, Radian(0), 0);
                 }
                 else if (!deltaTransform.isIdentity)
                 {
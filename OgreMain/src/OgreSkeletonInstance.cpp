@@ -150,6 +150,7 @@ namespace Ogre {
         mNextTagPointAutoHandle = 0;
         // construct self from master
         mBlendState = mSkeleton->mBlendState;
+        mFlatPoseEvaluation = mSkeleton->mFlatPoseEvaluation;
         // Copy bones
         BoneList::const_iterator i;
         for (i = mSkeleton->getRootBones().begin(); i != mSkeleton->getRootBones().end(); ++i)
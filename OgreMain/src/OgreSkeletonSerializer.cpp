@@ -37,6 +37,16 @@ namespace Ogre {
     /// stream overhead = ID + size
     const long SSTREAM_OVERHEAD_SIZE = sizeof(uint16) + sizeof(uint32);
     const uint16 HEADER_STREAM_ID_EXT = 0x1000;
+    /// expands a compressed key into a keyframe, for versions without compressed tracks
+    static void decodeKeyFrame(const CompressedTransformKeys& keys, size_t i, TransformKeyFrame& kf)
+    {
+        Vector3 translate, scale;
+        Quaternion rotate;
+        keys.getKey(i, translate, rotate, scale);
+        kf.setTranslate(translate);
+        kf.setRotation(rotate);
+        kf.setScale(scale);
+    }
     //---------------------------------------------------------------------
     SkeletonSerializer::SkeletonSerializer()
     {
@@ -58,6 +68,10 @@ namespace Ogre {
     void SkeletonSerializer::exportSkeleton(const Skeleton* pSkeleton, 
         const DataStreamPtr& stream, SkeletonVersion ver, Endian endianMode)
     {
+        // only compressed tracks need the newer version, keep the rest readable by older releases
+        if ((int)ver > (int)SKELETON_VERSION_1_8 && !hasCompressedTracks(pSkeleton))
+            ver = SKELETON_VERSION_1_8;
+
         setWorkingVersion(ver);
         // Decide on endian mode
         determineEndianness(endianMode);
@@ -118,7 +132,8 @@ namespace Ogre {
         // Read version
         String ver = readString(stream);
         if ((ver != "[Serializer_v1.10]") &&
-            (ver != "[Serializer_v1.80]"))
+            (ver != "[Serializer_v1.80]") &&
+            (ver != "[Serializer_v14.40]"))
         {
             OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
                 "Invalid file: version incompatible, file reports " + String(ver),
@@ -165,12 +180,27 @@ namespace Ogre {
 
     }
     
+    //---------------------------------------------------------------------
+    bool SkeletonSerializer::hasCompressedTracks(const Skeleton* pSkel)
+    {
+        for (unsigned short i = 0; i < pSkel->getNumAnimations(); ++i)
+        {
+            for (const auto& it : pSkel->getAnimation(i)->_getNodeTrackList())
+            {
+                if (it.second->isCompressed())
+                    return true;
+            }
+        }
+        return false;
+    }
     //---------------------------------------------------------------------
     void SkeletonSerializer::setWorkingVersion(SkeletonVersion ver)
     {
         if (ver == SKELETON_VERSION_1_0)
             mVersion = "[Serializer_v1.10]";
-        else mVersion = "[Serializer_v1.80]";
+        else if (ver == SKELETON_VERSION_1_8)
+            mVersion = "[Serializer_v1.80]";
+        else mVersion = "[Serializer_v14.40]";
     }
     //---------------------------------------------------------------------
     void SkeletonSerializer::writeSkeleton(const Skeleton* pSkel, SkeletonVersion ver)
@@ -277,7 +307,7 @@ namespace Ogre {
         // Write all tracks
         for (const auto& it : anim->_getNodeTrackList())
         {
-            writeAnimationTrack(pSkel, it.second);
+            writeAnimationTrack(pSkel, it.second, ver);
         }
         }
         popInnerChunk(mStream);
@@ -285,15 +315,32 @@ namespace Ogre {
     }
     //---------------------------------------------------------------------
     void SkeletonSerializer::writeAnimationTrack(const Skeleton* pSkel, 
-        const NodeAnimationTrack* track)
+        const NodeAnimationTrack* track, SkeletonVersion ver)
     {
-        writeChunkHeader(SKELETON_ANIMATION_TRACK, calcAnimationTrackSize(pSkel, track));
+        writeChunkHeader(SKELETON_ANIMATION_TRACK, calcAnimationTrackSize(pSkel, track, ver));
 
         // unsigned short boneIndex     : Index of bone to apply to
         Bone* bone = static_cast<Bone*>(track->getAssociatedNode());
         unsigned short boneid = bone->getHandle();
         writeShorts(&boneid, 1);
         pushInnerChunk(mStream);
+        if (const CompressedTransformKeys* keys = track->_getCompressedKeys())
+        {
+            if ((int)ver > (int)SKELETON_VERSION_1_8)
+            {
+                writeCompressedKeys(*keys);
+            }
+            else
+            {
+                // older readers only know keyframes, write the decoded keys
+                for (size_t i = 0; i < keys->getNumKeys(); ++i)
+                {
+                    TransformKeyFrame kf(0, keys->times[i]);
+                    decodeKeyFrame(*keys, i, kf);
+                    writeKeyFrame(pSkel, &kf);
+                }
+            }
+        }
         // Write all keyframes
         for (unsigned short i = 0; i < track->getNumKeyFrames(); ++i)
         {
@@ -322,6 +369,41 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    void SkeletonSerializer::writeCompressedKeys(const CompressedTransformKeys& keys)
+    {
+        writeChunkHeader(SKELETON_ANIMATION_TRACK_COMPRESSED, calcCompressedKeysSize(keys));
+
+        uint32 numKeys = uint32(keys.getNumKeys());
+        writeInts(&numKeys, 1);
+        writeFloats(keys.times.data(), numKeys);
+        writeShorts(keys.rotations.data(), keys.rotations.size());
+        writeObject(keys.translateMin);
+        writeObject(keys.translateExtent);
+        writeShorts(keys.translations.data(), keys.translations.size());
+        uint32 numScaleKeys = uint32(keys.scales.size() / 3);
+        writeInts(&numScaleKeys, 1);
+        writeObject(keys.scaleMin);
+        writeObject(keys.scaleExtent);
+        if (numScaleKeys)
+            writeShorts(keys.scales.data(), keys.scales.size());
+    }
+    //---------------------------------------------------------------------
+    size_t SkeletonSerializer::calcCompressedKeysSize(const CompressedTransformKeys& keys)
+    {
+        size_t size = SSTREAM_OVERHEAD_SIZE;
+
+        // numKeys, numScaleKeys
+        size += sizeof(uint32) * 2;
+        // times
+        size += sizeof(float) * keys.times.size();
+        // ranges
+        size += sizeof(float) * 3 * 4;
+        // quantised rotations, translations and scales
+        size += sizeof(uint16) * (keys.rotations.size() + keys.translations.size() + keys.scales.size());
+
+        return size;
+    }
+    //---------------------------------------------------------------------
     size_t SkeletonSerializer::calcBoneSize(const Skeleton* pSkel, 
         const Bone* pBone)
     {
@@ -394,20 +476,37 @@ namespace Ogre {
         // Nested animation tracks
         for (const auto& it : pAnim->_getNodeTrackList())
         {
-            size += calcAnimationTrackSize(pSkel, it.second);
+            size += calcAnimationTrackSize(pSkel, it.second, ver);
         }
 
         return size;
     }
     //---------------------------------------------------------------------
     size_t SkeletonSerializer::calcAnimationTrackSize(const Skeleton* pSkel, 
-        const NodeAnimationTrack* pTrack)
+        const NodeAnimationTrack* pTrack, SkeletonVersion ver)
     {
         size_t size = SSTREAM_OVERHEAD_SIZE;
 
         // unsigned short boneIndex     : Index of bone to apply to
         size += sizeof(unsigned short);
 
+        if (const CompressedTransformKeys* keys = pTrack->_getCompressedKeys())
+        {
+            if ((int)ver > (int)SKELETON_VERSION_1_8)
+            {
+                size += calcCompressedKeysSize(*keys);
+            }
+            else
+            {
+                for (size_t i = 0; i < keys->getNumKeys(); ++i)
+                {
+                    TransformKeyFrame kf(0, keys->times[i]);
+                    decodeKeyFrame(*keys, i, kf);
+                    size += calcKeyFrameSize(pSkel, &kf);
+                }
+            }
+        }
+
         // Nested keyframes
         for (unsigned short i = 0; i < pTrack->getNumKeyFrames(); ++i)
         {
@@ -572,9 +671,13 @@ namespace Ogre {
         {
             pushInnerChunk(stream);
             unsigned short streamID = readChunk(stream);
-            while(streamID == SKELETON_ANIMATION_TRACK_KEYFRAME && !stream->eof())
+            while((streamID == SKELETON_ANIMATION_TRACK_KEYFRAME ||
+                   streamID == SKELETON_ANIMATION_TRACK_COMPRESSED) && !stream->eof())
             {
-                readKeyFrame(stream, pTrack, pSkel);
+                if (streamID == SKELETON_ANIMATION_TRACK_COMPRESSED)
+                    readCompressedKeys(stream, pTrack);
+                else
+                    readKeyFrame(stream, pTrack, pSkel);
 
                 if (!stream->eof())
                 {
@@ -619,6 +722,39 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    void SkeletonSerializer::readCompressedKeys(DataStreamPtr& stream, NodeAnimationTrack* track)
+    {
+        CompressedTransformKeys keys;
+
+        uint32 numKeys;
+        readInts(stream, &numKeys, 1);
+        keys.times.resize(numKeys);
+        readFloats(stream, keys.times.data(), numKeys);
+        keys.rotations.resize(numKeys * 3);
+        readShorts(stream, keys.rotations.data(), keys.rotations.size());
+        readObject(stream, keys.translateMin);
+        readObject(stream, keys.translateExtent);
+        keys.translations.resize(numKeys * 3);
+        readShorts(stream, keys.translations.data(), keys.translations.size());
+        uint32 numScaleKeys;
+        readInts(stream, &numScaleKeys, 1);
+        if (numScaleKeys != 0 && numScaleKeys != numKeys)
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+                        "Invalid compressed track: " + std::to_string(numScaleKeys) + " scale keys for " +
+                            std::to_string(numKeys) + " keys");
+        }
+        readObject(stream, keys.scaleMin);
+        readObject(stream, keys.scaleExtent);
+        if (numScaleKeys)
+        {
+            keys.scales.resize(numScaleKeys * 3);
+            readShorts(stream, keys.scales.data(), keys.scales.size());
+        }
+
+        track->_setCompressedKeys(keys);
+    }
+    //---------------------------------------------------------------------
     void SkeletonSerializer::writeSkeletonAnimationLink(const Skeleton* pSkel, 
         const LinkedSkeletonAnimationSource& link)
     {
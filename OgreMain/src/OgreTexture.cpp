@@ -205,6 +205,30 @@ namespace Ogre {
 
         // Create the texture
         createInternalResources();
+
+        // array layers must not be filtered into each other, so those are left to the RenderSystem
+        if ((mUsage & TU_AUTOMIPMAP) && !mMipmapsHardwareGenerated && mNumMipmaps > 0 &&
+            !PixelUtil::isCompressed(mSrcFormat) && mTextureType != TEX_TYPE_2D_ARRAY)
+        {
+            // the RenderSystem can not generate them, so build the mipmaps here and load them as custom ones
+            std::vector<Image> mipmapped(images.size());
+            ConstImagePtrList mipmappedPtrs;
+            for (size_t i = 0; i < images.size(); ++i)
+            {
+                // the copy only references non owned data, which generateMipmaps then reallocates
+                mipmapped[i] = *images[i];
+                if (mipmapped[i].getNumMipmaps() == 0)
+                    mipmapped[i].generateMipmaps(mHwGamma);
+                mipmappedPtrs.push_back(&mipmapped[i]);
+            }
+
+            if (mipmapped[0].getNumMipmaps() > 0)
+            {
+                _loadImages(mipmappedPtrs);
+                return;
+            }
+        }
+
         // Check if we're loading one image with multiple faces
         // or a vector of images representing the faces
         uint32 faces;
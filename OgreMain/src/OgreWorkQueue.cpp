@@ -29,6 +29,9 @@ THE SOFTWARE.
 #include "OgreWorkQueue.h"
 #include "OgreTimer.h"
 
+#include <atomic>
+#include <thread>
+
 namespace Ogre {
     void WorkQueue::processMainThreadTasks()
     {
@@ -37,6 +40,62 @@ namespace Ogre {
         OGRE_IGNORE_DEPRECATED_END
     }
     //---------------------------------------------------------------------
+    void WorkQueue::parallelFor(size_t count, const std::function<void(size_t)>& func)
+    {
+        // Jobs are claimed from a shared counter, so tasks that start late find nothing left to do
+        // and never touch func, which only lives as long as this call.
+        struct Jobs
+        {
+            const std::function<void(size_t)>* func;
+            size_t count;
+            std::vector<std::exception_ptr> errors;
+            std::atomic<size_t> next;
+            std::atomic<size_t> done;
+
+            void run()
+            {
+                size_t i;
+                while ((i = next++) < count)
+                {
+                    try
+                    {
+                        (*func)(i);
+                    }
+                    catch (...)
+                    {
+                        errors[i] = std::current_exception();
+                    }
+                    done++;
+                }
+            }
+        };
+
+        if (count == 0)
+            return;
+
+        auto jobs = std::make_shared<Jobs>();
+        jobs->func = &func;
+        jobs->count = count;
+        jobs->errors.resize(count);
+        jobs->next = 0;
+        jobs->done = 0;
+
+        size_t numTasks = std::min(getWorkerThreadCount(), count - 1);
+        for (size_t i = 0; i < numTasks; ++i)
+            addTask([jobs]() { jobs->run(); });
+
+        jobs->run();
+
+        while (jobs->done < count)
+            std::this_thread::yield();
+
+        for (const auto& error : jobs->errors)
+        {
+            if (error)
+                std::rethrow_exception(error);
+        }
+    }
+    //---------------------------------------------------------------------
     WorkQueue::Request::Request(uint16 channel, uint16 rtype, const Any& rData, uint8 retry, RequestID rid)
         : mChannel(channel), mType(rtype), mData(rData), mRetryCount(retry), mID(rid), mAborted(false)
     {
@@ -55,6 +55,9 @@ namespace Ogre {
 
         void _affectParticles(ParticleSystem* pSystem, Real timeElapsed) override;
 
+        /// @copydoc ParticleAffector::_prepare
+        void _prepare(ParticleSystem* pSystem) override;
+
         void setImageAdjust(String name);
         String getImageAdjust(void) const;
         
@@ -65,6 +68,8 @@ namespace Ogre {
         Image                   mColourImage;
         bool                    mColourImageLoaded;
         String                  mColourImageName;
+        /// First row of the image, converted once on load
+        std::vector<RGBA>       mColours;
 
         /** Internal method to load the image */
         void _loadImage(void);
@@ -59,8 +59,16 @@ namespace Ogre {
             _loadImage();
         }
 
-        pParticle->mColour = mColourImage.getColourAt(0, 0, 0).getAsBYTE();
-    
+        if (!mColours.empty())
+            pParticle->mColour = mColours[0];
+    }
+    //-----------------------------------------------------------------------
+    void ColourImageAffector::_prepare(ParticleSystem* pSystem)
+    {
+        if (!mColourImageLoaded)
+        {
+            _loadImage();
+        }
     }
     //-----------------------------------------------------------------------
     void ColourImageAffector::_affectParticles(ParticleSystem* pSystem, Real timeElapsed)
@@ -70,42 +78,36 @@ namespace Ogre {
             _loadImage();
         }
 
-        int                width            = (int)mColourImage.getWidth()  - 1;
-        
+        if (mColours.empty())
+            return;
+
+        const int   width   = (int)mColours.size() - 1;
+        const RGBA* colours = mColours.data();
+
         for (auto p : pSystem->_getActiveParticles())
         {
-            const Real      life_time       = p->mTotalTimeToLive;
-            Real            particle_time   = 1.0f - (p->mTimeToLive / life_time);
-
-            if (particle_time > 1.0f)
-                particle_time = 1.0f;
-            if (particle_time < 0.0f)
-                particle_time = 0.0f;
+            Real particle_time = Math::saturate(1.0f - (p->mTimeToLive / p->mTotalTimeToLive));
 
             const Real      float_index     = particle_time * width;
             const int       index           = (int)float_index;
 
-            if(index < 0)
-            {
-                p->mColour = mColourImage.getColourAt(0, 0, 0).getAsBYTE();
-            }
-            else if(index >= width) 
+            if(index >= width)
             {
-                p->mColour = mColourImage.getColourAt(width, 0, 0).getAsBYTE();
+                p->mColour = colours[width];
             }
             else
             {
-                // Linear interpolation
-                const Real      fract       = float_index - (Real)index;
-             
-                ColourValue from=mColourImage.getColourAt(index, 0, 0),
-                            to=mColourImage.getColourAt(index+1, 0, 0);
-
-                p->mColour = Math::lerp(from, to, fract).getAsBYTE();
+                // Linear interpolation of the bytes in fixed point
+                const uint32 fract = uint32((float_index - (Real)index) * 256);
+                const uint8* from = reinterpret_cast<const uint8*>(colours + index);
+                const uint8* to = reinterpret_cast<const uint8*>(colours + index + 1);
+                uint8* dst = reinterpret_cast<uint8*>(&p->mColour);
+
+                for (int c = 0; c < 4; c++)
+                    dst[c] = uint8((from[c] * (256 - fract) + to[c] * fract) >> 8);
             }
         }
     }
-    
     //-----------------------------------------------------------------------
     void ColourImageAffector::setImageAdjust(String name)
     {
@@ -115,6 +117,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void ColourImageAffector::_loadImage(void)
     {
+        mColours.clear();
         mColourImage.load(mColourImageName, mParent->getResourceGroupName());
 
         PixelFormat format = mColourImage.getFormat();
@@ -125,6 +128,10 @@ namespace Ogre {
                     "ColourImageAffector::_loadImage" );
         }
 
+        mColours.resize(mColourImage.getWidth());
+        for (uint32 x = 0; x < mColourImage.getWidth(); x++)
+            mColours[x] = mColourImage.getColourAt(x, 0, 0).getAsBYTE();
+
         mColourImageLoaded = true;
     }
     //-----------------------------------------------------------------------
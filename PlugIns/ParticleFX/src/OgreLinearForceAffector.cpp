@@ -68,27 +68,22 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void LinearForceAffector::_affectParticles(ParticleSystem* pSystem, Real timeElapsed)
     {
-        Vector3 scaledVector = Vector3::ZERO;
-
-        // Precalc scaled force for optimisation
+        // Keep the branch out of the per particle loops
         if (mForceApplication == FA_ADD)
         {
-            // Scale force by time
-            scaledVector = mForceVector * timeElapsed;
-        }
+            // Precalc scaled force for optimisation
+            Vector3 scaledVector = mForceVector * timeElapsed;
 
-        for (auto p : pSystem->_getActiveParticles())
-        {
-            if (mForceApplication == FA_ADD)
-            {
+            for (auto p : pSystem->_getActiveParticles())
                 p->mDirection += scaledVector;
-            }
-            else // FA_AVERAGE
-            {
-                p->mDirection = (p->mDirection + mForceVector) / 2;
-            }
         }
-        
+        else // FA_AVERAGE
+        {
+            Vector3 halfForce = mForceVector * 0.5f;
+
+            for (auto p : pSystem->_getActiveParticles())
+                p->mDirection = p->mDirection * 0.5f + halfForce;
+        }
     }
     //-----------------------------------------------------------------------
     void LinearForceAffector::setForceVector(const Vector3& force)
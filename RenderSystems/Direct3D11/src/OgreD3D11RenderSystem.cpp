@@ -2264,7 +2264,8 @@ namespace Ogre
     {
         if (mask & (uint16)GPV_GLOBAL)
         {
-            params->_updateSharedParams();
+            // dynamic cbuffers must be rewritten as a whole, partial writes go through a staging copy
+            mConstantBytesUploaded += params->_updateSharedParams(false);
         }
 
         if (!mBoundProgram[gptype])
@@ -2274,7 +2275,7 @@ namespace Ogre
 
         if(params->getConstantList().size())
         {
-            auto& cbuffer = updateDefaultUniformBuffer(gptype, params->getConstantList());
+            auto& cbuffer = updateDefaultUniformBuffer(gptype, *params, false);
             buffers[0] = static_cast<D3D11HardwareBuffer*>(cbuffer.get())->getD3DBuffer();
         }
 
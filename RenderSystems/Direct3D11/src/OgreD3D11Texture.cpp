@@ -545,6 +545,7 @@ namespace Ogre
         mDepth = depth;
         mFormat = format;
         mAutoMipMapGeneration = miscflags & D3D11_RESOURCE_MISC_GENERATE_MIPS;
+        mMipmapsHardwareGenerated = mAutoMipMapGeneration;
 
         // Update size (the final size, including temp space because in consumed memory)
         // this is needed in Resource class
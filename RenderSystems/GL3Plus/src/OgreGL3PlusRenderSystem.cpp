@@ -1645,14 +1645,14 @@ namespace Ogre {
 
         if (mask & (uint16)GPV_GLOBAL)
         {
-            params->_updateSharedParams();
+            mConstantBytesUploaded += params->_updateSharedParams();
         }
 
         auto paramsSize = params->getConstantList().size();
         if (paramsSize && getCapabilities()->hasCapability(RSC_SEPARATE_SHADER_OBJECTS) &&
             !params->hasLogicalIndexedParameters())
         {
-            auto& ubo = updateDefaultUniformBuffer(gptype, params->getConstantList());
+            auto& ubo = updateDefaultUniformBuffer(gptype, *params);
 
             int binding = gptype == GPT_COMPUTE_PROGRAM ? 0 : (int(gptype) % GPT_PIPELINE_COUNT);
             static_cast<GL3PlusHardwareBuffer*>(ubo.get())->setGLBufferBinding(binding);
@@ -1606,7 +1606,7 @@ namespace Ogre {
 
         if (mask & (uint16)GPV_GLOBAL)
         {
-            params->_updateSharedParams();
+            mConstantBytesUploaded += params->_updateSharedParams();
         }
     }
 
@@ -6,20 +6,28 @@
 #define __TinyHardwarePixelBuffer_H__
 
 #include "OgreHardwarePixelBuffer.h"
+#include "OgreImage.h"
 
 namespace Ogre {
     class TinyHardwarePixelBuffer: public HardwarePixelBuffer
     {
         PixelBox mBuffer;
+        /// image whose mipmaps are regenerated when this level changes, if any
+        Image* mMipChain;
+        /// whether the mipmaps are filtered in linear space
+        bool mGammaCorrected;
+
+        void generateMipmaps();
     public:
         /// Should be called by HardwareBufferManager
-        TinyHardwarePixelBuffer(const PixelBox& data, Usage usage);
+        TinyHardwarePixelBuffer(const PixelBox& data, Usage usage, Image* mipChain = NULL,
+                                bool gammaCorrected = false);
 
         /// Lock a box
-        PixelBox lockImpl(const Box &lockBox,  LockOptions options) override {  return mBuffer.getSubVolume(lockBox); }
+        PixelBox lockImpl(const Box &lockBox,  LockOptions options) override;
 
         /// Unlock a box
-        void unlockImpl(void) override {}
+        void unlockImpl(void) override;
 
         /// @copydoc HardwarePixelBuffer::blitFromMemory
         void blitFromMemory(const PixelBox &src, const Box &dstBox) override;
@@ -9,6 +9,9 @@
 #include "OgreRenderWindow.h"
 #include "OgreRenderSystem.h"
 #include "OgreImage.h"
+#include "Threading/OgreThreadHeaders.h"
+
+#include <deque>
 
 namespace Ogre {
     /** \addtogroup RenderSystems RenderSystems
@@ -35,13 +38,35 @@ namespace Ogre {
             return (b + (a % b)) % b;
         }
 
-        static const vec4b& sample2D(const Image& img, const vec2& uv)
+        /// mip chain of a bound texture and the state of its sampler
+        struct Sampler2D
         {
-            Vector2i uvi(uv.x * (img.getWidth() - 1), uv.y * (img.getHeight() - 1));
-            return *img.getData<const vec4b>(mod(uvi[0], img.getWidth()), mod(uvi[1], img.getHeight()));
-        }
-
-        virtual bool fragment(const vec3& bar, ColourValue& gl_FragColor) = 0;
+            struct Level
+            {
+                const vec4b* data;
+                int width;
+                int height;
+                int rowPitch;
+            };
+            std::vector<Level> levels;
+
+            FilterOptions minFilter;
+            FilterOptions magFilter;
+            FilterOptions mipFilter;
+            bool clampU;
+            bool clampV;
+
+            Sampler2D();
+            /// use the given PF_BYTE_RGBA image, including its mipmaps
+            void setImage(const Image* img);
+        };
+
+        /** filtered texture lookup
+        @param uv texture coordinates
+        @param dUVdx, dUVdy screen space derivatives of uv, selecting the mip level
+        */
+        static ColourValue sample2D(const Sampler2D& sampler, const vec2& uv, const vec2& dUVdx,
+                                    const vec2& dUVdy);
     };
 
     /**
@@ -56,6 +81,14 @@ namespace Ogre {
 
         struct DefaultShader : public IShader
         {
+            /// output of the vertex stage: clip space position and varyings
+            struct Vertex
+            {
+                vec4 gl_Position;
+                vec2 uv;
+                vec3 normal;
+            };
+
             mat4 uniform_MVP;
             mat4 uniform_Tex;
             mat4 uniform_MVIT;
@@ -64,16 +97,63 @@ namespace Ogre {
 
             bool uniform_doLighting;
 
-            const Image* image;
+            Sampler2D sampler;
 
             vec2 var_uv[3];
             vec3 var_normal[3];
 
-            void vertex(const vec4& vertex, const vec2* uv, const vec3* normal, int gl_VertexID,
-                        vec4& gl_Position);
-            bool fragment(const vec3& bar, ColourValue& gl_FragColor) override;
+            void vertex(const vec4& vertex, const vec2* uv, const vec3* normal, Vertex& out) const;
+            /// set up the varyings for rasterising the given triangle
+            void setTriangle(const Vertex& a, const Vertex& b, const Vertex& c);
+            /**
+            @tparam state the PipelineState this is specialised for
+            @param bar perspective correct barycentric coordinates of the fragment
+            @param bar_dx, bar_dy their change towards the next fragment in x and y, for derivatives
+            */
+            template <int state>
+            bool fragment(const vec3& bar, const vec3& bar_dx, const vec3& bar_dy, ColourValue& gl_FragColor);
         } mDefaultShader;
 
+        /// rasteriser specialised for a pipeline state
+        typedef void (*TriangleFunc)(const Matrix4& viewport, const Vector4f* clipVerts, DefaultShader& shader,
+                                     Image& image, Image& zbuffer);
+
+        /// a draw or clear recorded for rasterisation on the worker thread
+        struct Command
+        {
+            Image* colourBuffer;
+            Image* depthBuffer;
+
+            /// clear, if not 0
+            uint32 clearBuffers;
+            ColourValue clearColour;
+            float clearDepth;
+
+            TriangleFunc rasterise;
+            Matrix4 viewport;
+            DefaultShader shader;
+            /// post-transform vertex cache of the draw, relative to its smallest index
+            std::vector<DefaultShader::Vertex> vertices;
+            /// triangle list indexing vertices
+            std::vector<uint32> indices;
+        };
+
+        /// commands waiting for or in rasterisation, in submission order
+        std::deque<Command> mCommands;
+#if OGRE_THREAD_SUPPORT
+        OGRE_WQ_MUTEX(mCommandMutex);
+        OGRE_WQ_THREAD_SYNCHRONISER(mCommandSync);
+        OGRE_THREAD_TYPE* mWorker;
+        bool mShuttingDown;
+
+        void workerMain();
+#endif
+        void submitCommand(Command& cmd);
+        void executeCommand(Command& cmd);
+
+        void rasteriseTriangle(const DefaultShader::Vertex& a, const DefaultShader::Vertex& b,
+                               const DefaultShader::Vertex& c, Command& cmd);
+
         bool mDepthTest;
         bool mDepthWrite;
         bool mBlendAdd;
@@ -145,6 +225,17 @@ namespace Ogre {
 
         void _render(const RenderOperation& op) override;
 
+        /** Wait until all recorded commands are rasterised
+
+            Draws are recorded and rasterised on a worker thread, while the scene is traversed.
+            So this must be called before accessing the memory of a render target or texture.
+        */
+        void _flushCommands();
+        /// _flushCommands on the active render system, for its textures and windows
+        static void _flushActiveCommands();
+
+        void destroyRenderTarget(const String& name) override;
+
         void setScissorTest(bool enabled, const Rect& rect = Rect()) override;
 
         void clearFrameBuffer(unsigned int buffers,
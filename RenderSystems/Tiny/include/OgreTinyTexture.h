@@ -22,7 +22,7 @@ namespace Ogre {
     protected:
         Image mBuffer;
         void createInternalResourcesImpl(void) override;
-        void freeInternalResourcesImpl(void) override {}
+        void freeInternalResourcesImpl(void) override;
         HardwarePixelBufferPtr createSurface(uint32 face, uint32 mipmap, uint32 width, uint32 height,
                                              uint32 depth) override;
     };
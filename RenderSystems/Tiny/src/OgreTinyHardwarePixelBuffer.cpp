@@ -3,14 +3,41 @@
 // of this distribution and at https://www.ogre3d.org/licensing.
 // SPDX-License-Identifier: MIT
 #include "OgreTinyHardwarePixelBuffer.h"
+#include "OgreTinyRenderSystem.h"
 
 namespace Ogre {
 
-    TinyHardwarePixelBuffer::TinyHardwarePixelBuffer(const PixelBox& data, Usage usage)
-        : HardwarePixelBuffer(data.getWidth(), data.getHeight(), data.getDepth(), data.format, usage, false), mBuffer(data)
+    TinyHardwarePixelBuffer::TinyHardwarePixelBuffer(const PixelBox& data, Usage usage, Image* mipChain,
+                                                     bool gammaCorrected)
+        : HardwarePixelBuffer(data.getWidth(), data.getHeight(), data.getDepth(), data.format, usage, false),
+          mBuffer(data), mMipChain(mipChain), mGammaCorrected(gammaCorrected)
     {
     }
 
+    PixelBox TinyHardwarePixelBuffer::lockImpl(const Box& lockBox, LockOptions options)
+    {
+        TinyRenderSystem::_flushActiveCommands();
+        return mBuffer.getSubVolume(lockBox);
+    }
+
+    void TinyHardwarePixelBuffer::unlockImpl(void)
+    {
+        if (mCurrentLockOptions != HBL_READ_ONLY)
+            generateMipmaps();
+    }
+
+    void TinyHardwarePixelBuffer::generateMipmaps()
+    {
+        if (!mMipChain || mMipChain->getNumMipmaps() == 0)
+            return;
+
+        // the mipmaps of a face follow its top level, so only this face is regenerated
+        Image face;
+        face.loadDynamicImage(mBuffer.data, mBuffer.getWidth(), mBuffer.getHeight(), mBuffer.getDepth(),
+                              mBuffer.format, false, 1, mMipChain->getNumMipmaps());
+        face.generateMipmaps(mGammaCorrected);
+    }
+
     void TinyHardwarePixelBuffer::blitFromMemory(const PixelBox &src, const Box &dstBox)
     {
         if (!mBuffer.contains(dstBox))
@@ -18,6 +45,8 @@ namespace Ogre {
             OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Destination box out of range");
         }
 
+        TinyRenderSystem::_flushActiveCommands();
+
         PixelBox scaled;
         if (src.getSize() != dstBox.getSize())
         {
@@ -31,6 +60,8 @@ namespace Ogre {
             scaled = mBuffer.getSubVolume(dstBox);
             PixelUtil::bulkPixelConversion(src, scaled);
         }
+
+        generateMipmaps();
     }
 
     void TinyHardwarePixelBuffer::blitToMemory(const Box &srcBox, const PixelBox &dst)
@@ -40,6 +71,8 @@ namespace Ogre {
             OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "source box out of range");
         }
 
+        TinyRenderSystem::_flushActiveCommands();
+
         if(srcBox.getSize() != dst.getSize())
         {
             // We need scaling
@@ -43,6 +43,10 @@ namespace Ogre {
 
         mActiveRenderTarget = 0;
         mGLInitialised = false;
+#if OGRE_THREAD_SUPPORT
+        mWorker = NULL;
+        mShuttingDown = false;
+#endif
     }
 
 
@@ -138,11 +142,32 @@ namespace Ogre {
         // Create the texture manager
         mTextureManager = new TinyTextureManager();
 
+#if OGRE_THREAD_SUPPORT
+        mShuttingDown = false;
+        OGRE_THREAD_CREATE(worker, [this]() { workerMain(); });
+        mWorker = worker;
+#endif
+
         mGLInitialised = true;
     }
 
     void TinyRenderSystem::shutdown(void)
     {
+        _flushCommands();
+#if OGRE_THREAD_SUPPORT
+        if (mWorker)
+        {
+            {
+                OGRE_WQ_LOCK_MUTEX(mCommandMutex);
+                mShuttingDown = true;
+                OGRE_THREAD_NOTIFY_ALL(mCommandSync);
+            }
+            mWorker->join();
+            OGRE_THREAD_DESTROY(mWorker);
+            mWorker = NULL;
+        }
+#endif
+
         RenderSystem::shutdown();
 
         OGRE_DELETE mHardwareBufferManager;
@@ -218,15 +243,27 @@ namespace Ogre {
 
         if(!enabled || !texPtr)
         {
-            mDefaultShader.image = NULL;
+            mDefaultShader.sampler.setImage(NULL);
             return;
         }
 
-        mDefaultShader.image = static_cast<TinyTexture*>(texPtr.get())->getImage();
+        mDefaultShader.sampler.setImage(static_cast<TinyTexture*>(texPtr.get())->getImage());
     }
 
     void TinyRenderSystem::_setSampler(size_t unit, Sampler& sampler)
     {
+        if(unit > 0)
+            return;
+
+        auto& dst = mDefaultShader.sampler;
+        dst.minFilter = sampler.getFiltering(FT_MIN);
+        dst.magFilter = sampler.getFiltering(FT_MAG);
+        dst.mipFilter = sampler.getFiltering(FT_MIP);
+
+        // border colour is not supported, so border addressing clamps to the edge
+        const auto& mode = sampler.getAddressingMode();
+        dst.clampU = mode.u == TAM_CLAMP || mode.u == TAM_BORDER;
+        dst.clampV = mode.v == TAM_CLAMP || mode.v == TAM_BORDER;
     }
 
     void TinyRenderSystem::_setAlphaRejectSettings(CompareFunction func, unsigned char value, bool alphaToCoverage)
@@ -303,31 +340,138 @@ namespace Ogre {
     }
 
     void TinyRenderSystem::DefaultShader::vertex(const vec4& vertex, const vec2* uv, const vec3* normal,
-                                                 int gl_VertexID, vec4& gl_Position)
+                                                 Vertex& out) const
+    {
+        out.gl_Position = uniform_MVP * vertex;
+
+        out.uv = uv ? (uniform_Tex*vec4(uv->x, uv->y, 0, 1)).xy() : vec2(0, 0);
+        out.normal = normal ? uniform_MVIT.linear() * *normal : vec3(0, 0, 0);
+    }
+    void TinyRenderSystem::DefaultShader::setTriangle(const Vertex& a, const Vertex& b, const Vertex& c)
+    {
+        var_uv[0] = a.uv;
+        var_uv[1] = b.uv;
+        var_uv[2] = c.uv;
+        var_normal[0] = a.normal;
+        var_normal[1] = b.normal;
+        var_normal[2] = c.normal;
+    }
+    IShader::Sampler2D::Sampler2D()
+        : minFilter(FO_POINT), magFilter(FO_POINT), mipFilter(FO_NONE), clampU(false), clampV(false)
+    {
+    }
+
+    void IShader::Sampler2D::setImage(const Image* img)
+    {
+        levels.clear();
+        if (!img)
+            return;
+
+        for (uint32 mip = 0; mip <= img->getNumMipmaps(); mip++)
+        {
+            PixelBox box = img->getPixelBox(0, mip);
+            levels.push_back({(const vec4b*)box.data, int(box.getWidth()), int(box.getHeight()),
+                              int(box.rowPitch)});
+        }
+    }
+
+    static IShader::vec4 fetch(const IShader::Sampler2D& sampler, const IShader::Sampler2D::Level& level, int x,
+                               int y)
+    {
+        x = sampler.clampU ? Math::Clamp(x, 0, level.width - 1) : IShader::mod(x, level.width);
+        y = sampler.clampV ? Math::Clamp(y, 0, level.height - 1) : IShader::mod(y, level.height);
+        const auto& texel = level.data[y * level.rowPitch + x];
+        return IShader::vec4(texel[0], texel[1], texel[2], texel[3]);
+    }
+
+    static IShader::vec4 sampleLevel(const IShader::Sampler2D& sampler, const IShader::Sampler2D::Level& level,
+                                     const IShader::vec2& uv, bool linear)
+    {
+        float x = uv.x * level.width;
+        float y = uv.y * level.height;
+
+        if (!linear)
+            return fetch(sampler, level, int(std::floor(x)), int(std::floor(y)));
+
+        // relative to the texel centres
+        x -= 0.5f;
+        y -= 0.5f;
+        float x0 = std::floor(x);
+        float y0 = std::floor(y);
+        float fx = x - x0;
+        float fy = y - y0;
+
+        auto top = Math::lerp(fetch(sampler, level, int(x0), int(y0)), fetch(sampler, level, int(x0) + 1, int(y0)), fx);
+        auto bottom = Math::lerp(fetch(sampler, level, int(x0), int(y0) + 1),
+                                 fetch(sampler, level, int(x0) + 1, int(y0) + 1), fx);
+        return Math::lerp(top, bottom, fy);
+    }
+
+    ColourValue IShader::sample2D(const Sampler2D& sampler, const vec2& uv, const vec2& dUVdx, const vec2& dUVdy)
     {
-        gl_Position = uniform_MVP * vertex;
+        const auto& base = sampler.levels[0];
 
-        if(uv)
-            var_uv[gl_VertexID] = (uniform_Tex*vec4(uv->x, uv->y, 0, 1)).xy();
+        bool noMipmaps = sampler.levels.size() == 1 || sampler.mipFilter == FO_NONE;
+        if (noMipmaps && sampler.minFilter == sampler.magFilter)
+        {
+            vec4 texel = sampleLevel(sampler, base, uv, sampler.minFilter >= FO_LINEAR);
+            return ColourValue(texel.x, texel.y, texel.z, texel.w) / 255;
+        }
+
+        vec2 size(base.width, base.height);
+
+        // texels covered per pixel
+        float rho2 = std::max((dUVdx * size).squaredLength(), (dUVdy * size).squaredLength());
+        float lod = 0.5f * std::log2(rho2);
+
+        vec4 texel;
+        if (lod <= 0 || noMipmaps)
+        {
+            bool linear = (lod <= 0 ? sampler.magFilter : sampler.minFilter) >= FO_LINEAR;
+            texel = sampleLevel(sampler, base, uv, linear);
+        }
+        else
+        {
+            bool linear = sampler.minFilter >= FO_LINEAR;
+            float maxLevel = sampler.levels.size() - 1;
+            lod = std::min(lod, maxLevel);
+
+            if (sampler.mipFilter >= FO_LINEAR)
+            {
+                // trilinear
+                size_t level0 = size_t(lod);
+                size_t level1 = std::min(level0 + 1, sampler.levels.size() - 1);
+                texel = Math::lerp(sampleLevel(sampler, sampler.levels[level0], uv, linear),
+                                   sampleLevel(sampler, sampler.levels[level1], uv, linear), lod - level0);
+            }
+            else
+            {
+                texel = sampleLevel(sampler, sampler.levels[size_t(lod + 0.5f)], uv, linear);
+            }
+        }
 
-        if(normal)
-            var_normal[gl_VertexID] = uniform_MVIT.linear() * *normal;
+        return ColourValue(texel.x, texel.y, texel.z, texel.w) / 255;
     }
-    bool TinyRenderSystem::DefaultShader::fragment(const vec3& bar, ColourValue& gl_FragColor)
+
+    template <int state>
+    bool TinyRenderSystem::DefaultShader::fragment(const vec3& bar, const vec3& bar_dx, const vec3& bar_dy,
+                                                   ColourValue& gl_FragColor)
     {
-        if(image)
+        if(state & PS_TEXTURE)
         {
             vec2 uv = var_uv[0]*bar.x + var_uv[1]*bar.y + var_uv[2]*bar.z;
+            vec2 dUVdx = var_uv[0]*bar_dx.x + var_uv[1]*bar_dx.y + var_uv[2]*bar_dx.z;
+            vec2 dUVdy = var_uv[0]*bar_dy.x + var_uv[1]*bar_dy.y + var_uv[2]*bar_dy.z;
 
-            const vec4b& tex = sample2D(*image, uv);
+            ColourValue tex = sample2D(sampler, uv, dUVdx, dUVdy);
 
-            if(tex[3] < 1)
+            if(tex.a * 255 < 1)
                 return true;
 
-            gl_FragColor = ColourValue(tex.ptr());
+            gl_FragColor = tex;
         }
 
-        if(uniform_doLighting)
+        if(state & PS_LIGHTING)
         {
             vec3 n = var_normal[0]*bar.x + var_normal[1]*bar.y + var_normal[2]*bar.z;
             float diffuse = std::max(0.f, n.dotProduct(uniform_lightDir));
@@ -352,6 +496,91 @@ namespace Ogre {
         return ret + element->getOffset() + op.vertexData->vertexStart * step;
     }
 
+    /// draws that may be recorded ahead of the worker
+    static const size_t MAX_PENDING_COMMANDS = 1024;
+
+    enum ClipPlane
+    {
+        CLIP_LEFT = 1,
+        CLIP_RIGHT = 2,
+        CLIP_BOTTOM = 4,
+        CLIP_TOP = 8,
+        CLIP_NEAR = 16,
+        CLIP_FAR = 32
+    };
+
+    static uint8 clipOutcode(const Vector4f& p)
+    {
+        return (p.x < -p.w ? CLIP_LEFT : 0) | (p.x > p.w ? CLIP_RIGHT : 0) | (p.y < -p.w ? CLIP_BOTTOM : 0) |
+               (p.y > p.w ? CLIP_TOP : 0) | (p.z < -p.w ? CLIP_NEAR : 0) | (p.z > p.w ? CLIP_FAR : 0);
+    }
+
+    /// fills a table with the rasteriser variants for all pipeline states
+    template <typename Shader, int state> struct TriangleVariants
+    {
+        typedef void (*Func)(const Matrix4&, const Vector4f*, Shader&, Image&, Image&);
+        static void fill(Func* table)
+        {
+            table[state] = &triangle<state, Shader>;
+            TriangleVariants<Shader, state - 1>::fill(table);
+        }
+    };
+    template <typename Shader> struct TriangleVariants<Shader, -1>
+    {
+        static void fill(typename TriangleVariants<Shader, 0>::Func* table) {}
+    };
+
+    void TinyRenderSystem::rasteriseTriangle(const DefaultShader::Vertex& a, const DefaultShader::Vertex& b,
+                                             const DefaultShader::Vertex& c, Command& cmd)
+    {
+        uint8 codeA = clipOutcode(a.gl_Position);
+        uint8 codeB = clipOutcode(b.gl_Position);
+        uint8 codeC = clipOutcode(c.gl_Position);
+
+        if (codeA & codeB & codeC)
+            return; // completely outside of one plane
+
+        auto draw = [&](const DefaultShader::Vertex& v0, const DefaultShader::Vertex& v1,
+                        const DefaultShader::Vertex& v2) {
+            cmd.shader.setTriangle(v0, v1, v2);
+            vec4 clip_verts[3] = {v0.gl_Position, v1.gl_Position, v2.gl_Position};
+            cmd.rasterise(cmd.viewport, clip_verts, cmd.shader, *cmd.colourBuffer, *cmd.depthBuffer);
+        };
+
+        // the rasteriser clamps to the viewport, which acts as guard band for the side planes.
+        // So only the near plane, where w approaches 0, needs clipping
+        if (!((codeA | codeB | codeC) & CLIP_NEAR))
+        {
+            draw(a, b, c);
+            return;
+        }
+
+        const DefaultShader::Vertex* in[3] = {&a, &b, &c};
+        DefaultShader::Vertex poly[4];
+        int numVerts = 0;
+        for (int i = 0; i < 3; i++)
+        {
+            const auto& p = *in[i];
+            const auto& q = *in[(i + 1) % 3];
+            float dp = p.gl_Position.z + p.gl_Position.w;
+            float dq = q.gl_Position.z + q.gl_Position.w;
+            if (dp >= 0)
+                poly[numVerts++] = p;
+            if ((dp >= 0) != (dq >= 0))
+            {
+                float t = dp / (dp - dq);
+                auto& v = poly[numVerts++];
+                v.gl_Position = p.gl_Position + (q.gl_Position - p.gl_Position) * t;
+                v.uv = p.uv + (q.uv - p.uv) * t;
+                v.normal = p.normal + (q.normal - p.normal) * t;
+            }
+        }
+
+        // triangle fan over the clipped polygon
+        for (int i = 1; i + 1 < numVerts; i++)
+            draw(poly[0], poly[i], poly[i + 1]);
+    }
+
     void TinyRenderSystem::_render(const RenderOperation& op)
     {
         // Call super class.
@@ -374,69 +603,194 @@ namespace Ogre {
 
         mDefaultShader.uniform_doLighting &= bool(normData);
 
-        int16* idx16Data = NULL;
-        int32* idx32Data = NULL;
+        uint16* idx16Data = NULL;
+        uint32* idx32Data = NULL;
         size_t drawCount = op.vertexData->vertexCount;
         if (op.useIndexes)
         {
             if(op.indexData->indexBuffer->getIndexSize() == 2)
             {
-                idx16Data = (int16*)op.indexData->indexBuffer->lock(HardwareBuffer::HBL_NORMAL);
+                idx16Data = (uint16*)op.indexData->indexBuffer->lock(HardwareBuffer::HBL_NORMAL);
                 idx16Data += op.indexData->indexStart;
             }
             else
             {
-                idx32Data = (int32*)op.indexData->indexBuffer->lock(HardwareBuffer::HBL_NORMAL);
+                idx32Data = (uint32*)op.indexData->indexBuffer->lock(HardwareBuffer::HBL_NORMAL);
                 idx32Data += op.indexData->indexStart;
             }
             op.indexData->indexBuffer->unlock();
             drawCount = op.indexData->indexCount;
         }
 
-        Vector3f* v = NULL;
-        Vector2* uv = NULL;
-        Vector3f* n = NULL;
-        vec4 clip_vert[3]; // triangle coordinates (clip coordinates), written by VS, read by FS
+        auto getIndex = [idx16Data, idx32Data](size_t i) -> size_t {
+            return idx16Data ? idx16Data[i] : (idx32Data ? idx32Data[i] : i);
+        };
+
+        // only the vertices referenced by the draw are transformed
+        size_t minIdx = 0;
+        size_t maxIdx = drawCount;
+        if (op.useIndexes)
+        {
+            minIdx = std::numeric_limits<size_t>::max();
+            maxIdx = 0;
+            for (size_t i = 0; i < drawCount; i++)
+            {
+                size_t idx = getIndex(i);
+                minIdx = std::min(minIdx, idx);
+                maxIdx = std::max(maxIdx, idx + 1);
+            }
+        }
+
+        if (minIdx >= maxIdx)
+            return;
+
+        static const std::array<TriangleFunc, PS_VARIANTS> triangleVariants = []() {
+            std::array<TriangleFunc, PS_VARIANTS> ret;
+            TriangleVariants<DefaultShader, PS_VARIANTS - 1>::fill(ret.data());
+            return ret;
+        }();
+
         do
         {
-            for(size_t i = 0; i < drawCount; i += 3)
+            // the vertex buffers may change once this returns, so the vertex stage runs right away
+            // and only rasterisation is deferred
+            Command cmd;
+            cmd.colourBuffer = mActiveColourBuffer;
+            cmd.depthBuffer = mActiveDepthBuffer;
+            cmd.clearBuffers = 0;
+            cmd.viewport = mVP;
+            cmd.shader = mDefaultShader;
+
+            // vertex stage: transform each vertex once, regardless of how many triangles share it
+            cmd.vertices.resize(maxIdx - minIdx);
+#pragma omp parallel for
+            for (int i = 0; i < int(cmd.vertices.size()); i++)
             {
-                if (i && isStrip)
-                    i -= 2;
-                for(int j= 0; j < 3; j++)
-                {
-                    int idx = i + j;
-                    idx = idx16Data ? idx16Data[idx] : (idx32Data ? idx32Data[idx] : idx);
-                    v = (Vector3f*)(posData + posStep*idx);
-                    uv = (Vector2*)(uvData + uvStep*idx);
-                    n = (Vector3f*)(normData + normStep*idx);
-                    mDefaultShader.vertex(vec4(*v), uv, n, j, clip_vert[j]);
-                }
-                triangle(mVP, clip_vert, mDefaultShader, *mActiveColourBuffer, *mActiveDepthBuffer,
-                            mDepthTest, mDepthWrite, mBlendAdd, !isStrip);
+                size_t idx = minIdx + i;
+                auto v = (const Vector3f*)(posData + posStep * idx);
+                auto uv = uvData ? (const Vector2*)(uvData + uvStep * idx) : NULL;
+                auto n = normData ? (const Vector3f*)(normData + normStep * idx) : NULL;
+                mDefaultShader.vertex(vec4(*v), uv, n, cmd.vertices[i]);
             }
 
+            // the state is fixed for all triangles of the draw, so select the matching rasteriser once
+            int state = (mDepthTest ? PS_DEPTH_CHECK : 0) | (mDepthWrite ? PS_DEPTH_WRITE : 0) |
+                        (mBlendAdd ? PS_BLEND_ADD : 0) | (isStrip ? 0 : PS_CULL) |
+                        (mDefaultShader.uniform_doLighting ? PS_LIGHTING : 0) |
+                        (mDefaultShader.sampler.levels.empty() ? 0 : PS_TEXTURE);
+            cmd.rasterise = triangleVariants[state];
+
+            // primitive assembly
+            cmd.indices.reserve(isStrip ? (drawCount - 2) * 3 : drawCount);
+            for (size_t i = 0; i + 2 < drawCount; i += isStrip ? 1 : 3)
+            {
+                for (size_t j = 0; j < 3; j++)
+                    cmd.indices.push_back(uint32(getIndex(i + j) - minIdx));
+            }
+
+            submitCommand(cmd);
         } while (updatePassIterationRenderState());
     }
 
-    void TinyRenderSystem::setScissorTest(bool enabled, const Rect& rect)
+    void TinyRenderSystem::executeCommand(Command& cmd)
     {
+        if (cmd.clearBuffers & FBT_COLOUR)
+            cmd.colourBuffer->setTo(cmd.clearColour);
+        if (cmd.clearBuffers & FBT_DEPTH)
+            cmd.depthBuffer->setTo(ColourValue(cmd.clearDepth));
 
+        for (size_t i = 0; i + 2 < cmd.indices.size(); i += 3)
+        {
+            rasteriseTriangle(cmd.vertices[cmd.indices[i]], cmd.vertices[cmd.indices[i + 1]],
+                              cmd.vertices[cmd.indices[i + 2]], cmd);
+        }
     }
 
-    void TinyRenderSystem::clearFrameBuffer(unsigned int buffers,
-                                               const ColourValue& colour,
-                                               float depth, unsigned short stencil)
+    void TinyRenderSystem::submitCommand(Command& cmd)
     {
-        if (buffers & FBT_COLOUR)
+#if OGRE_THREAD_SUPPORT
+        if (mWorker)
         {
-            mActiveColourBuffer->setTo(colour);
+            OGRE_WQ_LOCK_MUTEX_NAMED(mCommandMutex, lock);
+            // bound the memory held by recorded commands, if traversal is ahead of rasterisation
+            while (mCommands.size() >= MAX_PENDING_COMMANDS)
+                OGRE_THREAD_WAIT(mCommandSync, mCommandMutex, lock);
+
+            mCommands.push_back(std::move(cmd));
+            OGRE_THREAD_NOTIFY_ALL(mCommandSync);
+            return;
         }
-        if (buffers & FBT_DEPTH)
+#endif
+        executeCommand(cmd);
+    }
+
+    void TinyRenderSystem::_flushCommands()
+    {
+#if OGRE_THREAD_SUPPORT
+        OGRE_WQ_LOCK_MUTEX_NAMED(mCommandMutex, lock);
+        // commands are only removed once they are executed
+        while (!mCommands.empty())
+            OGRE_THREAD_WAIT(mCommandSync, mCommandMutex, lock);
+#endif
+    }
+
+    void TinyRenderSystem::_flushActiveCommands()
+    {
+        if (auto root = Root::getSingletonPtr())
         {
-            mActiveDepthBuffer->setTo(ColourValue(depth));
+            if (auto rs = dynamic_cast<TinyRenderSystem*>(root->getRenderSystem()))
+                rs->_flushCommands();
+        }
+    }
+
+#if OGRE_THREAD_SUPPORT
+    void TinyRenderSystem::workerMain()
+    {
+        OGRE_WQ_LOCK_MUTEX_NAMED(mCommandMutex, lock);
+        while (true)
+        {
+            while (mCommands.empty() && !mShuttingDown)
+                OGRE_THREAD_WAIT(mCommandSync, mCommandMutex, lock);
+
+            if (mCommands.empty())
+                return;
+
+            // references to deque elements stay valid while more commands are appended
+            Command& cmd = mCommands.front();
+            lock.unlock();
+            executeCommand(cmd);
+            lock.lock();
+
+            mCommands.pop_front();
+            OGRE_THREAD_NOTIFY_ALL(mCommandSync);
         }
     }
+#endif
+
+    void TinyRenderSystem::destroyRenderTarget(const String& name)
+    {
+        // the worker might still be drawing to it
+        _flushCommands();
+        RenderSystem::destroyRenderTarget(name);
+    }
+
+    void TinyRenderSystem::setScissorTest(bool enabled, const Rect& rect)
+    {
+
+    }
+
+    void TinyRenderSystem::clearFrameBuffer(unsigned int buffers,
+                                               const ColourValue& colour,
+                                               float depth, unsigned short stencil)
+    {
+        Command cmd;
+        cmd.colourBuffer = mActiveColourBuffer;
+        cmd.depthBuffer = mActiveDepthBuffer;
+        cmd.clearBuffers = buffers & (FBT_COLOUR | FBT_DEPTH);
+        cmd.clearColour = colour;
+        cmd.clearDepth = depth;
+        submitCommand(cmd);
+    }
 
     void TinyRenderSystem::_setRenderTarget(RenderTarget *target)
     {
@@ -16,7 +16,7 @@ namespace Ogre {
                                    ManualResourceLoader* loader)
         : Texture(creator, name, handle, group, isManual, loader)
     {
-        mMipmapsHardwareGenerated = false;
+        mMipmapsHardwareGenerated = true;
     }
 
     TinyTexture::~TinyTexture()
@@ -30,7 +30,10 @@ namespace Ogre {
     HardwarePixelBufferPtr TinyTexture::createSurface(uint32 face, uint32 mipmap, uint32 width, uint32 height,
                                                       uint32 depth)
     {
-        return std::make_shared<TinyHardwarePixelBuffer>(mBuffer.getPixelBox(face, mipmap), mUsage);
+        // level 0 keeps the rest of the chain up to date
+        Image* mipChain = (mUsage & TU_AUTOMIPMAP) && mipmap == 0 ? &mBuffer : NULL;
+        return std::make_shared<TinyHardwarePixelBuffer>(mBuffer.getPixelBox(face, mipmap), mUsage, mipChain,
+                                                         mHwGamma);
     }
 
     void TinyTexture::createInternalResourcesImpl(void)
@@ -42,17 +45,18 @@ namespace Ogre {
         // Adjust format if required.
         mFormat = TextureManager::getSingleton().getNativeFormat(mTextureType, mFormat, mUsage);
 
-        mNumMipmaps = mNumRequestedMipmaps = 0;
+        // recorded draws might still sample the previous contents
+        TinyRenderSystem::_flushActiveCommands();
 
         mBuffer.create(mFormat, mWidth, mHeight, mDepth, getNumFaces(), mNumMipmaps);
 
+        // with TU_AUTOMIPMAP, the mipmaps are generated whenever level 0 is written
         createSurfaceList();
+    }
 
-        // Generate mipmaps after all texture levels have been loaded
-        // This is required for compressed formats such as DXT
-        if (mUsage & TU_AUTOMIPMAP)
-        {
-
-        }
+    void TinyTexture::freeInternalResourcesImpl(void)
+    {
+        // recorded draws might still sample it
+        TinyRenderSystem::_flushActiveCommands();
     }
 }
@@ -4,6 +4,7 @@
 // SPDX-License-Identifier: MIT
 
 #include "OgreTinyWindow.h"
+#include "OgreTinyRenderSystem.h"
 #include "OgreException.h"
 #include "OgreStringConverter.h"
 
@@ -37,6 +38,7 @@ void TinyWindow::create(const String& name, uint width, uint height,
 
 void TinyWindow::resize(uint width, uint height)
 {
+    TinyRenderSystem::_flushActiveCommands();
     mBuffer.create(PF_BYTE_RGB, width, height);
     RenderWindow::resize(width, height);
 }
@@ -76,6 +78,8 @@ void TinyWindow::copyContentsToMemory(const Box& src, const PixelBox& dst, Frame
         OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Invalid box");
     }
 
+    TinyRenderSystem::_flushActiveCommands();
+
     PixelUtil::bulkPixelConversion(mBuffer.getPixelBox().getSubVolume(src), dst);
 }
 } // namespace Ogre
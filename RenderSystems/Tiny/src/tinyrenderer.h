@@ -26,21 +26,25 @@ typedef Matrix3 mat3;
 typedef Matrix4 mat4;
 
 
-static vec3 barycentric(const vec2 tri[3], const vec2& P) {
-    mat3 ABC(tri[0].x, tri[1].x, tri[2].x,
-             tri[0].y, tri[1].y, tri[2].y,
-             1,     1,          1);
-    //if (ABC.determinant()<1e-6) return vec3(-1,1,1); // for a degenerate triangle generate negative coordinates, it will be thrown away by the rasterizator
-    return ABC.inverse() * vec3(P.x, P.y, 1);
-}
-
 static float cross(const vec2 &v1, const vec2 &v2) {
     return v1.x * v2.y - v1.y * v2.x;
 }
 
+/// pipeline state the rasteriser and shaders are specialised for
+enum PipelineState
+{
+    PS_DEPTH_CHECK = 1,
+    PS_DEPTH_WRITE = 2,
+    PS_BLEND_ADD = 4,
+    PS_CULL = 8,
+    PS_LIGHTING = 16,
+    PS_TEXTURE = 32,
+    PS_VARIANTS = 64 // number of combinations
+};
+
 /// triangle screen coordinates before persp. division
-static void triangle(const mat4& Viewport, const vec4 clip_verts[3], IShader& shader, Image& image,
-                     Image& zbuffer, bool depthCheck, bool depthWrite, bool blendAdd, bool doCull)
+template <int state, typename Shader>
+static void triangle(const mat4& Viewport, const vec4 clip_verts[3], Shader& shader, Image& image, Image& zbuffer)
 {
     vec4 pts[3]  = { Viewport*clip_verts[0],    Viewport*clip_verts[1],    Viewport*clip_verts[2]    };  // triangle screen coordinates before persp. division
     for (int i = 0; i < 3; i++)
@@ -52,7 +56,7 @@ static void triangle(const mat4& Viewport, const vec4 clip_verts[3], IShader& sh
 
     vec2 pts2[3] = { pts[0].xy(), pts[1].xy(), pts[2].xy() };  // triangle screen coordinates after  perps. division
 
-    if(doCull && cross(pts2[2] - pts2[0], pts2[2] - pts2[1]) > 0)
+    if((state & PS_CULL) && cross(pts2[2] - pts2[0], pts2[2] - pts2[1]) > 0)
         return; // culled
 
     vec2 bboxmin( std::numeric_limits<float>::max(),  std::numeric_limits<float>::max());
@@ -64,32 +68,51 @@ static void triangle(const mat4& Viewport, const vec4 clip_verts[3], IShader& sh
             bboxmax[j] = std::min(clamp[j], std::max(bboxmax[j], pts2[i][j]));
         }
 
+    mat3 ABC(pts2[0].x, pts2[1].x, pts2[2].x,
+             pts2[0].y, pts2[1].y, pts2[2].y,
+             1,         1,         1);
+    mat3 toBarycentric = ABC.inverse(); // screen space barycentric coordinates of (x, y, 1)
+    vec3 bc_dx(toBarycentric[0][0], toBarycentric[1][0], toBarycentric[2][0]);
+    vec3 bc_dy(toBarycentric[0][1], toBarycentric[1][1], toBarycentric[2][1]);
+
+    auto perspectiveCorrect = [&pts](const vec3& bc_screen) {
+        vec3 bc_clip = vec3(bc_screen.x*pts[0][3], bc_screen.y*pts[1][3], bc_screen.z*pts[2][3]);
+        return bc_clip/(bc_clip.x+bc_clip.y+bc_clip.z); // check https://github.com/ssloy/tinyrenderer/wiki/Technical-difficulties-linear-interpolation-with-perspective-deformations
+    };
+
 #pragma omp parallel for
     for (int x=(int)bboxmin.x; x<=(int)bboxmax.x; x++) {
         for (int y=(int)bboxmin.y; y<=(int)bboxmax.y; y++) {
-            vec3 bc_screen  = barycentric(pts2, vec2(x, y));
-            vec3 bc_clip    = vec3(bc_screen.x*pts[0][3], bc_screen.y*pts[1][3], bc_screen.z*pts[2][3]);
-            bc_clip = bc_clip/(bc_clip.x+bc_clip.y+bc_clip.z); // check https://github.com/ssloy/tinyrenderer/wiki/Technical-difficulties-linear-interpolation-with-perspective-deformations
-            float frag_depth = vec3(pts[0][2], pts[1][2], pts[2][2]).dotProduct(bc_clip);
+            vec3 bc_screen  = toBarycentric * vec3(x, y, 1);
             if (bc_screen.x<0 || bc_screen.y<0 || bc_screen.z<0) continue;
+            vec3 bc_clip    = perspectiveCorrect(bc_screen);
+            float frag_depth = vec3(pts[0][2], pts[1][2], pts[2][2]).dotProduct(bc_clip);
 
             if (frag_depth < 0.0)
                 continue;
 
-            if(depthCheck && frag_depth > *zbuffer.getData<float>(x, y))
+            if((state & PS_DEPTH_CHECK) && frag_depth > *zbuffer.getData<float>(x, y))
                 continue;
 
+            // derivatives are only needed for texturing
+            vec3 bar_dx(0, 0, 0), bar_dy(0, 0, 0);
+            if (state & PS_TEXTURE)
+            {
+                bar_dx = perspectiveCorrect(bc_screen + bc_dx) - bc_clip;
+                bar_dy = perspectiveCorrect(bc_screen + bc_dy) - bc_clip;
+            }
+
             ColourValue fragColour;
-            bool discard = shader.fragment(bc_clip, fragColour);
+            bool discard = shader.template fragment<state>(bc_clip, bar_dx, bar_dy, fragColour);
             if (discard) continue;
             auto& dst = *image.getData<vec3b>(x, y);
-            if(blendAdd)
+            if(state & PS_BLEND_ADD)
                 fragColour += ColourValue(vec4b(dst[0], dst[1], dst[2], 0).ptr());
             fragColour.saturate();
             fragColour *= 255;
 
             dst = vec3b(fragColour.ptr());
-            if (depthWrite)
+            if (state & PS_DEPTH_WRITE)
                 *zbuffer.getData<float>(x, y) = frag_depth;
         }
     }
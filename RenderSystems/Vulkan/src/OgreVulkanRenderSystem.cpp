@@ -1123,7 +1123,9 @@ namespace Ogre
 
             mUBODynOffsets[dstUBO] = mAutoParamsBufferPos;
 
+            // every draw gets a fresh ring buffer slot, so the whole block is written regardless of the dirty range
             mAutoParamsBuffer->writeData(mAutoParamsBufferPos, sizeBytes, params->getConstantList().data());
+            mConstantBytesUploaded += sizeBytes;
             mAutoParamsBufferPos += step;
             mAutoParamsBufferUsage[mActiveDevice->mGraphicsQueue.mCurrentFrameIdx] += step;
 
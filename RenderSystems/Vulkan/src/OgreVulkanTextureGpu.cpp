@@ -192,7 +192,8 @@ namespace Ogre
         mCurrLayout( VK_IMAGE_LAYOUT_UNDEFINED ),
         mNextLayout( VK_IMAGE_LAYOUT_UNDEFINED )
     {
-
+        // mipmaps are blitted on the GPU, see _autogenerateMipmaps
+        mMipmapsHardwareGenerated = true;
     }
     //-----------------------------------------------------------------------------------
     VulkanTextureGpu::~VulkanTextureGpu() { unload(); }
@@ -30,6 +30,8 @@ THE SOFTWARE.
 #include "OgreShaderGenerator.h"
 #include "OgreShaderProgramManager.h"
 #include "OgreShaderFunctionAtom.h"
+#include "OgreShaderRenderState.h"
+#include "OgreFileSystemLayer.h"
 
 using namespace Ogre;
 
@@ -103,6 +105,146 @@ TEST_F(RTShaderSystem, TargetRenderState)
     EXPECT_TRUE(pass->hasGpuProgram(GPT_FRAGMENT_PROGRAM));
 }
 
+static RTShader::TargetRenderState* getTargetRenderState(Pass* pass)
+{
+    const Any& data = pass->getUserObjectBindings().getUserAny(RTShader::TargetRenderState::UserKey);
+    return any_cast<RTShader::TargetRenderStatePtr>(data).get();
+}
+
+TEST_F(RTShaderSystem, ShaderCache)
+{
+    auto& shaderGen = RTShader::ShaderGenerator::getSingleton();
+    auto mat = MaterialManager::getSingleton().create("TestMat", RGN_DEFAULT);
+
+    const String cachePath = "RTShaderCacheTest/";
+    FileSystemLayer::createDirectory(cachePath);
+    shaderGen.setShaderCachePath(cachePath);
+
+    shaderGen.createShaderBasedTechnique(mat->getTechniques()[0], "MyScheme");
+    shaderGen.getRenderState("MyScheme")->setLightCountAutoUpdate(false);
+    shaderGen.validateMaterial("MyScheme", *mat);
+
+    auto pass = mat->getTechniques()[1]->getPasses()[0];
+    String signature = getTargetRenderState(pass)->getSignature();
+    ASSERT_FALSE(signature.empty());
+
+    StringVector files = {"ShaderGenerator.tst", signature + ".rtss"};
+    String manifest;
+    for (auto type : {GPT_VERTEX_PROGRAM, GPT_FRAGMENT_PROGRAM})
+    {
+        const String& name = pass->getGpuProgram(type)->getName();
+        String cachedName = "Cached" + name;
+
+        // store the source under a different name, so we can tell where the program came from
+        std::ifstream src((cachePath + name + ".glsl").c_str());
+        std::ofstream dst((cachePath + cachedName + ".glsl").c_str());
+        dst << src.rdbuf();
+        files.push_back(name + ".glsl");
+        files.push_back(cachedName + ".glsl");
+    }
+
+    {
+        std::ifstream in((cachePath + signature + ".rtss").c_str());
+        ASSERT_TRUE(in.good());
+        String line;
+        while (std::getline(in, line))
+        {
+            if (StringUtil::startsWith(line, "program ", false))
+                line = "program Cached" + line.substr(8);
+            manifest += line + "\n";
+        }
+    }
+    std::ofstream((cachePath + signature + ".rtss").c_str()) << manifest;
+
+    // programs are restored from the cache without being generated
+    shaderGen.flushShaderCache();
+    shaderGen.validateMaterial("MyScheme", *mat);
+
+    pass = mat->getTechniques()[1]->getPasses()[0];
+    EXPECT_EQ(getTargetRenderState(pass)->getSignature(), signature);
+    EXPECT_TRUE(StringUtil::startsWith(pass->getGpuProgram(GPT_VERTEX_PROGRAM)->getName(), "cached"));
+    EXPECT_TRUE(StringUtil::startsWith(pass->getGpuProgram(GPT_FRAGMENT_PROGRAM)->getName(), "cached"));
+
+    EXPECT_TRUE(shaderGen.removeShaderBasedTechnique(mat->getTechniques()[0], "MyScheme"));
+    shaderGen.setShaderCachePath("");
+
+    for (const auto& f : files)
+        FileSystemLayer::removeFile(cachePath + f);
+    FileSystemLayer::removeDirectory(cachePath);
+}
+
+TEST_F(RTShaderSystem, ValidateSchemeParallel)
+{
+    auto& shaderGen = RTShader::ShaderGenerator::getSingleton();
+    std::vector<MaterialPtr> mats;
+    for (int i = 0; i < 16; i++)
+    {
+        auto mat = MaterialManager::getSingleton().create(StringUtil::format("TestMat%d", i), RGN_DEFAULT);
+        // alternate between two program variants, so workers race on the shared cache
+        if (i % 2)
+            mat->getTechniques()[0]->getPasses()[0]->setVertexColourTracking(TVC_DIFFUSE);
+        shaderGen.createShaderBasedTechnique(mat->getTechniques()[0], "MyScheme");
+        mats.push_back(mat);
+    }
+    shaderGen.getRenderState("MyScheme")->setLightCountAutoUpdate(false);
+
+    // without workers the passes would be processed on the calling thread
+    mRoot->getWorkQueue()->startup();
+    EXPECT_TRUE(shaderGen.validateSchemeParallel("MyScheme"));
+
+    for (const auto& mat : mats)
+    {
+        ASSERT_EQ(mat->getTechniques().size(), size_t(2));
+        auto pass = mat->getTechniques()[1]->getPasses()[0];
+        EXPECT_TRUE(pass->hasGpuProgram(GPT_VERTEX_PROGRAM));
+        EXPECT_TRUE(pass->hasGpuProgram(GPT_FRAGMENT_PROGRAM));
+    }
+
+    auto pass0 = mats[0]->getTechniques()[1]->getPasses()[0];
+    auto pass1 = mats[1]->getTechniques()[1]->getPasses()[0];
+    EXPECT_NE(getTargetRenderState(pass0)->getSignature(), getTargetRenderState(pass1)->getSignature());
+    EXPECT_NE(pass0->getGpuProgram(GPT_VERTEX_PROGRAM), pass1->getGpuProgram(GPT_VERTEX_PROGRAM));
+
+    // same variant, same programs
+    for (size_t i = 2; i < mats.size(); i++)
+    {
+        auto pass = mats[i]->getTechniques()[1]->getPasses()[0];
+        EXPECT_EQ(pass->getGpuProgram(GPT_VERTEX_PROGRAM), (i % 2 ? pass1 : pass0)->getGpuProgram(GPT_VERTEX_PROGRAM));
+    }
+}
+
+TEST_F(RTShaderSystem, SharedProgramSet)
+{
+    auto& shaderGen = RTShader::ShaderGenerator::getSingleton();
+    std::vector<MaterialPtr> mats;
+    for (int i = 0; i < 4; i++)
+    {
+        auto mat = MaterialManager::getSingleton().create(StringUtil::format("TestMat%d", i), RGN_DEFAULT);
+        auto pass = mat->getTechniques()[0]->getPasses()[0];
+        pass->setDiffuse(ColourValue(0.25f * i, 0, 0));
+        // alpha rejection adds a uniform that is updated per pass
+        if (i > 1)
+            pass->setAlphaRejectSettings(CMPF_GREATER, 128);
+
+        shaderGen.createShaderBasedTechnique(mat->getTechniques()[0], "MyScheme");
+        mats.push_back(mat);
+    }
+    shaderGen.getRenderState("MyScheme")->setLightCountAutoUpdate(false);
+    shaderGen.validateScheme("MyScheme");
+
+    std::vector<RTShader::TargetRenderState*> renderStates;
+    for (const auto& mat : mats)
+        renderStates.push_back(getTargetRenderState(mat->getTechniques()[1]->getPasses()[0]));
+
+    // passes differing only in auto constant values share their programs
+    EXPECT_EQ(renderStates[0]->getSignature(), renderStates[1]->getSignature());
+    EXPECT_EQ(renderStates[0]->getProgramSet(), renderStates[1]->getProgramSet());
+
+    EXPECT_EQ(renderStates[2]->getSignature(), renderStates[3]->getSignature());
+    EXPECT_NE(renderStates[0]->getSignature(), renderStates[2]->getSignature());
+    EXPECT_NE(renderStates[2]->getProgramSet(), renderStates[3]->getProgramSet());
+}
+
 TEST_F(RTShaderSystem, FunctionInvocationOrder)
 {
     using namespace RTShader;
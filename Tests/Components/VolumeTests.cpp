@@ -0,0 +1,266 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "RootWithoutRenderSystemFixture.h"
+#include "OgreVolumeCacheSource.h"
+#include "OgreVolumeChunk.h"
+#include "OgreVolumeCSGSource.h"
+#include "OgreVolumeDualGridGenerator.h"
+#include "OgreVolumeIsoSurfaceMC.h"
+#include "OgreVolumeMeshBuilder.h"
+#include "OgreVolumeOctreeNode.h"
+#include "OgreVolumeOctreeNodeSplitPolicy.h"
+#include "OgreTimer.h"
+#include "OgreSceneManager.h"
+#include "OgreWorkQueue.h"
+
+#include <gtest/gtest.h>
+
+using namespace Ogre;
+using namespace Ogre::Volume;
+
+namespace
+{
+/// Sphere of radius 4 counting its evaluations
+class CountingSource : public Source
+{
+public:
+    mutable int evaluations = 0;
+
+    Vector4 getValueAndGradient(const Vector3& position) const override
+    {
+        evaluations++;
+        return Vector4(-position.x, -position.y, -position.z, 4 - position.length());
+    }
+
+    Real getValue(const Vector3& position) const override { return getValueAndGradient(position).w; }
+};
+
+/// Sphere of radius 4 around (8, 8, 8), which can be carved away completely
+class CarvableSource : public Source
+{
+public:
+    Real offset = 0;
+
+    Vector4 getValueAndGradient(const Vector3& position) const override
+    {
+        Vector3 d = Vector3(8, 8, 8) - position;
+        return Vector4(d.x, d.y, d.z, 4 - d.length() + offset);
+    }
+
+    Real getValue(const Vector3& position) const override { return getValueAndGradient(position).w; }
+};
+}
+
+TEST(VolumeCacheSource, CachesLatticePoints)
+{
+    CountingSource src;
+    CacheSource cache(&src, 0.5);
+
+    Vector3 pos(1.5, -2, 0.5);
+    EXPECT_EQ(cache.getValueAndGradient(pos), src.getValueAndGradient(pos));
+    int evaluations = src.evaluations;
+    EXPECT_EQ(cache.getValueAndGradient(pos), src.getValueAndGradient(pos));
+    EXPECT_EQ(cache.getValue(pos), src.getValue(pos));
+    EXPECT_EQ(src.evaluations, evaluations + 2);
+    EXPECT_EQ(cache.getBrickCount(), 1u);
+
+    // off lattice positions are passed through
+    cache.getValue(Vector3(0.25, 0, 0));
+    cache.getValue(Vector3(0.25, 0, 0));
+    EXPECT_EQ(src.evaluations, evaluations + 4);
+    EXPECT_EQ(cache.getBrickCount(), 1u);
+
+    cache.clear();
+    EXPECT_EQ(cache.getBrickCount(), 0u);
+    cache.getValue(pos);
+    EXPECT_EQ(src.evaluations, evaluations + 5);
+}
+
+TEST(VolumeCacheSource, EvictsLeastRecentlyUsed)
+{
+    CountingSource src;
+    CacheSource cache(&src, 1, 2);
+
+    const Real brick = CacheSource::BRICK_SIZE;
+    cache.getValue(Vector3(0, 0, 0));
+    cache.getValue(Vector3(-brick, 0, 0));
+    cache.getValue(Vector3(0, 0, 0));        // hit, brick 0 becomes most recent
+    cache.getValue(Vector3(0, brick, 0));    // evicts brick -1
+    EXPECT_EQ(cache.getBrickCount(), 2u);
+    EXPECT_EQ(src.evaluations, 3);
+
+    cache.getValue(Vector3(0, 0, 0));
+    EXPECT_EQ(src.evaluations, 3);
+    cache.getValue(Vector3(-brick, 0, 0));
+    EXPECT_EQ(src.evaluations, 4);
+}
+
+TEST(VolumeMeshBuilder, WeldsVertices)
+{
+    MeshBuilder mb;
+    const VecVertex* vertices = 0;
+    const VecIndices* indices = 0;
+
+    struct Capture : public MeshBuilderCallback
+    {
+        const VecVertex*& v;
+        const VecIndices*& i;
+        Capture(const VecVertex*& v_, const VecIndices*& i_) : v(v_), i(i_) {}
+        void ready(const SimpleRenderable*, const VecVertex& vertices, const VecIndices& indices, size_t, int) override
+        {
+            v = &vertices;
+            i = &indices;
+        }
+    } capture(vertices, indices);
+
+    // a grid of quads sharing their corners, enough to force the hash table to grow
+    const int size = 64;
+    for (int y = 0; y < size; y++)
+    {
+        for (int x = 0; x < size; x++)
+        {
+            Vector3 p0(x, y, 0), p1(x + 1, y, 0), p2(x + 1, y + 1, 0), p3(x, y + 1, 0);
+            mb.addTriangle(p0, Vector3::UNIT_Z, p1, Vector3::UNIT_Z, p2, Vector3::UNIT_Z);
+            mb.addTriangle(p0, Vector3::UNIT_Z, p2, Vector3::UNIT_Z, p3, Vector3::UNIT_Z);
+        }
+    }
+    mb.executeCallback(&capture, NULL, 0, 0);
+
+    EXPECT_EQ(mb.getVertexCount(), size_t((size + 1) * (size + 1)));
+    ASSERT_EQ(indices->size(), size_t(size * size * 6));
+    for (size_t i = 0; i < indices->size(); i += 6)
+    {
+        EXPECT_EQ((*indices)[i], (*indices)[i + 3]);
+        EXPECT_EQ((*indices)[i + 2], (*indices)[i + 4]);
+    }
+    EXPECT_EQ((*vertices)[(*indices)[5]].y, 1);
+    EXPECT_EQ(mb.getBoundingBox(), AxisAlignedBox(Vector3::ZERO, Vector3(size, size, 0)));
+
+    // the same position with a different normal is a different vertex
+    mb.clear();
+    mb.addTriangle(Vector3::ZERO, Vector3::UNIT_Z, Vector3::UNIT_X, Vector3::UNIT_Z, Vector3::UNIT_Y, Vector3::UNIT_Z);
+    mb.addTriangle(Vector3::ZERO, Vector3::UNIT_X, Vector3::UNIT_X, Vector3::UNIT_Z, Vector3::UNIT_Y, Vector3::UNIT_Z);
+    EXPECT_EQ(mb.getVertexCount(), 4u);
+    EXPECT_EQ(mb.getBoundingBox(), AxisAlignedBox(Vector3::ZERO, Vector3(1, 1, 0)));
+}
+
+// run with --gtest_also_run_disabled_tests
+TEST(VolumeMeshBuilder, DISABLED_ChunkMeshingThroughput)
+{
+    CSGSphereSource sphere(60, Vector3(64, 64, 64));
+    MeshBuilder mb;
+    const int runs = 10;
+    size_t vertexCount = 0;
+
+    Timer timer;
+    for (int i = 0; i < runs; i++)
+    {
+        OctreeNode root(Vector3::ZERO, Vector3(128, 128, 128));
+        OctreeNodeSplitPolicy policy(&sphere, 1);
+        root.split(&policy, &sphere, 0.5);
+        IsoSurfaceMC is(&sphere);
+        DualGridGenerator dualGridGenerator;
+        mb.clear();
+        dualGridGenerator.generateDualGrid(&root, &is, &mb, 0, Vector3::ZERO, Vector3(128, 128, 128), false);
+        vertexCount += mb.getVertexCount();
+    }
+    auto us = std::max<unsigned long>(timer.getMicroseconds(), 1);
+
+    std::cout << "[ BENCHMARK] " << vertexCount / runs << " vertices per chunk, "
+              << vertexCount * 1000000.0 / us << " vertices/s" << std::endl;
+}
+
+typedef RootWithoutRenderSystemFixture VolumeChunkTests;
+TEST_F(VolumeChunkTests, UpdateDropsPendingLoad)
+{
+    struct TestChunk : public Chunk
+    {
+        int pending() const { return mShared->chunksBeingProcessed; }
+    };
+
+    struct CountLoads : public MeshBuilderCallback
+    {
+        int loads = 0;
+        void ready(const SimpleRenderable*, const VecVertex&, const VecIndices&, size_t, int) override { loads++; }
+    } callback;
+
+    SceneManager* sm = mRoot->createSceneManager();
+    CarvableSource src;
+
+    ChunkParameters parameters;
+    parameters.sceneManager = sm;
+    parameters.src = &src;
+    parameters.baseError = 0.5;
+    parameters.lodCallback = &callback;
+    parameters.async = true;
+
+    // the workers are not running yet, so the load stays pending
+    TestChunk chunk;
+    chunk.load(sm->getRootSceneNode(), Vector3::ZERO, Vector3(16, 16, 16), 1, &parameters);
+    EXPECT_EQ(chunk.pending(), 1);
+
+    // carve out the whole chunk before the pending load arrives
+    src.offset = -100;
+    chunk.update(Vector3::ZERO, Vector3(16, 16, 16));
+
+    WorkQueue* wq = mRoot->getWorkQueue();
+    wq->startup();
+    while (chunk.pending())
+    {
+        OGRE_THREAD_SLEEP(0);
+        wq->processMainThreadTasks();
+    }
+    EXPECT_EQ(callback.loads, 0);
+    EXPECT_FALSE(chunk.isAttached());
+}
+
+TEST_F(VolumeChunkTests, SynchronousUpdate)
+{
+    mRoot->getWorkQueue()->startup();
+
+    SceneManager* sm = mRoot->createSceneManager();
+    CarvableSource src;
+
+    ChunkParameters parameters;
+    parameters.sceneManager = sm;
+    parameters.src = &src;
+    parameters.baseError = 0.5;
+    parameters.async = false;
+
+    Chunk chunk;
+    chunk.load(sm->getRootSceneNode(), Vector3::ZERO, Vector3(16, 16, 16), 1, &parameters);
+    ASSERT_TRUE(chunk.isAttached());
+    Real radius = chunk.getBoundingBox().getHalfSize().x;
+    EXPECT_NEAR(radius, 4, 0.5);
+
+    // grow the sphere, the new mesh must be in place once update returns
+    src.offset = 2;
+    chunk.update(Vector3::ZERO, Vector3(16, 16, 16));
+    EXPECT_NEAR(chunk.getBoundingBox().getHalfSize().x, 6, 0.5);
+    EXPECT_TRUE(chunk.isAttached());
+}
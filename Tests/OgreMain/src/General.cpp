@@ -45,6 +45,8 @@ THE SOFTWARE.
 #include "OgreMesh.h"
 #include "OgreSkeletonManager.h"
 #include "OgreSkeletonInstance.h"
+#include "OgreBone.h"
+#include "OgreSkeletonSerializer.h"
 #include "OgreCompositorManager.h"
 #include "OgreTextureManager.h"
 #include "OgreFileSystem.h"
@@ -53,11 +55,28 @@ THE SOFTWARE.
 #include "OgreHighLevelGpuProgram.h"
 
 #include "OgreKeyFrame.h"
+#include "OgreTimer.h"
 
 #include "OgreBillboardSet.h"
 #include "OgreBillboard.h"
 
+#include "OgreParticleSystemManager.h"
+#include "OgreParticleSystem.h"
+#include "OgreParticleEmitter.h"
+#include "OgreParticleEmitterFactory.h"
+#include "OgreParticle.h"
+#include "OgreControllerManager.h"
+#include "OgreWorkQueue.h"
+#include "OgrePredefinedControllers.h"
+#include "OgreRenderQueue.h"
+#include "OgreAutoParamDataSource.h"
+#include "OgreLight.h"
+#include "OgreSubEntity.h"
+
+#include <atomic>
+#include <deque>
 #include <random>
+#include <thread>
 using std::minstd_rand;
 
 using namespace Ogre;
@@ -277,6 +296,45 @@ TEST_F(SceneQueryTest, Ray) {
     ASSERT_EQ("397", results[1].movable->getName());
 }
 
+TEST_F(SceneQueryTest, RenderStats)
+{
+    RenderQueueGroupStats stats[RENDER_QUEUE_COUNT] = {};
+    RenderQueue* queue = mSceneMgr->getRenderQueue();
+    queue->_setGroupStats(stats);
+
+    VisibleObjectsBoundsInfo bounds;
+    mSceneMgr->_findVisibleObjects(mCamera, &bounds, false);
+    queue->_setGroupStats(NULL);
+
+    // sphere.mesh has a single submesh
+    const auto& mainStats = stats[RENDER_QUEUE_MAIN];
+    EXPECT_GT(mainStats.objectsVisible, 0u);
+    EXPECT_LT(mainStats.objectsVisible, 501u);
+    EXPECT_EQ(mainStats.renderablesQueued, mainStats.objectsVisible);
+
+    SceneManager::RenderStats frame;
+    frame.frameNumber = 3;
+    frame.passChanges = 2;
+    frame.batches = 5;
+    frame.renderTime = 120;
+    frame.queueGroups[RENDER_QUEUE_MAIN] = mainStats;
+    frame.queueGroups[RENDER_QUEUE_MAIN].objectsCulled = 1;
+    frame.queueGroups[RENDER_QUEUE_MAIN].renderablesRendered = 4;
+
+    StringStream expected;
+    expected << "{\"frame\": 3, \"passChanges\": 2, \"programChanges\": 0, \"textureChanges\": 0, "
+             << "\"samplerChanges\": 0, \"blendChanges\": 0, \"constantBytesUploaded\": 0, \"batches\": 5, "
+             << "\"faces\": 0, \"vertices\": 0, \"timeUs\": {\"sceneGraph\": 0, \"culling\": 0, \"render\": 120}, "
+             << "\"queueGroups\": [{\"id\": 50, \"objectsVisible\": " << mainStats.objectsVisible
+             << ", \"objectsCulled\": 1, \"renderablesQueued\": " << mainStats.renderablesQueued
+             << ", \"renderablesRendered\": 4}]}";
+    EXPECT_EQ(frame.toJSON(), expected.str());
+
+    frame.reset();
+    EXPECT_EQ(frame.queueGroups[RENDER_QUEUE_MAIN].objectsVisible, 0u);
+    EXPECT_EQ(frame.batches, 0u);
+}
+
 TEST(MaterialSerializer, Basic)
 {
     Root root;
@@ -384,6 +442,92 @@ TEST(Image, Combine)
     ASSERT_TRUE(!memcmp(combined.getData(), ref.getData(), ref.getSize()));
 }
 
+TEST(Image, ParallelScaleAndConversion)
+{
+    Image src(PF_BYTE_RGBA, 512, 512);
+    std::mt19937 rng(42);
+    for (size_t i = 0; i < src.getSize(); i++)
+        src.getData()[i] = uint8(rng());
+
+    struct Case
+    {
+        PixelFormat srcFormat, dstFormat;
+        Image::Filter filter;
+    };
+    const Case cases[] = {{PF_BYTE_RGBA, PF_BYTE_RGBA, Image::FILTER_BILINEAR},
+                          {PF_BYTE_RGBA, PF_BYTE_BGRA, Image::FILTER_BILINEAR},
+                          {PF_BYTE_RGBA, PF_FLOAT32_RGBA, Image::FILTER_NEAREST},
+                          {PF_FLOAT32_RGBA, PF_FLOAT32_RGBA, Image::FILTER_BILINEAR},
+                          {PF_FLOAT32_RGBA, PF_BYTE_BGRA, Image::FILTER_BILINEAR}};
+
+    // without a Root everything runs serially, with one the rows are split over the WorkQueue
+    auto run = [&]() {
+        std::vector<std::vector<uchar>> results;
+        for (const Case& c : cases)
+        {
+            Image converted(c.srcFormat, src.getWidth(), src.getHeight());
+            PixelUtil::bulkPixelConversion(src.getPixelBox(), converted.getPixelBox());
+            Image scaled(c.dstFormat, 300, 200);
+            Image::scale(converted.getPixelBox(), scaled.getPixelBox(), c.filter);
+            results.emplace_back(converted.getData(), converted.getData() + converted.getSize());
+            results.emplace_back(scaled.getData(), scaled.getData() + scaled.getSize());
+        }
+        return results;
+    };
+
+    auto serial = run();
+    Root root("");
+    root.getWorkQueue()->startup();
+    auto parallel = run();
+
+    ASSERT_EQ(serial.size(), parallel.size());
+    for (size_t i = 0; i < serial.size(); i++)
+        EXPECT_TRUE(serial[i] == parallel[i]) << "result " << i;
+}
+
+TEST(Image, GenerateMipmaps)
+{
+    // one pixel checkerboard averages to grey, which is brighter when filtered in linear space
+    Image checker(PF_BYTE_RGBA, 64, 64);
+    for (uint32 y = 0; y < 64; y++)
+        for (uint32 x = 0; x < 64; x++)
+            checker.setColourAt((x + y) % 2 ? ColourValue::White : ColourValue::Black, x, y, 0);
+
+    Image plain = checker, srgb = checker;
+    plain.generateMipmaps();
+    srgb.generateMipmaps(true);
+    EXPECT_EQ(plain.getNumMipmaps(), 6u);
+    EXPECT_EQ(plain.getPixelBox(0, 6).getWidth(), 1u);
+    EXPECT_EQ(plain.getPixelBox(0, 1).data[0], 128);
+    EXPECT_EQ(srgb.getPixelBox(0, 1).data[0], 188);
+    EXPECT_EQ(srgb.getPixelBox(0, 6).data[0], 188);
+    EXPECT_EQ(srgb.getPixelBox(0, 6).data[3], 255);
+
+    // box filtering odd sizes keeps the mean
+    Image odd(PF_FLOAT32_RGBA, 5, 3);
+    float sum = 0;
+    for (uint32 y = 0; y < 3; y++)
+        for (uint32 x = 0; x < 5; x++)
+        {
+            float v = (x * 3 + y * 7) % 11 / 10.0f;
+            sum += v;
+            odd.setColourAt(ColourValue(v, v, v), x, y, 0);
+        }
+    odd.generateMipmaps();
+    ASSERT_EQ(odd.getNumMipmaps(), 2u);
+    EXPECT_NEAR(odd.getPixelBox(0, 2).getColourAt(0, 0, 0).r, sum / 15, 1e-5);
+
+    // Kaiser weights are normalised, so flat images stay flat
+    Image flat(PF_FLOAT32_RGBA, 32, 16);
+    flat.setTo(ColourValue(0.25, 0.5, 0.75));
+    flat.generateMipmaps(false, Image::FILTER_KAISER);
+    for (uint32 mip = 1; mip <= flat.getNumMipmaps(); mip++)
+    {
+        ColourValue c = flat.getPixelBox(0, mip).getColourAt(0, 0, 0);
+        EXPECT_NEAR(c.g, 0.5, 1e-5);
+    }
+}
+
 TEST(Image, Compressed)
 {
     Root root;
@@ -573,6 +717,274 @@ TEST_F(SkeletonTests, linkedSkeletonAnimationSource)
     EXPECT_TRUE(entity->getAnimationState("Stealth")); // animation from ninja.sekeleton
 }
 
+TEST_F(SkeletonTests, FlatPoseEvaluation)
+{
+    auto skel = static_pointer_cast<Skeleton>(
+        SkeletonManager::getSingleton().load("jaiqua.skeleton", RGN_DEFAULT));
+    SkeletonInstance nodes(skel), flat(skel);
+    nodes.load();
+    flat.load();
+    flat.setFlatPoseEvaluation(true);
+
+    AnimationStateSet animSet;
+    nodes._initAnimationState(&animSet);
+    ASSERT_GE(animSet.getAnimationStates().size(), 2u);
+
+    // blend every animation, with a partial mask on one of them
+    Real weight = 0.8;
+    for (auto& it : animSet.getAnimationStates())
+    {
+        AnimationState* state = it.second;
+        state->setEnabled(true);
+        state->setWeight(weight);
+        state->setTimePosition(state->getLength() * weight * 0.5f);
+        weight *= 0.5;
+    }
+    AnimationState* masked = animSet.getAnimationStates().begin()->second;
+    masked->createBlendMask(nodes.getNumBones(), 0.5f);
+    masked->setBlendMaskEntry(0, 1.0f);
+
+    std::vector<Affine3> expected(nodes.getNumBones()), actual(nodes.getNumBones());
+    for (int pass = 0; pass < 2; pass++)
+    {
+        nodes.setAnimationState(animSet);
+        nodes._getBoneMatrices(expected.data());
+        flat._getBoneMatrices(animSet, actual.data());
+
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            for (int r = 0; r < 3; r++)
+                for (int c = 0; c < 4; c++)
+                    EXPECT_NEAR(expected[i][r][c], actual[i][r][c], 1e-4) << "bone " << i;
+        }
+
+        // the nodes of the flat instance stay in the binding pose
+        EXPECT_EQ(flat.getBone(0)->getPosition(), flat.getBone(0)->getInitialPosition());
+
+        // weights sum above 1, so the first pass covers the average rebalancing
+        nodes.setBlendMode(ANIMBLEND_CUMULATIVE);
+        flat.setBlendMode(ANIMBLEND_CUMULATIVE);
+    }
+}
+
+TEST_F(SkeletonTests, ParallelAnimationUpdate)
+{
+    // the same scene twice, animated serially and in the parallel animation phase
+    SceneManager* sceneMgrs[2] = {mRoot->createSceneManager(), mRoot->createSceneManager()};
+    sceneMgrs[1]->setParallelAnimationUpdate(true);
+
+    SceneNode* movers[2];
+    Entity* entities[2][3];
+    for (int m = 0; m < 2; m++)
+    {
+        SceneManager* sm = sceneMgrs[m];
+        movers[m] = sm->getRootSceneNode()->createChildSceneNode();
+        Animation* anim = sm->createAnimation("move", 4);
+        anim->setInterpolationMode(Animation::IM_SPLINE);
+        NodeAnimationTrack* track = anim->createNodeTrack(0, movers[m]);
+        for (int k = 0; k <= 4; k++)
+            track->createNodeKeyFrame(k)->setTranslate(Vector3(k, k * k, 0));
+        AnimationState* state = sm->createAnimationState("move");
+        state->setEnabled(true);
+        state->setTimePosition(1.3);
+
+        for (auto& e : entities[m])
+        {
+            e = sm->createEntity("jaiqua.mesh");
+            movers[m]->attachObject(e);
+        }
+        entities[m][1]->shareSkeletonInstanceWith(entities[m][0]);
+
+        Real time = 0.5;
+        for (int i : {0, 2})
+        {
+            for (const auto& it : entities[m][i]->getAllAnimationStates()->getAnimationStates())
+            {
+                it.second->setEnabled(true);
+                it.second->setTimePosition(time);
+                time += 0.7;
+            }
+        }
+    }
+
+    sceneMgrs[0]->_applySceneAnimations();
+    sceneMgrs[1]->_applySceneAnimations();
+    sceneMgrs[1]->_updateSkeletalAnimations();
+
+    // the animation phase evaluated every skeleton already
+    for (auto *e : entities[1])
+        EXPECT_FALSE(e->_prepareSkeletonUpdate());
+
+    EXPECT_EQ(movers[0]->getPosition(), movers[1]->getPosition());
+
+    for (int i = 0; i < 3; i++)
+    {
+        entities[0][i]->_updateAnimation();
+        entities[1][i]->_updateAnimation();
+        const Affine3* expected = entities[0][i]->_getBoneMatrices();
+        const Affine3* actual = entities[1][i]->_getBoneMatrices();
+        for (ushort b = 0; b < entities[0][i]->_getNumBoneMatrices(); b++)
+        {
+            for (int r = 0; r < 3; r++)
+                for (int c = 0; c < 4; c++)
+                    EXPECT_NEAR(expected[b][r][c], actual[b][r][c], 1e-4) << "entity " << i << " bone " << b;
+        }
+    }
+}
+
+namespace
+{
+struct SampledPose
+{
+    std::vector<Vector3> translate;
+    std::vector<Quaternion> rotate;
+    std::vector<Vector3> scale;
+};
+
+SampledPose sampleAnimations(const Skeleton* skel)
+{
+    SampledPose pose;
+    for (ushort a = 0; a < skel->getNumAnimations(); a++)
+    {
+        Animation* anim = skel->getAnimation(a);
+        for (const auto& it : anim->_getNodeTrackList())
+        {
+            for (int i = 0; i <= 16; i++)
+            {
+                TransformKeyFrame kf(0, 0);
+                it.second->getInterpolatedKeyFrame(anim->_getTimeIndex(anim->getLength() * i / 16), &kf);
+                pose.translate.push_back(kf.getTranslate());
+                pose.rotate.push_back(kf.getRotation());
+                pose.scale.push_back(kf.getScale());
+            }
+        }
+    }
+    return pose;
+}
+
+String readSkeletonVersion(const MemoryDataStreamPtr& buffer)
+{
+    // after the header id, terminated by a newline
+    const char* ver = (const char*)buffer->getPtr() + sizeof(uint16);
+    return String(ver, std::find(ver, (const char*)buffer->getPtr() + buffer->size(), '\n'));
+}
+} // namespace
+
+TEST_F(SkeletonTests, UncompressedExportVersion)
+{
+    DataStreamPtr src = ResourceGroupManager::getSingleton().openResource("jaiqua.skeleton", RGN_DEFAULT);
+    size_t fileSize = src->size();
+    auto skel = static_pointer_cast<Skeleton>(
+        SkeletonManager::getSingleton().create("UncompressedSkeleton", RGN_DEFAULT, true));
+    SkeletonSerializer().importSkeleton(src, skel.get());
+
+    // readable by releases without compressed tracks
+    auto buffer = std::make_shared<MemoryDataStream>(fileSize);
+    DataStreamPtr stream = buffer;
+    SkeletonSerializer().exportSkeleton(skel.get(), stream);
+    EXPECT_EQ(readSkeletonVersion(buffer), "[Serializer_v1.80]");
+
+    stream = std::make_shared<MemoryDataStream>(buffer->getPtr(), stream->tell());
+    auto reloaded = static_pointer_cast<Skeleton>(
+        SkeletonManager::getSingleton().create("UncompressedSkeleton2", RGN_DEFAULT, true));
+    SkeletonSerializer().importSkeleton(stream, reloaded.get());
+    ASSERT_EQ(reloaded->getNumAnimations(), skel->getNumAnimations());
+    EXPECT_EQ(reloaded->getAnimation(0)->getNumNodeTracks(), skel->getAnimation(0)->getNumNodeTracks());
+}
+
+TEST_F(SkeletonTests, CompressedTracks)
+{
+    auto& mgr = SkeletonManager::getSingleton();
+    DataStreamPtr src = ResourceGroupManager::getSingleton().openResource("jaiqua.skeleton", RGN_DEFAULT);
+    size_t fileSize = src->size();
+    auto skel = static_pointer_cast<Skeleton>(mgr.create("CompressedSkeleton", RGN_DEFAULT, true));
+    SkeletonSerializer().importSkeleton(src, skel.get());
+
+    SampledPose expected = sampleAnimations(skel.get());
+    skel->compressAllAnimations(1e-3, Radian(1e-3), 1e-3);
+    SampledPose actual = sampleAnimations(skel.get());
+
+    ASSERT_EQ(expected.translate.size(), actual.translate.size());
+    for (size_t i = 0; i < expected.translate.size(); i++)
+    {
+        // tolerance plus quantisation error
+        EXPECT_LT(expected.translate[i].distance(actual.translate[i]), 2e-3) << i;
+        EXPECT_TRUE(expected.rotate[i].equals(actual.rotate[i], Radian(3e-3))) << i;
+        EXPECT_LT(expected.scale[i].distance(actual.scale[i]), 2e-3) << i;
+    }
+
+    // the compressed chunks survive a round trip unchanged
+    auto buffer = std::make_shared<MemoryDataStream>(fileSize);
+    DataStreamPtr stream = buffer;
+    SkeletonSerializer().exportSkeleton(skel.get(), stream);
+    EXPECT_EQ(readSkeletonVersion(buffer), "[Serializer_v14.40]");
+    size_t compressedSize = stream->tell();
+    EXPECT_LT(compressedSize, fileSize / 2);
+
+    // read back only what was written
+    stream = std::make_shared<MemoryDataStream>(buffer->getPtr(), compressedSize);
+    auto reloaded = static_pointer_cast<Skeleton>(mgr.create("CompressedSkeleton2", RGN_DEFAULT, true));
+    SkeletonSerializer().importSkeleton(stream, reloaded.get());
+    EXPECT_TRUE(reloaded->getAnimation(0)->_getNodeTrackList().begin()->second->isCompressed());
+
+    SampledPose roundTrip = sampleAnimations(reloaded.get());
+    EXPECT_EQ(actual.translate, roundTrip.translate);
+    EXPECT_EQ(actual.rotate, roundTrip.rotate);
+    EXPECT_EQ(actual.scale, roundTrip.scale);
+
+    // decompressing yields editable keyframes with the same samples
+    NodeAnimationTrack* track = reloaded->getAnimation(0)->_getNodeTrackList().begin()->second;
+    track->decompress();
+    EXPECT_FALSE(track->isCompressed());
+    EXPECT_GT(track->getNumKeyFrames(), 0u);
+
+    // older versions get the decoded keys as keyframes
+    buffer = std::make_shared<MemoryDataStream>(fileSize);
+    stream = buffer;
+    SkeletonSerializer().exportSkeleton(skel.get(), stream, SKELETON_VERSION_1_8);
+    stream = std::make_shared<MemoryDataStream>(buffer->getPtr(), stream->tell());
+    auto legacy = static_pointer_cast<Skeleton>(mgr.create("CompressedSkeleton3", RGN_DEFAULT, true));
+    SkeletonSerializer().importSkeleton(stream, legacy.get());
+    EXPECT_FALSE(legacy->getAnimation(0)->_getNodeTrackList().begin()->second->isCompressed());
+
+    SampledPose decoded = sampleAnimations(legacy.get());
+    EXPECT_EQ(actual.translate, decoded.translate);
+    EXPECT_EQ(actual.rotate, decoded.rotate);
+    EXPECT_EQ(actual.scale, decoded.scale);
+}
+
+TEST_F(SkeletonTests, CompressedTracksInvalidScaleKeys)
+{
+    auto skel = static_pointer_cast<Skeleton>(
+        SkeletonManager::getSingleton().create("InvalidScaleKeys", RGN_DEFAULT, true));
+    Bone* bone = skel->createBone("root");
+    NodeAnimationTrack* track = skel->createAnimation("anim", 3)->createNodeTrack(0, bone);
+    for (int i = 0; i < 4; i++)
+        track->createNodeKeyFrame(i)->setTranslate(Vector3(i * i, 0, i % 2));
+    skel->compressAllAnimations(1e-3, Radian(1e-3), 1e-3);
+    ASSERT_TRUE(track->isCompressed());
+    uint32 numKeys = track->_getCompressedKeys()->getNumKeys();
+
+    auto buffer = std::make_shared<MemoryDataStream>(1024);
+    DataStreamPtr stream = buffer;
+    SkeletonSerializer().exportSkeleton(skel.get(), stream);
+    size_t size = stream->tell();
+
+    // locate the unit scale key count of the compressed chunk and make it inconsistent
+    uchar* data = buffer->getPtr();
+    uint16 chunkId = 0x4120;
+    uchar* chunk = std::search(data, data + size, (uchar*)&chunkId, (uchar*)&chunkId + 2);
+    ASSERT_NE(chunk, data + size);
+    uchar* numScaleKeys = chunk + 6 + 4 + 4 * numKeys + 6 * numKeys + 24 + 6 * numKeys;
+    EXPECT_EQ(*(uint32*)numScaleKeys, 0u);
+    *(uint32*)numScaleKeys = numKeys + 1;
+
+    stream = std::make_shared<MemoryDataStream>(data, size);
+    auto reloaded = static_pointer_cast<Skeleton>(
+        SkeletonManager::getSingleton().create("InvalidScaleKeys2", RGN_DEFAULT, true));
+    EXPECT_THROW(SkeletonSerializer().importSkeleton(stream, reloaded.get()), InvalidParametersException);
+}
+
 TEST(MaterialLoading, LateShadowCaster)
 {
     Root root("");
@@ -646,6 +1058,74 @@ TEST(Light, AnimationTrack)
     EXPECT_EQ(l.getAttenuation(), Vector4f(1.5, 3, 4.5, 6));
 }
 
+TEST(Animation, KeyFrameTimeList)
+{
+    Animation anim("keys", 10.0);
+    // different key rates per track, so the global index and the track maps differ
+    for (ushort h = 0; h < 3; h++)
+    {
+        auto track = anim.createNodeTrack(h);
+        for (int k = 0; k <= 20 * (h + 1); k++)
+            track->createNodeKeyFrame(k * 10.0f / (20 * (h + 1)))->setTranslate(Vector3(k, k * k, h));
+    }
+    anim.getNodeTrack(1)->removeKeyFrame(3);
+    anim.getNodeTrack(2)->compress(0, Radian(0), 0);
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<Real> pos(0, 10);
+    for (int i = 0; i < 1000; i++)
+    {
+        Real t = pos(rng);
+        TimeIndex timeIndex = anim._getTimeIndex(t);
+        ASSERT_TRUE(timeIndex.hasKeyIndex());
+
+        // the global index agrees with searching the track's own key times
+        for (ushort h = 0; h < 3; h++)
+        {
+            TransformKeyFrame a(0, 0), b(0, 0);
+            anim.getNodeTrack(h)->getInterpolatedKeyFrame(timeIndex, &a);
+            anim.getNodeTrack(h)->getInterpolatedKeyFrame(TimeIndex(timeIndex.getTimePos()), &b);
+            EXPECT_EQ(a.getTranslate(), b.getTranslate()) << t;
+        }
+    }
+}
+
+// run with --gtest_also_run_disabled_tests
+TEST(Animation, DISABLED_KeyFrameLookupThroughput)
+{
+    // 60 s clip with 30 keys/s on 100 tracks, played back at 60 fps
+    const int numTracks = 100, numKeys = 1800, numFrames = 3600;
+    Animation anim("long", 60);
+    for (ushort h = 0; h < numTracks; h++)
+    {
+        auto track = anim.createNodeTrack(h);
+        for (int k = 0; k < numKeys; k++)
+            track->createNodeKeyFrame(k * 60.0f / (numKeys - 1))->setTranslate(Vector3(k, h, 0));
+    }
+    anim._getTimeIndex(0);
+
+    auto run = [&](const char* name, const std::function<TimeIndex(Real)>& getTimeIndex) {
+        Vector3 sum = Vector3::ZERO;
+        Timer timer;
+        for (int f = 0; f < numFrames; f++)
+        {
+            TimeIndex timeIndex = getTimeIndex(f / 60.0f);
+            for (const auto& t : anim._getNodeTrackList())
+            {
+                TransformKeyFrame kf(0, 0);
+                t.second->getInterpolatedKeyFrame(timeIndex, &kf);
+                sum += kf.getTranslate();
+            }
+        }
+        auto us = std::max<unsigned long>(timer.getMicroseconds(), 1);
+        std::cout << "[ BENCHMARK] " << name << ": " << numFrames * numTracks * 1.0 / us
+                  << " track samples/us (" << sum.x << ")" << std::endl;
+    };
+
+    run("track search", [](Real t) { return TimeIndex(t); });
+    run("global search", [&](Real t) { return anim._getTimeIndex(t); });
+}
+
 TEST(GpuProgramParams, Variability)
 {
     auto constants = std::make_shared<GpuNamedConstants>();
@@ -663,6 +1143,204 @@ TEST(GpuProgramParams, Variability)
     EXPECT_EQ(params.getConstantDefinition("parameter").variability, GPV_PER_OBJECT);
 }
 
+static void addNamedConstant(GpuNamedConstants& constants, const String& name, GpuConstantType type)
+{
+    GpuConstantDefinition def;
+    def.constType = type;
+    def.elementSize = GpuConstantDefinition::getElementSize(type, false);
+    def.physicalIndex = constants.bufferSize * 4;
+    constants.bufferSize += def.elementSize;
+    constants.map[name] = def;
+}
+
+TEST(GpuProgramParams, AutoConstantPlan)
+{
+    auto constants = std::make_shared<GpuNamedConstants>();
+    addNamedConstant(*constants, "fog", GCT_FLOAT4);
+    addNamedConstant(*constants, "world", GCT_MATRIX_4X4);
+    addNamedConstant(*constants, "ambient", GCT_FLOAT4);
+
+    GpuProgramParameters params;
+    params._setNamedConstants(constants);
+    params.setNamedAutoConstant("fog", GpuProgramParameters::ACT_FOG_COLOUR);
+    params.setNamedAutoConstant("world", GpuProgramParameters::ACT_WORLD_MATRIX);
+    params.setNamedAutoConstant("ambient", GpuProgramParameters::ACT_AMBIENT_LIGHT_COLOUR);
+
+    Affine3 world = Affine3::IDENTITY;
+    world.setTrans(Vector3(1, 2, 3));
+    AutoParamDataSource source;
+    source.setWorldMatrices(&world, 1);
+    source.setFog(FOG_LINEAR, ColourValue::Red, 0, 1, 2);
+    source.setAmbientLightColour(ColourValue::Blue);
+
+    auto worldTrans = [&]() { return params.getFloatPointer(constants->map["world"].physicalIndex)[3]; };
+    auto fogRed = [&]() { return params.getFloatPointer(constants->map["fog"].physicalIndex)[0]; };
+    auto ambientBlue = [&]() { return params.getFloatPointer(constants->map["ambient"].physicalIndex)[2]; };
+
+    // only the matching group is written
+    params._updateAutoParams(&source, GPV_PER_OBJECT);
+    EXPECT_EQ(worldTrans(), 1);
+    EXPECT_EQ(fogRed(), 0);
+    EXPECT_EQ(ambientBlue(), 0);
+
+    params._updateAutoParams(&source, GPV_GLOBAL);
+    EXPECT_EQ(fogRed(), 1);
+    EXPECT_EQ(ambientBlue(), 1);
+
+    // the plan follows changes to the autos
+    params.clearNamedAutoConstant("world");
+    world.setTrans(Vector3(5, 0, 0));
+    params._updateAutoParams(&source, GPV_ALL);
+    EXPECT_EQ(worldTrans(), 1);
+
+    params.setNamedAutoConstant("world", GpuProgramParameters::ACT_WORLD_MATRIX);
+    params._updateAutoParams(&source, GPV_PER_OBJECT);
+    EXPECT_EQ(worldTrans(), 5);
+
+    GpuProgramParameters copy = params;
+    world.setTrans(Vector3(7, 0, 0));
+    copy._updateAutoParams(&source, GPV_PER_OBJECT);
+    EXPECT_EQ(copy.getFloatPointer(constants->map["world"].physicalIndex)[3], 7);
+}
+
+TEST(GpuProgramParams, DirtyRange)
+{
+    auto constants = std::make_shared<GpuNamedConstants>();
+    addNamedConstant(*constants, "world", GCT_MATRIX_4X4);
+    addNamedConstant(*constants, "colour", GCT_FLOAT4);
+    addNamedConstant(*constants, "scale", GCT_FLOAT1);
+
+    GpuProgramParameters params;
+    params._setNamedConstants(constants);
+    size_t size = params.getConstantList().size();
+
+    // new parameters need a full upload
+    EXPECT_EQ(params._getDirtyRange(), std::make_pair(size_t(0), size));
+
+    params._markClean();
+    auto range = params._getDirtyRange();
+    EXPECT_GE(range.first, range.second);
+
+    params.setNamedConstant("colour", ColourValue::Red);
+    size_t colour = constants->map["colour"].physicalIndex;
+    EXPECT_EQ(params._getDirtyRange(), std::make_pair(colour, colour + 16));
+
+    params.setNamedConstant("scale", 2.0f);
+    EXPECT_EQ(params._getDirtyRange(), std::make_pair(colour, size));
+
+    params._markClean();
+    GpuProgramParameters copy = params;
+    EXPECT_EQ(copy._getDirtyRange(), std::make_pair(size_t(0), size));
+
+    // copying shared parameters only touches their destination
+    auto shared = std::make_shared<GpuSharedParameters>("dirty");
+    shared->addConstantDefinition("colour", GCT_FLOAT4);
+    shared->setNamedConstant("colour", ColourValue::Green);
+    params.addSharedParameters(shared);
+    params._copySharedParams();
+    EXPECT_EQ(params._getDirtyRange(), std::make_pair(colour, colour + 16));
+    EXPECT_EQ(params.getFloatPointer(colour)[1], 1);
+}
+
+typedef RootWithoutRenderSystemFixture GpuProgramParamsTests;
+// run with --gtest_also_run_disabled_tests
+TEST_F(GpuProgramParamsTests, DISABLED_UpdateAutoParamsThroughput)
+{
+    SceneManager* sm = mRoot->createSceneManager();
+    Entity* ent = sm->createEntity("ogrehead.mesh");
+    sm->getRootSceneNode()->createChildSceneNode(Vector3(1, 2, 3))->attachObject(ent);
+    Camera* cam = sm->createCamera("cam");
+    sm->getRootSceneNode()->createChildSceneNode(Vector3(0, 0, 50))->attachObject(cam);
+    Light* light = sm->createLight("light", Light::LT_SPOTLIGHT);
+    sm->getRootSceneNode()->createChildSceneNode(Vector3(10, 10, 10))->attachObject(light);
+    LightList lights = {light};
+    Pass* pass = MaterialManager::getSingleton().create("bench", RGN_DEFAULT)->getTechnique(0)->getPass(0);
+
+    // what the RTSS emits for per pixel lighting with fog, vertex and fragment program
+    typedef GpuProgramParameters GPP;
+    const std::vector<std::pair<GPP::AutoConstantType, GpuConstantType>> autos = {
+        {GPP::ACT_WORLDVIEWPROJ_MATRIX, GCT_MATRIX_4X4},
+        {GPP::ACT_WORLDVIEW_MATRIX, GCT_MATRIX_4X4},
+        {GPP::ACT_NORMAL_MATRIX, GCT_MATRIX_3X3},
+        {GPP::ACT_WORLD_MATRIX, GCT_MATRIX_4X4},
+        {GPP::ACT_CAMERA_POSITION, GCT_FLOAT4},
+        {GPP::ACT_FOG_PARAMS, GCT_FLOAT4},
+        {GPP::ACT_FOG_COLOUR, GCT_FLOAT4},
+        {GPP::ACT_DERIVED_AMBIENT_LIGHT_COLOUR, GCT_FLOAT4},
+        {GPP::ACT_DERIVED_SCENE_COLOUR, GCT_FLOAT4},
+        {GPP::ACT_SURFACE_SHININESS, GCT_FLOAT1},
+        {GPP::ACT_LIGHT_POSITION_VIEW_SPACE, GCT_FLOAT4},
+        {GPP::ACT_LIGHT_DIRECTION_VIEW_SPACE, GCT_FLOAT4},
+        {GPP::ACT_LIGHT_ATTENUATION, GCT_FLOAT4},
+        {GPP::ACT_SPOTLIGHT_PARAMS, GCT_FLOAT4},
+        {GPP::ACT_DERIVED_LIGHT_DIFFUSE_COLOUR, GCT_FLOAT4},
+        {GPP::ACT_DERIVED_LIGHT_SPECULAR_COLOUR, GCT_FLOAT4},
+    };
+    auto constants = std::make_shared<GpuNamedConstants>();
+    for (size_t i = 0; i < autos.size(); i++)
+        addNamedConstant(*constants, "p" + std::to_string(i), autos[i].second);
+    GpuProgramParameters params;
+    params._setNamedConstants(constants);
+    for (size_t i = 0; i < autos.size(); i++)
+        params.setNamedAutoConstant("p" + std::to_string(i), autos[i].first);
+
+    AutoParamDataSource source;
+    source.setCurrentSceneManager(sm);
+    source.setCurrentCamera(cam, false);
+    source.setCurrentLightList(&lights);
+    source.setCurrentPass(pass);
+
+    const int numDraws = 200000;
+    auto run = [&](const char* name, uint16 mask) {
+        Timer timer;
+        for (int i = 0; i < numDraws; i++)
+        {
+            source.setCurrentRenderable(ent->getSubEntity(i % ent->getNumSubEntities()));
+            params._updateAutoParams(&source, mask);
+        }
+        auto us = std::max<unsigned long>(timer.getMicroseconds(), 1);
+        std::cout << "[ BENCHMARK] " << name << ": " << us * 1000.0 / numDraws << " ns/draw" << std::endl;
+    };
+
+    source.setCurrentRenderable(ent->getSubEntity(0));
+    params._updateAutoParams(&source, GPV_ALL);
+    run("per object", GPV_PER_OBJECT);
+    run("all", GPV_ALL);
+}
+
+TEST_F(GpuProgramParamsTests, SharedParamsDeltaUpload)
+{
+    GpuSharedParameters shared("delta");
+    shared.addConstantDefinition("viewProj", GCT_MATRIX_4X4);
+    shared.addConstantDefinition("sunColour", GCT_FLOAT4);
+    size_t size = shared.getConstantList().size();
+
+    auto buffer = HardwareBufferManager::getSingleton().createUniformBuffer(size);
+    shared._setHardwareBuffer(buffer);
+
+    shared.setNamedConstant("viewProj", Matrix4::IDENTITY);
+    shared.setNamedConstant("sunColour", ColourValue::White);
+    // first upload covers the whole buffer
+    EXPECT_EQ(shared._upload(), size);
+    shared._markClean();
+    EXPECT_EQ(shared._upload(), 0u);
+
+    shared.setNamedConstant("sunColour", ColourValue::Red);
+    EXPECT_EQ(shared._upload(), 16u);
+    EXPECT_EQ(shared._upload(false), size);
+    shared._markClean();
+
+    std::vector<float> data(size / sizeof(float));
+    buffer->readData(0, size, data.data());
+    EXPECT_EQ(data[0], 1);
+    EXPECT_EQ(data[16], 1);
+    EXPECT_EQ(data[17], 0);
+
+    // writes through the pointer are uploaded too
+    shared.getFloatPointer(0)[0] = 2;
+    EXPECT_EQ(shared._upload(), size);
+}
+
 TEST(Billboard, TextureCoords)
 {
     Root root("");
@@ -695,4 +1373,539 @@ TEST(Billboard, TextureCoords)
             bb->setTexcoordIndex((ysegs - y - 1)*xsegs + x);
         }
     }
-}
\ No newline at end of file
+}
+struct RandomEmitter : public ParticleEmitter
+{
+    RandomEmitter(ParticleSystem* psys) : ParticleEmitter(psys)
+    {
+        mType = "Random";
+        setAngle(Degree(90));
+        setParticleVelocity(1, 10);
+        setTimeToLive(1, 5);
+        setEmissionRate(100);
+    }
+
+    void _initParticle(Particle* p) override
+    {
+        ParticleEmitter::_initParticle(p);
+        p->mPosition = mPosition;
+        genEmissionDirection(mPosition, p->mDirection);
+        genEmissionVelocity(p->mDirection);
+        p->mTimeToLive = p->mTotalTimeToLive = genEmissionTTL();
+    }
+};
+
+struct RandomEmitterFactory : public ParticleEmitterFactory
+{
+    String getName() const override { return "Random"; }
+    ParticleEmitter* createEmitter(ParticleSystem* psys) override { return new RandomEmitter(psys); }
+};
+static RandomEmitterFactory randomEmitterFactory;
+
+typedef RootWithoutRenderSystemFixture ParticleSystemTests;
+TEST_F(ParticleSystemTests, ParallelUpdate)
+{
+    ControllerManager controllerMgr;
+    ParticleSystemManager& mgr = ParticleSystemManager::getSingleton();
+    mgr._initialise();
+    mgr.addEmitterFactory(&randomEmitterFactory);
+    mgr.setParallelUpdates(true);
+    mRoot->getWorkQueue()->startup();
+
+    SceneManager* sm = mRoot->createSceneManager();
+    std::vector<ParticleSystem*> systems;
+    for (int i = 0; i < 8; ++i)
+    {
+        ParticleSystem* ps = sm->createParticleSystem(StringConverter::toString(i), 200);
+        ps->setRandomSeed(42);
+        ps->addEmitter("Random");
+        sm->getRootSceneNode()->createChildSceneNode()->attachObject(ps);
+        systems.push_back(ps);
+    }
+
+    for (int frame = 0; frame < 30; ++frame)
+    {
+        for (auto ps : systems)
+            mgr._queueUpdate(ps, 0.05);
+        mgr._updateQueuedSystems();
+    }
+
+    // same seed and setup, so every system must end up with the same particles
+    auto& reference = systems[0]->_getActiveParticles();
+    ASSERT_GT(reference.size(), 0u);
+    EXPECT_FALSE(systems[0]->getBoundingBox().isNull());
+    for (auto ps : systems)
+    {
+        auto& particles = ps->_getActiveParticles();
+        ASSERT_EQ(particles.size(), reference.size());
+        for (size_t i = 0; i < particles.size(); ++i)
+        {
+            EXPECT_EQ(particles[i]->mPosition, reference[i]->mPosition);
+            EXPECT_EQ(particles[i]->mTimeToLive, reference[i]->mTimeToLive);
+        }
+    }
+
+    sm->destroyAllParticleSystems();
+}
+
+typedef RootWithoutRenderSystemFixture ControllerTests;
+struct AccumulateValue : public ControllerValue<float>
+{
+    float sum = 0;
+    bool offMainThread = false;
+    std::thread::id mainThread = std::this_thread::get_id();
+
+    float getValue() const override { return sum; }
+    void setValue(float value) override
+    {
+        sum += value;
+        offMainThread |= std::this_thread::get_id() != mainThread;
+    }
+};
+
+TEST_F(ControllerTests, ParallelUpdate)
+{
+    ControllerManager mgr;
+    mgr.setParallelUpdates(true);
+    mRoot->getWorkQueue()->startup();
+
+    std::vector<std::shared_ptr<AccumulateValue>> values;
+    for (int i = 0; i < 2000; ++i)
+    {
+        values.push_back(std::make_shared<AccumulateValue>());
+        auto c = mgr.createFrameTimePassthroughController(values.back());
+        c->setUpdateOnMainThread(i % 3 == 0);
+    }
+    // chained to the first controller, so updated after it
+    auto chained = std::make_shared<AccumulateValue>();
+    mgr.createController(values[1], chained, mgr.getPassthroughControllerFunction());
+
+    FrameEvent evt = {0, 0.5};
+    for (int frame = 0; frame < 4; ++frame)
+    {
+        mRoot->_fireFrameStarted(evt);
+        mRoot->_fireFrameRenderingQueued(evt);
+        mgr.updateAllControllers();
+        mgr.updateAllControllers(); // only once per frame
+    }
+
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        EXPECT_FLOAT_EQ(values[i]->sum, 2);
+        if (i % 3 == 0)
+        {
+            EXPECT_FALSE(values[i]->offMainThread);
+        }
+    }
+    EXPECT_FLOAT_EQ(chained->sum, 0.5 + 1 + 1.5 + 2);
+}
+
+TEST_F(ControllerTests, BuiltinControllersParallel)
+{
+    ControllerManager mgr;
+    mgr.setParallelUpdates(true);
+    mRoot->getWorkQueue()->startup();
+
+    Pass* pass = MaterialManager::getSingleton().create("scroll", RGN_DEFAULT)->getTechnique(0)->getPass(0);
+    std::vector<TextureUnitState*> layers;
+    std::vector<ControllerFloat*> controllers;
+    for (int i = 0; i < 300; ++i)
+    {
+        // both scrollers modify the same texture matrix
+        layers.push_back(pass->createTextureUnitState());
+        controllers.push_back(mgr.createTextureUScroller(layers.back(), 0.1));
+        controllers.push_back(mgr.createTextureVScroller(layers.back(), 0.2));
+    }
+    controllers.push_back(mgr.createTextureRotater(layers[0], 1));
+
+    // parameters may be shared by several timers
+    auto params = std::make_shared<GpuProgramParameters>();
+    auto logicalIndexes = std::make_shared<GpuLogicalBufferStruct>();
+    params->_setLogicalIndexes(logicalIndexes);
+    controllers.push_back(mgr.createGpuProgramTimerParam(params, 0, 0.1));
+    controllers.push_back(mgr.createGpuProgramTimerParam(params, 1, 0.2));
+
+    for (auto c : controllers)
+        EXPECT_FALSE(c->getUpdateOnMainThread());
+    EXPECT_EQ(controllers[0]->getUpdateGroup(), controllers[1]->getUpdateGroup());
+    EXPECT_EQ(controllers[0]->getUpdateGroup(), controllers[600]->getUpdateGroup());
+    EXPECT_NE(controllers[0]->getUpdateGroup(), controllers[2]->getUpdateGroup());
+    EXPECT_EQ(controllers[601]->getUpdateGroup(), controllers[602]->getUpdateGroup());
+
+    FrameEvent evt = {0, 0.5};
+    for (int frame = 0; frame < 4; ++frame)
+    {
+        mRoot->_fireFrameStarted(evt);
+        mRoot->_fireFrameRenderingQueued(evt);
+        mgr.updateAllControllers();
+    }
+    EXPECT_EQ(mgr.getNumParallelControllers(), controllers.size());
+
+    for (size_t i = 1; i < layers.size(); ++i)
+    {
+        const Matrix4& xform = layers[i]->getTextureTransform();
+        EXPECT_FLOAT_EQ(xform[0][3], -0.2);
+        EXPECT_FLOAT_EQ(xform[1][3], -0.4);
+    }
+    EXPECT_FLOAT_EQ(params->getFloatPointer(logicalIndexes->map.at(0).physicalIndex)[0], 0.2);
+    EXPECT_FLOAT_EQ(params->getFloatPointer(logicalIndexes->map.at(1).physicalIndex)[0], 0.4);
+}
+
+struct ExclusiveValue : public ControllerValue<float>
+{
+    std::atomic<int>& busy;
+    bool& overlapped;
+    ExclusiveValue(std::atomic<int>& b, bool& o) : busy(b), overlapped(o) {}
+
+    float getValue() const override { return 0; }
+    void setValue(float value) override
+    {
+        if (busy++ != 0)
+            overlapped = true;
+        std::this_thread::yield();
+        busy--;
+    }
+};
+
+TEST_F(ControllerTests, UpdateGroups)
+{
+    ControllerManager mgr;
+    mgr.setParallelUpdates(true);
+    mRoot->getWorkQueue()->startup();
+
+    // many small groups, each sharing a counter behind distinct destination values
+    const int numGroups = 64;
+    std::vector<std::atomic<int>> busy(numGroups);
+    bool overlapped = false;
+    for (int i = 0; i < 4000; ++i)
+    {
+        auto c = mgr.createFrameTimePassthroughController(
+            std::make_shared<ExclusiveValue>(busy[i % numGroups], overlapped));
+        c->setUpdateGroup(&busy[i % numGroups]);
+    }
+
+    FrameEvent evt = {0, 0.5};
+    for (int frame = 0; frame < 4; ++frame)
+    {
+        mRoot->_fireFrameStarted(evt);
+        mRoot->_fireFrameRenderingQueued(evt);
+        mgr.updateAllControllers();
+    }
+    EXPECT_EQ(mgr.getNumParallelControllers(), 4000u);
+    EXPECT_FALSE(overlapped);
+}
+
+typedef RootWithoutRenderSystemFixture BillboardSetTests;
+TEST_F(BillboardSetTests, ParallelGeneration)
+{
+    mRoot->getWorkQueue()->startup();
+
+    SceneManager* sm = mRoot->createSceneManager();
+    Camera* cam = sm->createCamera("cam");
+    sm->getRootSceneNode()->createChildSceneNode(Vector3(0, 0, 500))->attachObject(cam);
+    SceneNode* node = sm->getRootSceneNode()->createChildSceneNode();
+
+    const int count = 10000;
+    BillboardSet* bbs = sm->createBillboardSet(count);
+    bbs->setSortingEnabled(true);
+    bbs->setSortingCoherent(true);
+    node->attachObject(bbs);
+
+    minstd_rand rng;
+    std::uniform_real_distribution<float> dist(-100, 100);
+    for (int i = 0; i < count; ++i)
+    {
+        Billboard* bb = bbs->createBillboard(Vector3(dist(rng), dist(rng), dist(rng)));
+        if (i % 2)
+            bb->setDimensions(dist(rng), dist(rng));
+    }
+
+    // the same billboards injected one by one
+    BillboardSet reference("reference", count, true);
+    node->attachObject(&reference);
+
+    RenderQueue queue;
+    for (int frame = 0; frame < 2; ++frame)
+    {
+        cam->getParentSceneNode()->yaw(Degree(frame * 5));
+        bbs->_notifyCurrentCamera(cam);
+        bbs->_updateRenderQueue(&queue);
+
+        // point billboards are sorted back to front along the view direction
+        Vector3 camDir = cam->getDerivedDirection();
+        for (int i = 1; i < count; ++i)
+        {
+            ASSERT_GE(camDir.dotProduct(bbs->getBillboard(i - 1)->getPosition()),
+                      camDir.dotProduct(bbs->getBillboard(i)->getPosition()));
+        }
+
+        reference._notifyCurrentCamera(cam);
+        reference.beginBillboards(count);
+        for (int i = 0; i < count; ++i)
+            reference.injectBillboard(*bbs->getBillboard(i));
+        reference.endBillboards();
+
+        RenderOperation op, refOp;
+        bbs->getRenderOperation(op);
+        reference.getRenderOperation(refOp);
+        ASSERT_EQ(op.vertexData->vertexCount, refOp.vertexData->vertexCount);
+
+        auto buf = op.vertexData->vertexBufferBinding->getBuffer(0);
+        auto refBuf = refOp.vertexData->vertexBufferBinding->getBuffer(0);
+        size_t size = op.vertexData->vertexCount * buf->getVertexSize();
+        std::vector<uchar> data(size), refData(size);
+        buf->readData(0, size, data.data());
+        refBuf->readData(0, size, refData.data());
+        EXPECT_EQ(data, refData);
+    }
+
+    node->detachObject(&reference);
+}
+
+struct DepthRenderable : public Renderable
+{
+    Real depth;
+    explicit DepthRenderable(Real d) : depth(d) {}
+    const MaterialPtr& getMaterial(void) const override { static MaterialPtr mat; return mat; }
+    void getRenderOperation(RenderOperation& op) override {}
+    void getWorldTransforms(Matrix4* xform) const override { *xform = Matrix4::IDENTITY; }
+    Real getSquaredViewDepth(const Camera* cam) const override { return depth; }
+    const LightList& getLights(void) const override { static LightList lights; return lights; }
+};
+
+struct RecordingVisitor : public QueuedRenderableVisitor
+{
+    std::vector<std::pair<const Pass*, RenderableList> > groups;
+    std::vector<RenderablePass> items;
+    void visit(RenderablePass* rp) override { items.push_back(*rp); }
+    void visit(const Pass* p, RenderableList& rs) override { groups.emplace_back(p, rs); }
+};
+
+typedef RootWithoutRenderSystemFixture RenderQueueTests;
+TEST_F(RenderQueueTests, SortKeys)
+{
+    SceneManager* sm = mRoot->createSceneManager();
+    Camera* cam = sm->createCamera("cam");
+
+    auto tech = MaterialManager::getSingleton().create("sortKeys", RGN_DEFAULT)->createTechnique();
+    Pass* p0 = tech->createPass();
+    Pass* p1 = tech->createPass();
+
+    DepthRenderable r1(3), r2(1), r3(2);
+
+    QueuedRenderableCollection grouped;
+    grouped.addOrganisationMode(QueuedRenderableCollection::OM_PASS_GROUP);
+    QueuedRenderableCollection sorted;
+    sorted.addOrganisationMode(QueuedRenderableCollection::OM_SORT_DESCENDING);
+    for (auto* c : {&grouped, &sorted})
+    {
+        c->addRenderable(p1, &r1);
+        c->addRenderable(p0, &r1);
+        c->addRenderable(p0, &r2);
+        c->addRenderable(p1, &r3);
+        c->addRenderable(p0, &r3);
+        c->sort(cam);
+    }
+
+    // passes in order, each front to back
+    RecordingVisitor visitor;
+    grouped.acceptVisitor(&visitor, QueuedRenderableCollection::OM_PASS_GROUP);
+    ASSERT_EQ(visitor.groups.size(), 2u);
+    EXPECT_EQ(visitor.groups[0].first, p0);
+    EXPECT_EQ(visitor.groups[0].second, RenderableList({&r2, &r3, &r1}));
+    EXPECT_EQ(visitor.groups[1].first, p1);
+    EXPECT_EQ(visitor.groups[1].second, RenderableList({&r3, &r1}));
+
+    // back to front, passes of a renderable in order
+    sorted.acceptVisitor(&visitor, QueuedRenderableCollection::OM_SORT_DESCENDING);
+    ASSERT_EQ(visitor.items.size(), 5u);
+    EXPECT_EQ(visitor.items[0].renderable, &r1);
+    EXPECT_EQ(visitor.items[0].pass, p0);
+    EXPECT_EQ(visitor.items[1].pass, p1);
+    EXPECT_EQ(visitor.items[2].renderable, &r3);
+    EXPECT_EQ(visitor.items[4].renderable, &r2);
+
+    // the radix sort path orders the same way
+    minstd_rand rng;
+    std::uniform_real_distribution<float> dist(0, 1000);
+    std::deque<DepthRenderable> many;
+    for (int i = 0; i < 3000; ++i)
+        many.emplace_back(dist(rng));
+
+    grouped.clear();
+    sorted.clear();
+    for (auto& r : many)
+    {
+        grouped.addRenderable(&r == &many[0] ? p1 : p0, &r);
+        sorted.addRenderable(p0, &r);
+    }
+    grouped.sort(cam);
+    sorted.sort(cam);
+
+    visitor.items.clear();
+    sorted.acceptVisitor(&visitor, QueuedRenderableCollection::OM_SORT_DESCENDING);
+    ASSERT_EQ(visitor.items.size(), many.size());
+    for (size_t i = 1; i < visitor.items.size(); ++i)
+        ASSERT_GE(static_cast<DepthRenderable*>(visitor.items[i - 1].renderable)->depth,
+                  static_cast<DepthRenderable*>(visitor.items[i].renderable)->depth);
+
+    visitor.groups.clear();
+    grouped.acceptVisitor(&visitor, QueuedRenderableCollection::OM_PASS_GROUP);
+    ASSERT_EQ(visitor.groups.size(), 2u);
+    EXPECT_EQ(visitor.groups[0].second.size(), many.size() - 1);
+    EXPECT_EQ(visitor.groups[1].second, RenderableList({&many[0]}));
+}
+
+TEST_F(RenderQueueTests, EqualPassHash)
+{
+    SceneManager* sm = mRoot->createSceneManager();
+    Camera* cam = sm->createCamera("cam");
+
+    // first passes of different techniques, no programs or textures, so the hashes match
+    auto mat = MaterialManager::getSingleton().create("equalHash", RGN_DEFAULT);
+    Pass* p0 = mat->createTechnique()->createPass();
+
+    // created 4096 passes apart, so a 12 bit creation counter would not tell them apart
+    Technique* filler = MaterialManager::getSingleton().create("filler", RGN_DEFAULT)->createTechnique();
+    for (int i = 0; i < 4095; ++i)
+        filler->createPass();
+
+    Pass* p1 = mat->createTechnique()->createPass();
+    ASSERT_EQ(p0->getHash(), p1->getHash());
+
+    std::deque<DepthRenderable> rends;
+    QueuedRenderableCollection grouped;
+    grouped.addOrganisationMode(QueuedRenderableCollection::OM_PASS_GROUP);
+    for (int i = 0; i < 10; ++i)
+    {
+        rends.emplace_back(Real(i));
+        grouped.addRenderable(i % 2 ? p1 : p0, &rends.back());
+    }
+    grouped.sort(cam);
+
+    // one group per pass, each front to back
+    RecordingVisitor visitor;
+    grouped.acceptVisitor(&visitor, QueuedRenderableCollection::OM_PASS_GROUP);
+    ASSERT_EQ(visitor.groups.size(), 2u);
+    const auto& g0 = visitor.groups[0].first == p0 ? visitor.groups[0] : visitor.groups[1];
+    const auto& g1 = visitor.groups[0].first == p0 ? visitor.groups[1] : visitor.groups[0];
+    EXPECT_EQ(g0.first, p0);
+    EXPECT_EQ(g0.second, RenderableList({&rends[0], &rends[2], &rends[4], &rends[6], &rends[8]}));
+    EXPECT_EQ(g1.first, p1);
+    EXPECT_EQ(g1.second, RenderableList({&rends[1], &rends[3], &rends[5], &rends[7], &rends[9]}));
+}
+
+TEST_F(RenderQueueTests, IncrementalUpdate)
+{
+    SceneManager* sm = mRoot->createSceneManager();
+    Camera* cam = sm->createCamera("cam");
+
+    auto tech = MaterialManager::getSingleton().create("incremental", RGN_DEFAULT)->createTechnique();
+    Pass* p0 = tech->createPass();
+    Pass* p1 = tech->createPass();
+
+    DepthRenderable r1(3), r2(1), r3(2), r4(0);
+
+    QueuedRenderableCollection grouped;
+    grouped.addOrganisationMode(QueuedRenderableCollection::OM_PASS_GROUP);
+    auto frame = [&](const std::vector<std::pair<Pass*, Renderable*> >& items) {
+        grouped._beginIncrementalUpdate();
+        for (const auto& i : items)
+            grouped.addRenderable(i.first, i.second);
+        grouped.sort(cam);
+
+        RecordingVisitor visitor;
+        grouped.acceptVisitor(&visitor, QueuedRenderableCollection::OM_PASS_GROUP);
+        return visitor.groups;
+    };
+
+    auto groups = frame({{p0, &r1}, {p1, &r1}, {p0, &r2}, {p0, &r3}});
+    ASSERT_EQ(groups.size(), 2u);
+    EXPECT_EQ(groups[0].second, RenderableList({&r2, &r3, &r1}));
+    EXPECT_EQ(groups[1].second, RenderableList({&r1}));
+
+    // r2 left, r4 entered and r3 changed its pass
+    groups = frame({{p0, &r1}, {p1, &r1}, {p1, &r3}, {p0, &r4}});
+    ASSERT_EQ(groups.size(), 2u);
+    EXPECT_EQ(groups[0].second, RenderableList({&r4, &r1}));
+    EXPECT_EQ(groups[1].second, RenderableList({&r3, &r1}));
+
+    // same set in a different order, the depth of staying entries is not refreshed
+    r4.depth = 10;
+    EXPECT_EQ(frame({{p0, &r4}, {p1, &r3}, {p0, &r1}, {p1, &r1}}), groups);
+
+    // duplicates are kept
+    groups = frame({{p0, &r1}, {p0, &r1}});
+    ASSERT_EQ(groups.size(), 1u);
+    EXPECT_EQ(groups[0].second, RenderableList({&r1, &r1}));
+    EXPECT_EQ(frame({{p0, &r1}, {p0, &r1}}), groups);
+    groups = frame({{p0, &r1}});
+    ASSERT_EQ(groups.size(), 1u);
+    EXPECT_EQ(groups[0].second, RenderableList({&r1}));
+
+    // the same through a persistent queue
+    RenderQueue* queue = sm->getRenderQueue();
+    queue->setPersistent(true);
+    queue->clear();
+    RenderQueueGroup* group = queue->getQueueGroup(RENDER_QUEUE_MAIN);
+    group->addRenderable(&r1, tech, 0);
+    group->addRenderable(&r2, tech, 0);
+    queue->clear();
+    group->addRenderable(&r2, tech, 0);
+    group->getPriorityGroups().at(0)->sort(cam);
+
+    RecordingVisitor visitor;
+    group->getPriorityGroups().at(0)->getSolidsBasic().acceptVisitor(&visitor,
+                                                                      QueuedRenderableCollection::OM_PASS_GROUP);
+    ASSERT_EQ(visitor.groups.size(), 2u);
+    EXPECT_EQ(visitor.groups[0].second, RenderableList({&r2}));
+    EXPECT_EQ(visitor.groups[1].second, RenderableList({&r2}));
+}
+
+// run with --gtest_also_run_disabled_tests
+TEST_F(RenderQueueTests, DISABLED_SortThroughput)
+{
+    auto mat = MaterialManager::getSingleton().create("sortThroughput", RGN_DEFAULT);
+    std::vector<Pass*> passes;
+    for (int i = 0; i < 32; ++i)
+        passes.push_back(mat->createTechnique()->createPass());
+
+    SceneManager* sm = mRoot->createSceneManager();
+    Camera* cam = sm->createCamera("cam");
+
+    minstd_rand rng;
+    std::uniform_real_distribution<float> dist(0, 1000);
+    std::deque<DepthRenderable> rends;
+    for (int i = 0; i < 20000; ++i)
+        rends.emplace_back(dist(rng));
+
+    QueuedRenderableCollection grouped;
+    grouped.addOrganisationMode(QueuedRenderableCollection::OM_PASS_GROUP);
+
+    // churn: every n-th renderable leaves the queue, a different set each frame
+    auto run = [&](const char* name, bool incremental, size_t churn) {
+        const int frames = 100;
+        Timer timer;
+        for (int f = 0; f < frames; ++f)
+        {
+            if (incremental)
+                grouped._beginIncrementalUpdate();
+            else
+                grouped.clear();
+            for (size_t i = 0; i < rends.size(); ++i)
+            {
+                if (churn && (i + f) % churn == 0)
+                    continue;
+                grouped.addRenderable(passes[i % passes.size()], &rends[i]);
+            }
+            grouped.sort(cam);
+        }
+        auto us = timer.getMicroseconds();
+        std::cout << "[ BENCHMARK] " << name << " add+sort " << rends.size() << " renderables: " << us / frames
+                  << " us/frame" << std::endl;
+    };
+
+    run("rebuild", false, 0);
+    run("incremental static", true, 0);
+    run("incremental 1% churn", true, 100);
+}
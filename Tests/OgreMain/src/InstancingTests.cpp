@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include "Ogre.h"
 #include "OgreInstancedEntity.h"
 #include "OgreInstanceBatchShader.h"
+#include "OgreInstanceBatchHW_VTF.h"
 #include "RootWithoutRenderSystemFixture.h"
 
 using namespace Ogre;
@@ -55,3 +56,81 @@ TEST_F(Instancing, Bounds) {
 
 
 
+
+namespace
+{
+struct BakedBatch : public InstanceBatchHW_VTF
+{
+    BakedBatch(MeshPtr& mesh, const MaterialPtr& material)
+        : InstanceBatchHW_VTF(NULL, mesh, material, 1, NULL, "baked")
+    {
+    }
+    using BaseInstanceBatchVTF::planBakedAnimation;
+    using BaseInstanceBatchVTF::getBakedPoseIndex;
+    using BaseInstanceBatchVTF::mBakedClips;
+    using BaseInstanceBatchVTF::mNumBakedPoses;
+};
+}
+
+TEST_F(Instancing, BakedAnimationLayout)
+{
+    SceneManager* sceneMgr = mRoot->createSceneManager();
+    Entity* entity = sceneMgr->createEntity("robot.mesh");
+
+    MeshPtr mesh = entity->getMesh();
+    BakedBatch batch(mesh, entity->getSubEntity(0)->getMaterial());
+    batch.setBakedAnimation(true, 10);
+    batch.planBakedAnimation();
+
+    // binding pose first, then the clips back to back
+    const SkeletonPtr& skeleton = mesh->getSkeleton();
+    ASSERT_EQ(batch.mBakedClips.size(), size_t(skeleton->getNumAnimations()));
+    size_t nextPose = 1;
+    for (const auto& clip : batch.mBakedClips)
+    {
+        Real length = skeleton->getAnimation(clip.first)->getLength();
+        EXPECT_EQ(clip.second.firstPose, nextPose) << clip.first;
+        EXPECT_EQ(clip.second.numPoses, size_t(Math::Floor(length * 10)) + 1) << clip.first;
+        nextPose += clip.second.numPoses;
+    }
+    EXPECT_EQ(batch.mNumBakedPoses, nextPose);
+}
+
+TEST_F(Instancing, BakedPoseIndex)
+{
+    SceneManager* sceneMgr = mRoot->createSceneManager();
+    Entity* entity = sceneMgr->createEntity("robot.mesh");
+
+    MeshPtr mesh = entity->getMesh();
+    BakedBatch batch(mesh, entity->getSubEntity(0)->getMaterial());
+    batch.setBakedAnimation(true, 10);
+    batch.planBakedAnimation();
+
+    // nothing playing, binding pose
+    EXPECT_EQ(batch.getBakedPoseIndex(NULL), size_t(0));
+    AnimationStateSet* states = entity->getAllAnimationStates();
+    EXPECT_EQ(batch.getBakedPoseIndex(states), size_t(0));
+
+    const auto& walk = batch.mBakedClips.at("Walk");
+    AnimationState* walkState = entity->getAnimationState("Walk");
+    walkState->setEnabled(true);
+    walkState->setLoop(false);
+
+    // snapped to the nearest sampled frame
+    walkState->setTimePosition(0.42);
+    EXPECT_EQ(batch.getBakedPoseIndex(states), walk.firstPose + 4);
+    walkState->setTimePosition(0.46);
+    EXPECT_EQ(batch.getBakedPoseIndex(states), walk.firstPose + 5);
+    walkState->setTimePosition(walkState->getLength());
+    EXPECT_EQ(batch.getBakedPoseIndex(states), walk.firstPose + walk.numPoses - 1);
+
+    // the enabled state with the highest weight wins
+    const auto& idle = batch.mBakedClips.at("Idle");
+    AnimationState* idleState = entity->getAnimationState("Idle");
+    idleState->setEnabled(true);
+    idleState->setTimePosition(0);
+    idleState->setWeight(0.5);
+    EXPECT_EQ(batch.getBakedPoseIndex(states), walk.firstPose + walk.numPoses - 1);
+    idleState->setWeight(2);
+    EXPECT_EQ(batch.getBakedPoseIndex(states), idle.firstPose);
+}
@@ -26,7 +26,12 @@ THE SOFTWARE.
 -----------------------------------------------------------------------------
 */
 #include "PixelFormatTests.h"
+#include "OgreImage.h"
+#include "OgreRoot.h"
+#include "OgreTimer.h"
+#include "OgreWorkQueue.h"
 #include <cstdlib>
+#include <functional>
 #include <iomanip>
 
 
@@ -233,6 +238,92 @@ TEST_F(PixelFormatTests,BulkConversion)
     testCase(PF_X8B8G8R8, PF_A8B8G8R8);
     testCase(PF_X8B8G8R8, PF_B8G8R8A8);
     testCase(PF_X8B8G8R8, PF_R8G8B8A8);
+    testCase(PF_A8R8G8B8, PF_FLOAT32_RGBA);
+    testCase(PF_A8B8G8R8, PF_FLOAT32_RGBA);
+    testCase(PF_B8G8R8A8, PF_FLOAT32_RGBA);
+    testCase(PF_R8G8B8A8, PF_FLOAT32_RGBA);
 }
 //--------------------------------------------------------------------------
 
+TEST_F(PixelFormatTests,FloatToByteConversion)
+{
+    // random bytes would make NaNs, so feed the optimized converters values around [0, 1]
+    float src[256 * 4];
+    for (int i = 0; i < 256 * 4; i++)
+        src[i] = mRandomData[i] / 200.0f - 0.1f;
+
+    const PixelFormat formats[] = {PF_A8R8G8B8, PF_A8B8G8R8, PF_B8G8R8A8, PF_R8G8B8A8};
+    for (PixelFormat pf : formats)
+    {
+        PixelBox srcBox(256, 1, 1, PF_FLOAT32_RGBA, src);
+        PixelBox dst1(256, 1, 1, pf, mTemp), dst2(256, 1, 1, pf, mTemp2);
+        PixelUtil::bulkPixelConversion(srcBox, dst1);
+        naiveBulkPixelConversion(srcBox, dst2);
+        EXPECT_TRUE(memcmp(mTemp, mTemp2, 256 * 4) == 0) << PixelUtil::getFormatName(pf);
+    }
+}
+//--------------------------------------------------------------------------
+TEST_F(PixelFormatTests,EmptyBox)
+{
+    memset(mTemp, 0xab, mSize);
+    PixelBox src(0, 16, 1, PF_A8R8G8B8, mRandomData), dst(0, 16, 1, PF_R8G8B8, mTemp);
+    PixelUtil::bulkPixelConversion(src, dst);
+
+    PixelBox full(16, 16, 1, PF_A8R8G8B8, mRandomData), empty(16, 0, 1, PF_A8R8G8B8, mTemp);
+    Image::scale(full, empty, Image::FILTER_NEAREST);
+    Image::scale(full, empty, Image::FILTER_BILINEAR);
+    EXPECT_EQ(mTemp[0], 0xab);
+}
+//--------------------------------------------------------------------------
+// run with --gtest_also_run_disabled_tests
+TEST_F(PixelFormatTests,DISABLED_ResampleConvertThroughput)
+{
+    Root root("");
+    const uint32 width = 3840, height = 2160;
+    const int runs = 5;
+
+    const std::pair<PixelFormat, PixelFormat> conversions[] = {
+        {PF_A8R8G8B8, PF_R8G8B8},         {PF_A8B8G8R8, PF_A8R8G8B8},     {PF_BYTE_RGBA, PF_FLOAT32_RGBA},
+        {PF_FLOAT32_RGBA, PF_BYTE_RGBA},  {PF_FLOAT16_RGBA, PF_FLOAT32_RGBA}, {PF_R5G6B5, PF_A8R8G8B8},
+        {PF_L8, PF_A8R8G8B8},             {PF_A8R8G8B8, PF_L8}};
+    const std::pair<Image::Filter, const char*> filters[] = {
+        {Image::FILTER_NEAREST, "nearest"}, {Image::FILTER_LINEAR, "linear"}, {Image::FILTER_BILINEAR, "bilinear"}};
+
+    auto mpixelsPerSecond = [runs](size_t pixels, const std::function<void()>& func) {
+        Timer timer;
+        for (int i = 0; i < runs; i++)
+            func();
+        return pixels * runs / double(std::max<unsigned long>(timer.getMicroseconds(), 1));
+    };
+
+    auto run = [&](const char* name) {
+        for (const auto& c : conversions)
+        {
+            Image src(c.first, width, height), dst(c.second, width, height);
+            memset(src.getData(), 0x3c, src.getSize());
+            double rate = mpixelsPerSecond(width * height, [&]() {
+                PixelUtil::bulkPixelConversion(src.getPixelBox(), dst.getPixelBox());
+            });
+            std::cout << "[ BENCHMARK] " << name << ": convert " << PixelUtil::getFormatName(c.first) << " to "
+                      << PixelUtil::getFormatName(c.second) << " " << rate << " MPixel/s" << std::endl;
+        }
+
+        for (PixelFormat pf : {PF_A8R8G8B8, PF_FLOAT32_RGBA})
+        {
+            Image src(pf, width, height), dst(pf, width / 2, height / 2);
+            memset(src.getData(), 0x3c, src.getSize());
+            for (const auto& f : filters)
+            {
+                double rate = mpixelsPerSecond(dst.getWidth() * dst.getHeight(), [&]() {
+                    Image::scale(src.getPixelBox(), dst.getPixelBox(), f.first);
+                });
+                std::cout << "[ BENCHMARK] " << name << ": " << f.second << " resample "
+                          << PixelUtil::getFormatName(pf) << " " << rate << " MPixel/s" << std::endl;
+            }
+        }
+    };
+
+    run("calling thread");
+    root.getWorkQueue()->startup();
+    run("work queue");
+}
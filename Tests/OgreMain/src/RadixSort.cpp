@@ -71,6 +71,15 @@ public:
     }
 };
 //--------------------------------------------------------------------------
+class Uint64PairSortFunctor
+{
+public:
+    uint64 operator()(const std::pair<uint64, int>& p) const
+    {
+        return p.first;
+    }
+};
+//--------------------------------------------------------------------------
 TEST_F(RadixSortTests,FloatVector)
 {
     std::vector<float> container;
@@ -203,5 +212,66 @@ TEST_F(RadixSortTests,IntVector)
     }
 }
 //--------------------------------------------------------------------------
+TEST_F(RadixSortTests,Uint64Vector)
+{
+    std::vector<std::pair<uint64, int> > container;
+    Uint64PairSortFunctor func;
+    RadixSort<std::vector<std::pair<uint64, int> >, std::pair<uint64, int>, uint64> sorter;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        uint64 hi = (uint64)Math::RangeRandom(0, float(UINT_MAX));
+        uint64 lo = (uint64)Math::RangeRandom(0, 16);
+        container.push_back(std::make_pair((hi << 32) | lo, i));
+    }
 
+    sorter.sort(container, func);
 
+    // sorted, equal keys in their original order
+    for (size_t i = 1; i < container.size(); ++i)
+    {
+        ASSERT_LE(container[i - 1].first, container[i].first);
+        if (container[i - 1].first == container[i].first)
+        {
+            EXPECT_LT(container[i - 1].second, container[i].second);
+        }
+    }
+}
+//--------------------------------------------------------------------------
+TEST_F(RadixSortTests,Uint64SharedBytes)
+{
+    std::vector<std::pair<uint64, int> > container;
+    Uint64PairSortFunctor func;
+    RadixSort<std::vector<std::pair<uint64, int> >, std::pair<uint64, int>, uint64> sorter;
+
+    // the top 3 bytes and byte 2 are the same for all keys, so their passes are skipped
+    for (int i = 0; i < 1000; ++i)
+    {
+        uint64 mid = (uint64)Math::RangeRandom(0, 65535);
+        uint64 lo = (uint64)Math::RangeRandom(0, 65535);
+        container.push_back(std::make_pair((uint64(0xABCDEF) << 40) | (mid << 24) | (uint64(0x5A) << 16) | lo, i));
+    }
+
+    sorter.sort(container, func);
+
+    for (size_t i = 1; i < container.size(); ++i)
+    {
+        ASSERT_LE(container[i - 1].first, container[i].first);
+        if (container[i - 1].first == container[i].first)
+        {
+            EXPECT_LT(container[i - 1].second, container[i].second);
+        }
+    }
+
+    // a single varying byte, only it and the final byte are sorted
+    for (auto& v : container)
+        v.first = (uint64(0xABCDEF) << 40) | (uint64(v.second % 7) << 8);
+    std::vector<std::pair<uint64, int> > expected = container;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const std::pair<uint64, int>& a, const std::pair<uint64, int>& b)
+                     { return a.first < b.first; });
+
+    sorter.sort(container, func);
+    EXPECT_EQ(container, expected);
+}
+//--------------------------------------------------------------------------
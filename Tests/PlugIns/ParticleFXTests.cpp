@@ -0,0 +1,183 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "RootWithoutRenderSystemFixture.h"
+#include "OgreParticleFXPlugin.h"
+#include "OgreParticleSystemManager.h"
+#include "OgreParticleSystem.h"
+#include "OgreParticleAffector.h"
+#include "OgreParticleEmitter.h"
+#include "OgreParticle.h"
+#include "OgreSceneManager.h"
+#include "OgreControllerManager.h"
+#include "OgreImage.h"
+#include "OgreTimer.h"
+#include "OgreSTBICodec.h"
+
+#include <random>
+
+using namespace Ogre;
+
+struct ParticleFXTests : public RootWithoutRenderSystemFixture
+{
+    ParticleFXPlugin mPlugin;
+    std::unique_ptr<ControllerManager> mControllerMgr;
+    SceneManager* mSceneMgr;
+
+    void SetUp() override
+    {
+        RootWithoutRenderSystemFixture::SetUp();
+        STBIImageCodec::startup();
+        mControllerMgr.reset(new ControllerManager());
+        ParticleSystemManager::getSingleton()._initialise();
+        mRoot->installPlugin(&mPlugin);
+        mSceneMgr = mRoot->createSceneManager();
+    }
+    void TearDown() override
+    {
+        // the affectors must be gone before their factories
+        mRoot->destroySceneManager(mSceneMgr);
+        mControllerMgr.reset();
+        mRoot->uninstallPlugin(&mPlugin);
+        STBIImageCodec::shutdown();
+        RootWithoutRenderSystemFixture::TearDown();
+    }
+
+    ParticleSystem* createParticleSystem(size_t quota)
+    {
+        ParticleSystem* ps = mSceneMgr->createParticleSystem("ps", quota);
+        mSceneMgr->getRootSceneNode()->attachObject(ps);
+        ps->_update(0); // allocates the particle pool
+        return ps;
+    }
+};
+
+TEST_F(ParticleFXTests, ColourImageAffector)
+{
+    ParticleSystem* ps = createParticleSystem(1);
+    ParticleAffector* affector = ps->addAffector("ColourImage");
+    affector->setParameter("image", "smokecolors.png");
+
+    Image image;
+    image.load("smokecolors.png", ps->getResourceGroupName());
+    uint32 last = image.getWidth() - 1;
+
+    Particle* p = ps->createParticle();
+    p->mTotalTimeToLive = p->mTimeToLive = 2;
+    affector->_initParticle(p);
+    EXPECT_EQ(p->mColour, image.getColourAt(0, 0, 0).getAsBYTE());
+
+    p->mTimeToLive = 0;
+    affector->_affectParticles(ps, 0);
+    EXPECT_EQ(p->mColour, image.getColourAt(last, 0, 0).getAsBYTE());
+
+    // halfway between two texels
+    p->mTimeToLive = 2 - 2 * (0.5f / last);
+    affector->_affectParticles(ps, 0);
+    RGBA from = image.getColourAt(0, 0, 0).getAsBYTE(), to = image.getColourAt(1, 0, 0).getAsBYTE();
+    for (int c = 0; c < 4; c++)
+    {
+        int expected = (((const uint8*)&from)[c] + ((const uint8*)&to)[c]) / 2;
+        EXPECT_NEAR(((const uint8*)&p->mColour)[c], expected, 1);
+    }
+}
+
+TEST_F(ParticleFXTests, ColourImageAffectorMissingImage)
+{
+    ParticleSystem* ps = createParticleSystem(1);
+    ParticleAffector* affector = ps->addAffector("ColourImage");
+    affector->setParameter("image", "smokecolors.png");
+
+    Particle* p = ps->createParticle();
+    p->mTotalTimeToLive = p->mTimeToLive = 2;
+    affector->_initParticle(p);
+
+    // the colours of the previous image must not be used anymore
+    affector->setParameter("image", "doesnotexist.png");
+    p->mColour = 0;
+    EXPECT_THROW(affector->_initParticle(p), FileNotFoundException);
+    EXPECT_THROW(affector->_affectParticles(ps, 0), FileNotFoundException);
+    EXPECT_EQ(p->mColour, 0u);
+}
+
+// run with --gtest_also_run_disabled_tests
+TEST_F(ParticleFXTests, DISABLED_ColourImageAffectorThroughput)
+{
+    const int count = 100000;
+    ParticleSystem* ps = createParticleSystem(count);
+    ParticleAffector* affector = ps->addAffector("ColourImage");
+    affector->setParameter("image", "smokecolors.png");
+
+    std::mt19937 rng;
+    std::uniform_real_distribution<float> ttl(0, 10);
+    for (int i = 0; i < count; i++)
+    {
+        Particle* p = ps->createParticle();
+        p->mTotalTimeToLive = 10;
+        p->mTimeToLive = ttl(rng);
+    }
+    affector->_affectParticles(ps, 0); // loads the image
+
+    const int runs = 100;
+    Timer timer;
+    for (int i = 0; i < runs; i++)
+        affector->_affectParticles(ps, 0);
+    auto us = std::max<unsigned long>(timer.getMicroseconds(), 1);
+    std::cout << "[ BENCHMARK] " << us * 1000.0 / (count * runs) << " ns/particle" << std::endl;
+}
+
+// run with --gtest_also_run_disabled_tests
+TEST_F(ParticleFXTests, DISABLED_ParticleSystemUpdateThroughput)
+{
+    // a smoke like system, with particles dying and being emitted every frame
+    const int count = 100000;
+    ParticleSystem* ps = createParticleSystem(count);
+    ParticleEmitter* emitter = ps->addEmitter("Point");
+    emitter->setEmissionRate(count / 2);
+    emitter->setTimeToLive(1, 3);
+    emitter->setAngle(Degree(30));
+    emitter->setParticleVelocity(50, 100);
+    ps->addAffector("LinearForce")->setParameter("force_vector", "0 -100 0");
+    ps->addAffector("ColourImage")->setParameter("image", "smokecolors.png");
+
+    // fill the system up to its steady state
+    for (int i = 0; i < 240; i++)
+        ps->_update(1 / 60.f);
+
+    const int frames = 120;
+    size_t particles = 0;
+    Timer timer;
+    for (int i = 0; i < frames; i++)
+    {
+        ps->_update(1 / 60.f);
+        particles += ps->getNumParticles();
+    }
+    auto us = std::max<unsigned long>(timer.getMicroseconds(), 1);
+    std::cout << "[ BENCHMARK] " << particles / frames << " particles: " << us * 1000.0 / particles
+              << " ns/particle" << std::endl;
+}
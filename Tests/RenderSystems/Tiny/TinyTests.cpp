@@ -0,0 +1,551 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "OgreRoot.h"
+#include "OgreTinyPlugin.h"
+#include "OgreRenderWindow.h"
+#include "OgreSceneManager.h"
+#include "OgreEntity.h"
+#include "OgreLight.h"
+#include "OgreCamera.h"
+#include "OgreViewport.h"
+#include "OgreMeshManager.h"
+#include "OgreMaterialManager.h"
+#include "OgreTechnique.h"
+#include "OgreTextureManager.h"
+#include "OgreTimer.h"
+#include "OgreManualObject.h"
+#include "OgreHardwarePixelBuffer.h"
+#include "OgreStringConverter.h"
+
+#include <gtest/gtest.h>
+#include <numeric>
+
+using namespace Ogre;
+
+/// renders a textured floor seen at a grazing angle to an offscreen Tiny window
+struct TinyRenderSystemTests : public ::testing::Test
+{
+    TinyPlugin mPlugin;
+    std::unique_ptr<Root> mRoot;
+    SceneManager* mSceneMgr;
+    Entity* mFloor;
+
+    void SetUp() override
+    {
+        mRoot.reset(new Root(""));
+        mRoot->installPlugin(&mPlugin);
+        mRoot->setRenderSystem(mRoot->getRenderSystemByName("Tiny Rendering Subsystem"));
+        mRoot->initialise(false);
+        RenderWindow* window = mRoot->createRenderWindow("tiny", 256, 256, false);
+
+        mSceneMgr = mRoot->createSceneManager();
+        Camera* cam = mSceneMgr->createCamera("cam");
+        cam->setNearClipDistance(1);
+        SceneNode* camNode = mSceneMgr->getRootSceneNode()->createChildSceneNode(Vector3(0, 20, 520));
+        camNode->lookAt(Vector3(0, 0, -500), Node::TS_WORLD);
+        camNode->attachObject(cam);
+        window->addViewport(cam);
+
+        // 8x8 checker, minified strongly towards the horizon
+        Image checker(PF_BYTE_RGBA, 256, 256);
+        for (uint32 y = 0; y < 256; y++)
+            for (uint32 x = 0; x < 256; x++)
+                checker.setColourAt(((x / 32 + y / 32) % 2) ? ColourValue::White : ColourValue::Black, x, y, 0);
+        TextureManager::getSingleton().loadImage("checker", RGN_DEFAULT, checker);
+
+        MeshManager::getSingleton().createPlane("floor", RGN_DEFAULT, Plane(Vector3::UNIT_Y, 0), 1000, 1000, 1,
+                                                1, true, 1, 20, 20, Vector3::UNIT_Z);
+        mFloor = mSceneMgr->createEntity("floor");
+        mSceneMgr->getRootSceneNode()->attachObject(mFloor);
+    }
+
+    void TearDown() override { mRoot.reset(); }
+
+    Pass* createPass(const String& name)
+    {
+        Pass* pass = MaterialManager::getSingleton().create(name, RGN_DEFAULT)->getTechnique(0)->getPass(0);
+        pass->setLightingEnabled(false);
+        return pass;
+    }
+
+    static TexturePtr createColourTexture(const String& name, const ColourValue& colour)
+    {
+        Image img(PF_BYTE_RGBA, 1, 1);
+        img.setTo(colour);
+        return TextureManager::getSingleton().loadImage(name, RGN_DEFAULT, img);
+    }
+
+    /// a lighting free pass, textured with a new solid colour texture of the same name
+    Pass* createColourPass(const String& name, const ColourValue& colour)
+    {
+        createColourTexture(name, colour);
+        Pass* pass = createPass(name);
+        pass->createTextureUnitState(name);
+        return pass;
+    }
+
+    /// look from the origin down -Z, with the floor removed
+    void lookDownZ()
+    {
+        mFloor->detachFromParent();
+        SceneNode* camNode = mSceneMgr->getCamera("cam")->getParentSceneNode();
+        camNode->setPosition(Vector3::ZERO);
+        camNode->setOrientation(Quaternion::IDENTITY);
+    }
+
+    /// a square centred on the view axis at depth z, facing the camera unless backFacing
+    ManualObject* createQuad(const String& material, float z, float halfSize, bool backFacing = false,
+                             RenderOperation::OperationType type = RenderOperation::OT_TRIANGLE_LIST)
+    {
+        ManualObject* quad = mSceneMgr->createManualObject();
+        quad->begin(material, type);
+        quad->position(-halfSize, -halfSize, z);
+        quad->textureCoord(0, 1);
+        quad->position(halfSize, -halfSize, z);
+        quad->textureCoord(1, 1);
+        quad->position(-halfSize, halfSize, z);
+        quad->textureCoord(0, 0);
+        quad->position(halfSize, halfSize, z);
+        quad->textureCoord(1, 0);
+        if (type == RenderOperation::OT_TRIANGLE_LIST)
+        {
+            if (backFacing)
+            {
+                quad->triangle(0, 3, 1);
+                quad->triangle(0, 2, 3);
+            }
+            else
+            {
+                quad->triangle(0, 1, 3);
+                quad->triangle(0, 3, 2);
+            }
+        }
+        quad->end();
+        // on its own node, as visibility is tested per node
+        mSceneMgr->getRootSceneNode()->createChildSceneNode()->attachObject(quad);
+        return quad;
+    }
+
+    /// draws are rasterised on a worker thread, the read back waits for them
+    Image readFrame()
+    {
+        RenderTarget* window = mRoot->getRenderTarget("tiny");
+        Image frame(PF_BYTE_RGBA, window->getWidth(), window->getHeight());
+        window->copyContentsToMemory(Box(0, 0, window->getWidth(), window->getHeight()), frame.getPixelBox());
+        return frame;
+    }
+
+    Image renderFrame()
+    {
+        mRoot->renderOneFrame();
+        return readFrame();
+    }
+
+    void benchmark(const String& material)
+    {
+        mFloor->setMaterialName(material);
+        mRoot->renderOneFrame(); // warm up, builds the mipmaps
+
+        const int frames = 50;
+        Timer timer;
+        for (int i = 0; i < frames; i++)
+            mRoot->renderOneFrame();
+        readFrame();
+        auto us = std::max<unsigned long>(timer.getMicroseconds(), 1);
+        std::cout << "[ BENCHMARK] " << material << ": " << us / 1000.0 / frames << " ms/frame" << std::endl;
+    }
+};
+
+// run with --gtest_also_run_disabled_tests
+TEST_F(TinyRenderSystemTests, DISABLED_FilteredSamplingThroughput)
+{
+    createPass("nearest")->createTextureUnitState("checker")->setTextureFiltering(TFO_NONE);
+    createPass("bilinear")->createTextureUnitState("checker")->setTextureFiltering(TFO_BILINEAR);
+    createPass("trilinear")->createTextureUnitState("checker")->setTextureFiltering(TFO_TRILINEAR);
+
+    benchmark("nearest");
+    benchmark("bilinear");
+    benchmark("trilinear");
+}
+
+// run with --gtest_also_run_disabled_tests
+TEST_F(TinyRenderSystemTests, DISABLED_PipelineVariantsThroughput)
+{
+    mSceneMgr->getRootSceneNode()->attachObject(mSceneMgr->createLight());
+
+    createPass("untextured");
+    createPass("textured")->createTextureUnitState("checker");
+
+    Pass* lit = createPass("lit_textured");
+    lit->setLightingEnabled(true);
+    lit->createTextureUnitState("checker");
+
+    Pass* additive = createPass("additive_nodepthwrite");
+    additive->setSceneBlending(SBT_ADD);
+    additive->setDepthWriteEnabled(false);
+    additive->createTextureUnitState("checker");
+
+    Pass* overlay = createPass("nocull_nodepthcheck");
+    overlay->setCullingMode(CULL_NONE);
+    overlay->setDepthCheckEnabled(false);
+    overlay->createTextureUnitState("checker");
+
+    for (auto name : {"untextured", "textured", "lit_textured", "additive_nodepthwrite", "nocull_nodepthcheck"})
+        benchmark(name);
+}
+
+TEST_F(TinyRenderSystemTests, NearPlaneClipping)
+{
+    // with the camera above its centre, the floor reaches behind the near plane
+    createPass("white");
+    mFloor->setMaterialName("white");
+    SceneNode* camNode = mSceneMgr->getCamera("cam")->getParentSceneNode();
+    camNode->setPosition(0, 20, 0);
+    camNode->lookAt(Vector3(0, 0, -500), Node::TS_WORLD);
+
+    // the far edge of the floor is on the centre row, the floor covers everything below it
+    Image frame = renderFrame();
+    for (uint32 x = 0; x < 256; x++)
+    {
+        for (uint32 y = 0; y < 120; y++)
+            ASSERT_EQ(ColourValue::Black, frame.getColourAt(x, y, 0)) << x << ", " << y;
+        for (uint32 y = 136; y < 256; y++)
+            ASSERT_EQ(ColourValue::White, frame.getColourAt(x, y, 0)) << x << ", " << y;
+    }
+}
+
+TEST_F(TinyRenderSystemTests, SharedVerticesMatchUnshared)
+{
+    createPass("textured")->createTextureUnitState("checker");
+    mFloor->detachFromParent();
+
+    // a floor grid reaching behind the camera, either sharing the vertices of adjacent quads
+    // through the index buffer or repeating them
+    const int n = 16;
+    auto createGrid = [this](bool shared) {
+        ManualObject* grid = mSceneMgr->createManualObject();
+        grid->begin("textured");
+        auto vertex = [grid](int i, int j) {
+            grid->position(-600 + i * 1200.f / n, 0, -600 + j * 1200.f / n);
+            grid->textureCoord(i * 0.5f, j * 0.5f);
+        };
+        if (shared)
+        {
+            for (int j = 0; j <= n; j++)
+                for (int i = 0; i <= n; i++)
+                    vertex(i, j);
+        }
+        for (int j = 0; j < n; j++)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                if (shared)
+                {
+                    uint32 v = j * (n + 1) + i;
+                    grid->triangle(v, v + n + 1, v + 1);
+                    grid->triangle(v + 1, v + n + 1, v + n + 2);
+                    continue;
+                }
+                vertex(i, j);
+                vertex(i, j + 1);
+                vertex(i + 1, j);
+                vertex(i + 1, j);
+                vertex(i, j + 1);
+                vertex(i + 1, j + 1);
+            }
+        }
+        grid->end();
+        mSceneMgr->getRootSceneNode()->attachObject(grid);
+        return grid;
+    };
+
+    ManualObject* unshared = createGrid(false);
+    unshared->setVisible(false);
+    ManualObject* shared = createGrid(true);
+    Image a = renderFrame();
+
+    shared->setVisible(false);
+    unshared->setVisible(true);
+    Image b = renderFrame();
+
+    // only the white checker squares can be told apart from the background
+    size_t white = 0;
+    for (uint32 y = 0; y < 256; y++)
+        for (uint32 x = 0; x < 256; x++)
+            white += a.getColourAt(x, y, 0) == ColourValue::White;
+    EXPECT_GT(white, 1000u);
+    EXPECT_EQ(0, memcmp(a.getData(), b.getData(), a.getSize()));
+}
+
+TEST_F(TinyRenderSystemTests, MipmapSampling)
+{
+    // each mip level in its own colour, so the frame shows which levels were sampled
+    const ColourValue levelColours[] = {ColourValue::Red,        ColourValue::Green,        ColourValue::Blue,
+                                        ColourValue(1, 1, 0),    ColourValue(1, 0, 1),      ColourValue(0, 1, 1),
+                                        ColourValue::White};
+    Image levels;
+    levels.create(PF_BYTE_RGBA, 64, 64, 1, 1, 6);
+    for (uint32 mip = 0; mip <= levels.getNumMipmaps(); mip++)
+    {
+        PixelBox level = levels.getPixelBox(0, mip);
+        for (size_t i = 0; i < level.getConsecutiveSize(); i += 4)
+            PixelUtil::packColour(levelColours[mip], PF_BYTE_RGBA, level.data + i);
+    }
+    TextureManager::getSingleton().loadImage("levels", RGN_DEFAULT, levels);
+
+    createPass("nearest")->createTextureUnitState("levels")->setTextureFiltering(TFO_NONE);
+    createPass("bilinear")->createTextureUnitState("levels")->setTextureFiltering(TFO_BILINEAR);
+    createPass("trilinear")->createTextureUnitState("levels")->setTextureFiltering(TFO_TRILINEAR);
+
+    // floor pixels per sampled level, the last entry counts blends of two levels
+    auto countLevels = [&](const String& material) {
+        mFloor->setMaterialName(material);
+        Image frame = renderFrame();
+        std::vector<int> counts(8);
+        for (uint32 y = 0; y < 256; y++)
+        {
+            for (uint32 x = 0; x < 256; x++)
+            {
+                ColourValue c = frame.getColourAt(x, y, 0);
+                if (c != ColourValue::Black)
+                    counts[std::find(levelColours, levelColours + 7, c) - levelColours]++;
+            }
+        }
+        return counts;
+    };
+
+    // without mipmapping, only the top level is sampled
+    auto counts = countLevels("nearest");
+    EXPECT_GT(counts[0], 10000);
+    EXPECT_EQ(counts[0], std::accumulate(counts.begin(), counts.end(), 0));
+
+    // magnified close to the camera, the further away the smaller the level
+    counts = countLevels("bilinear");
+    EXPECT_GT(counts[0], 0);
+    EXPECT_GE(std::count_if(counts.begin(), counts.end() - 1, [](int c) { return c > 0; }), 4);
+    EXPECT_EQ(counts[7], 0);
+
+    Image frame = readFrame();
+    int lastLevel = 0;
+    for (uint32 y = 255; y > 0 && frame.getColourAt(128, y, 0) != ColourValue::Black; y--)
+    {
+        int level = std::find(levelColours, levelColours + 7, frame.getColourAt(128, y, 0)) - levelColours;
+        EXPECT_GE(level, lastLevel) << y;
+        lastLevel = level;
+    }
+
+    // trilinear blends the two nearest levels
+    counts = countLevels("trilinear");
+    EXPECT_GT(counts[0], 0);
+    EXPECT_GT(counts[7], 1000);
+}
+
+TEST_F(TinyRenderSystemTests, BlendVariant)
+{
+    lookDownZ();
+    createColourPass("red", ColourValue::Red);
+    createColourPass("green", ColourValue::Green)->setSceneBlending(SBT_ADD);
+    createQuad("red", -10, 2);
+    createQuad("green", -5, 0.5);
+
+    Image frame = renderFrame();
+    EXPECT_EQ(ColourValue(1, 1, 0), frame.getColourAt(128, 128, 0));
+    EXPECT_EQ(ColourValue::Red, frame.getColourAt(164, 128, 0));
+    EXPECT_EQ(ColourValue::Black, frame.getColourAt(250, 128, 0));
+}
+
+TEST_F(TinyRenderSystemTests, DepthVariants)
+{
+    lookDownZ();
+    Pass* near = createColourPass("near", ColourValue::Red);
+    Pass* far = createColourPass("far", ColourValue::Green);
+    // the far quad is drawn last
+    createQuad("near", -5, 0.5);
+    createQuad("far", -10, 2)->setRenderQueueGroup(RENDER_QUEUE_MAIN + 1);
+
+    EXPECT_EQ(ColourValue::Red, renderFrame().getColourAt(128, 128, 0));
+
+    far->setDepthCheckEnabled(false);
+    Image frame = renderFrame();
+    EXPECT_EQ(ColourValue::Green, frame.getColourAt(128, 128, 0));
+    EXPECT_EQ(ColourValue::Green, frame.getColourAt(164, 128, 0));
+
+    far->setDepthCheckEnabled(true);
+    near->setDepthWriteEnabled(false);
+    EXPECT_EQ(ColourValue::Green, renderFrame().getColourAt(128, 128, 0));
+}
+
+TEST_F(TinyRenderSystemTests, CullVariants)
+{
+    lookDownZ();
+    createPass("white");
+
+    // a point in each triangle of either diagonal split
+    auto countDrawn = [this]() {
+        Image frame = renderFrame();
+        int drawn = 0;
+        for (auto p : {std::make_pair(98, 98), {158, 98}, {98, 158}, {158, 158}})
+            drawn += frame.getColourAt(p.first, p.second, 0) == ColourValue::White;
+        return drawn;
+    };
+
+    ManualObject* quad = createQuad("white", -10, 2);
+    EXPECT_EQ(4, countDrawn());
+
+    // back faces of triangle lists are culled
+    mSceneMgr->destroyManualObject(quad);
+    quad = createQuad("white", -10, 2, true);
+    EXPECT_EQ(0, countDrawn());
+
+    // while strips, which alternate their winding, are not
+    mSceneMgr->destroyManualObject(quad);
+    createQuad("white", -10, 2, false, RenderOperation::OT_TRIANGLE_STRIP);
+    EXPECT_EQ(4, countDrawn());
+}
+
+TEST_F(TinyRenderSystemTests, CommandOrder)
+{
+    lookDownZ();
+
+    // without depth check, the last of the overlapping draws wins
+    const ColourValue colours[] = {ColourValue::Red, ColourValue::Green, ColourValue::Blue};
+    ManualObject* quads[3];
+    for (int i = 0; i < 3; i++)
+    {
+        String name = StringConverter::toString(i);
+        createColourPass(name, colours[i])->setDepthCheckEnabled(false);
+        quads[i] = createQuad(name, -10, 2);
+        quads[i]->setRenderQueueGroup(RENDER_QUEUE_MAIN + i);
+    }
+    EXPECT_EQ(ColourValue::Blue, renderFrame().getColourAt(128, 128, 0));
+
+    for (int i = 0; i < 3; i++)
+        quads[i]->setRenderQueueGroup(RENDER_QUEUE_MAIN + 2 - i);
+    EXPECT_EQ(ColourValue::Red, renderFrame().getColourAt(128, 128, 0));
+
+    // more draws than may be recorded ahead of the worker, before the last one
+    ManualObject* many = mSceneMgr->createManualObject();
+    for (int i = 0; i < 1100; i++)
+    {
+        many->begin("1");
+        many->position(-0.5, -0.5, -10);
+        many->position(0.5, -0.5, -10);
+        many->position(0, 0.5, -10);
+        many->end();
+    }
+    many->setRenderQueueGroup(RENDER_QUEUE_MAIN);
+    mSceneMgr->getRootSceneNode()->attachObject(many);
+    Image frame = renderFrame();
+    EXPECT_EQ(ColourValue::Red, frame.getColourAt(128, 128, 0));
+    EXPECT_EQ(ColourValue::Red, frame.getColourAt(164, 128, 0));
+}
+
+TEST_F(TinyRenderSystemTests, FlushBeforeTextureLock)
+{
+    lookDownZ();
+    createColourPass("tex", ColourValue::Red);
+    createQuad("tex", -10, 2);
+    mRoot->renderOneFrame();
+
+    // the draw sampling it might still be recorded
+    auto buffer = TextureManager::getSingleton().getByName("tex", RGN_DEFAULT)->getBuffer();
+    const PixelBox& box = buffer->lock(Box(0, 0, 1, 1), HardwareBuffer::HBL_DISCARD);
+    PixelUtil::packColour(ColourValue::Green, box.format, box.data);
+    buffer->unlock();
+
+    EXPECT_EQ(ColourValue::Red, readFrame().getColourAt(128, 128, 0));
+    EXPECT_EQ(ColourValue::Green, renderFrame().getColourAt(128, 128, 0));
+}
+
+TEST_F(TinyRenderSystemTests, FlushBeforeTextureDestroy)
+{
+    lookDownZ();
+    createColourTexture("green", ColourValue::Green);
+    Pass* pass = createColourPass("temp", ColourValue::Red);
+    createQuad("temp", -10, 2);
+    mRoot->renderOneFrame();
+
+    // the draw sampling it might still be recorded
+    pass->getTextureUnitState(0)->setTextureName("green");
+    TextureManager::getSingleton().remove("temp", RGN_DEFAULT);
+    EXPECT_FALSE(TextureManager::getSingleton().resourceExists("temp", RGN_DEFAULT));
+
+    EXPECT_EQ(ColourValue::Red, readFrame().getColourAt(128, 128, 0));
+    EXPECT_EQ(ColourValue::Green, renderFrame().getColourAt(128, 128, 0));
+}
+
+TEST_F(TinyRenderSystemTests, FlushBeforeResize)
+{
+    lookDownZ();
+    createPass("white");
+    createQuad("white", -10, 2);
+    mRoot->renderOneFrame();
+
+    // reallocates the colour buffer, the recorded draws might still write to
+    static_cast<RenderWindow*>(mRoot->getRenderTarget("tiny"))->resize(128, 128);
+
+    Image frame = renderFrame();
+    ASSERT_EQ(128u, frame.getWidth());
+    EXPECT_EQ(ColourValue::White, frame.getColourAt(64, 64, 0));
+    EXPECT_EQ(ColourValue::Black, frame.getColourAt(2, 64, 0));
+}
+
+TEST_F(TinyRenderSystemTests, RenderStats)
+{
+    lookDownZ();
+    createColourPass("red", ColourValue::Red)->setSceneBlending(SBT_ADD);
+    createColourPass("green", ColourValue::Green)->setSceneBlending(SBT_MODULATE);
+    createQuad("red", -10, 2);
+    createQuad("green", -5, 0.5);
+    // behind the camera
+    createQuad("red", 10, 2);
+
+    mSceneMgr->setRenderStatsEnabled(true);
+    for (int frame = 0; frame < 2; frame++)
+    {
+        mRoot->renderOneFrame();
+
+        // counted anew each frame
+        const auto& stats = mSceneMgr->getRenderStats();
+        EXPECT_EQ(mRoot->getNextFrameNumber() - 1, stats.frameNumber);
+        EXPECT_EQ(2u, stats.passChanges);
+        EXPECT_EQ(0u, stats.programChanges); // fixed function only
+        EXPECT_EQ(2u, stats.textureChanges);
+        EXPECT_EQ(1u, stats.samplerChanges); // both use the default sampler
+        EXPECT_EQ(2u, stats.blendChanges);
+        EXPECT_EQ(2u, stats.batches);
+        EXPECT_EQ(4u, stats.faces);
+
+        const auto& group = stats.queueGroups[RENDER_QUEUE_MAIN];
+        EXPECT_EQ(2u, group.objectsVisible);
+        EXPECT_EQ(1u, group.objectsCulled);
+        EXPECT_EQ(2u, group.renderablesQueued);
+        EXPECT_EQ(2u, group.renderablesRendered);
+    }
+}
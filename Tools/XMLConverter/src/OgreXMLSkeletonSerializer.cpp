@@ -573,6 +573,22 @@ namespace Ogre {
         {
             writeKeyFrame(keysNode, track->getNodeKeyFrame(i));
         }
+
+        // xml has no compressed form, write the decoded keys
+        if (const CompressedTransformKeys* keys = track->_getCompressedKeys())
+        {
+            for (size_t i = 0; i < keys->getNumKeys(); ++i)
+            {
+                TransformKeyFrame kf(0, keys->times[i]);
+                Vector3 translate, scale;
+                Quaternion rotate;
+                keys->getKey(i, translate, rotate, scale);
+                kf.setTranslate(translate);
+                kf.setRotation(rotate);
+                kf.setScale(scale);
+                writeKeyFrame(keysNode, &kf);
+            }
+        }
     }
     //---------------------------------------------------------------------
     void XMLSkeletonSerializer::writeKeyFrame(pugi::xml_node& keysNode,